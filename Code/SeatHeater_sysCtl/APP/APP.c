@@ -11,6 +11,14 @@
  **********************************************************************************************************/
 
 #include"APP.h"
+#include"NVM.h"
+#include"Supervisor.h"
+#include"Trace.h"
+#include"Plant.h"
+#include"Crash.h"
+#include"Periodic.h"
+#include"Schedulability.h"
+#include"Status.h"
 
 /****************************************************************************
  *                              Global variables
@@ -22,27 +30,15 @@ SemaphoreHandle_t ADC_mutex;
 /* This mutex for the mutual exclusion between Driver and passenger of UART in any monitoring task */
 SemaphoreHandle_t UART_mutex;
 
-/* The following two queues refer to the temperature set by both driver and passenger by the push buttons */
-QueueHandle_t     Q_desiredTempDriver;
-QueueHandle_t     Q_desiredTempPassenger;
-
-/* The following two queues refer to the temperature measured by temperature sensor in both seats */
-QueueHandle_t     Q_currentTempDriver;
-QueueHandle_t     Q_currentTempPassenger;
-
-/* Each of the following queue sets combine both the current and desired temperature (queue set for driver and other for passenger) */
-QueueSetHandle_t QS_DriverTemp;
-QueueSetHandle_t QS_PassengerTemp;
-
-/* Heater handler pass heating level of driver seat through this queue to be monitored */
-QueueHandle_t     Q_heatingLevelDriver;
+/* Every input of the DataProcessing task of each seat (current temperature, desired level, fault and control updates)
+ * is a tagged inputMessage_Type in one of the following two queues
+ */
+QueueHandle_t     Q_inputDriver;
+QueueHandle_t     Q_inputPassenger;
 
 /* Data processing task pass heating level of driver seat through this queue to be handled */
 QueueHandle_t     Q_heatingModeDriver;
 
-/* Heater handler pass heating level of passenger seat through this queue to be monitored */
-QueueHandle_t     Q_heatingLevelPassenger;
-
 /* Data processing task pass heating level of passenger seat through this queue to be handled */
 QueueHandle_t     Q_heatingModePassenger;
 
@@ -53,13 +49,22 @@ EventGroupHandle_t PB_group;
 info driver = {0,"Driver"};
 info passenger = {1,"Passenger"};
 
+/* Desired level of every seat (indexed by instance), changed by the push buttons and the console */
+volatile heatingMode_Type g_desiredLevel[2] = {HEATER_OFF, HEATER_OFF};
+
+/* Verbosity of the monitoring messages on the terminal, changed by the console */
+volatile logLevel_Type g_logLevel = LOG_NORMAL;
+
+/* Control parameters, changed by the console */
+controlConfig_Type g_controlConfigs = {HEATER_HIGH_BAND, HEATER_MEDIUM_BAND, HEATER_LOW_BAND, TEMPERATURE_CHANGE_THRESHOLD};
+
 /******************************************************************************/
 /* RTOS Runtime Measurements. *************************************************/
 /******************************************************************************/
 
-uint32 ullTasksOutTime[13];
-uint32 ullTasksInTime[13];
-uint32 ullTasksTotalTime[13];
+uint64 ullTasksOutTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+uint64 ullTasksInTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+uint64 ullTasksTotalTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
 
 /****************************************************************************
  *                             Hooks implementation
@@ -68,13 +73,15 @@ uint32 ullTasksTotalTime[13];
 /* Heap overflow hook */
 void vApplicationMallocFailedHook( void ){
 
-    while(1){}
+    /* Heaters to the safe state, the crash is dumped after the reset */
+    CRASH_capture(CRASH_CAUSE_MALLOC_FAILED, NULL, 0);
 }
 
 /* Stack overflow hook */
 void vApplicationStackOverflowHook( TaskHandle_t xTask,char *pcTaskName ){
 
-    while(1){}
+    /* Heaters to the safe state, the crash is dumped after the reset (the overflowed task is still the current task) */
+    CRASH_capture(CRASH_CAUSE_STACK_OVERFLOW, NULL, 0);
 }
 
 /****************************************************************************
@@ -85,14 +92,21 @@ void ISR_PORTFhandler(void){
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
+    /* While replaying a trace the replayed presses replace the real ones */
     if(GPIO_PORTF_GPIORIS_R & (1<<PB_DRIVER_CONTROL)){
 
-        xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_DRIVER_SEAT_BIT,&xHigherPriorityTaskWoken);
+        if(TRACE_mode != TRACE_REPLAY){
+
+            xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_DRIVER_SEAT_BIT,&xHigherPriorityTaskWoken);
+        }
         GPIO_PORTF_GPIOICR_R |= (1<<PB_DRIVER_CONTROL);
     }
     else if(GPIO_PORTF_GPIORIS_R & (1<<PB_PASSENGER_CONTROL)){
 
-        xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_PASSENGER_SEAT_BIT,&xHigherPriorityTaskWoken);
+        if(TRACE_mode != TRACE_REPLAY){
+
+            xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_PASSENGER_SEAT_BIT,&xHigherPriorityTaskWoken);
+        }
         GPIO_PORTF_GPIOICR_R |= (1<<PB_PASSENGER_CONTROL);
     }
 
@@ -105,10 +119,49 @@ void ISR_PORTBhandler(void){
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    if(GPIO_PORTB_GPIORIS_R & (1<<(PB_DRIVER_MULTI_FN % (NUM_OF_PINS_PER_PORT-1))) ){
+    if(GPIO_PORTB_GPIORIS_R & (1<<PB_PIN_OF(PB_DRIVER_MULTI_FN)) ){
+
+        if(TRACE_mode != TRACE_REPLAY){
+
+            xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_DRIVER_WHEEL_BIT,&xHigherPriorityTaskWoken);
+        }
+        GPIO_PORTB_GPIOICR_R |= (1<<PB_PIN_OF(PB_DRIVER_MULTI_FN));
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+}
+
+
+void ISR_UART0handler(void){
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* Wake up the console task only when a complete line is received */
+    if(UART0_RxISR() == TRUE){
+
+        vTaskNotifyGiveFromISR(task12handle,&xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+}
+
+
+void ISR_ADC0Seq1handler(void){
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8 windows = ADC_comparatorISR();
+
+    /* Wake up the monitoring task of every seat whose temperature left its window */
+    if(windows & (1<<TEMPERATURE_DRIVER_WINDOW)){
+
+        vTaskNotifyGiveFromISR(task2handle,&xHigherPriorityTaskWoken);
+    }
+
+    if(windows & (1<<TEMPERATURE_PASSENGER_WINDOW)){
 
-        xEventGroupSetBitsFromISR(PB_group, EVENTGROUP_DRIVER_WHEEL_BIT,&xHigherPriorityTaskWoken);
-        GPIO_PORTB_GPIOICR_R |= (1<<(PB_DRIVER_MULTI_FN % (NUM_OF_PINS_PER_PORT-1)));
+        vTaskNotifyGiveFromISR(task3handle,&xHigherPriorityTaskWoken);
     }
 
     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
@@ -116,6 +169,16 @@ void ISR_PORTBhandler(void){
 }
 
 
+void ISR_WDT0handler(void){
+
+    /* The supervisor stopped feeding the watchdog as a task stopped checking in (or the supervisor itself is starved),
+     * the heaters go to the safe state and the system is reset at once, if the capture ever hangs the interrupt
+     * isn't cleared so the watchdog still resets the system at its second time-out
+     */
+    CRASH_capture(CRASH_CAUSE_WATCHDOG, NULL, 0);
+}
+
+
 /****************************************************************************
  *                             Functions definition
  * ************************************************************************/
@@ -123,9 +186,15 @@ void ISR_PORTBhandler(void){
 void vSetupHardware( void )
 {
     /* Initialize all hardware components LEDs, Push buttons and Temperature sensor in addition to UART for monitoring
-     * and General Purpose Timer for runtime
+     * and the cycle clock for delays and runtime measurements
      *  */
 
+    /* System clock first as all other drivers compute their timing from it */
+    SYSCTL_init();
+
+    /* Cycle clock next as the delays and runtime measurements use it */
+    TIMEBASE_init();
+
     LED_init(LED_DRIVER_RED);
     LED_init(LED_DRIVER_GREEN);
     LED_init(LED_DRIVER_BLUE);
@@ -141,9 +210,218 @@ void vSetupHardware( void )
     PB_initEdgeTriggered(PB_PASSENGER_CONTROL,PB_INTERRUPT_PRIORITY);
 
     TEMPSENSOR_init();
+    TEMPSENSOR_initChangeDetection(ADC_COMPARATOR_INTERRUPT_PRIORITY);
+
+    UART0_Init(&UART0_configs);
+}
+
+
+void vHeatersSafeState( void ){
+
+    LED_SET(LED_DRIVER_RED, LED_ON);
+    LED_SET(LED_DRIVER_GREEN, LED_OFF);
+    LED_SET(LED_DRIVER_BLUE, LED_OFF);
+    LED_SET(LED_PASSENGER_RED, LED_ON);
+    LED_SET(LED_PASSENGER_GREEN, LED_OFF);
+    LED_SET(LED_PASSENGER_BLUE, LED_OFF);
+}
+
+
+boolean APP_setControlConfigs( const controlConfig_Type* configs ){
+
+    if(CONTROL_isValid(configs) == FALSE){
+
+        return FALSE;
+    }
+
+    taskENTER_CRITICAL();
+    g_controlConfigs = *configs;
+    taskEXIT_CRITICAL();
+
+    /* Both seats decide again with the new bands, a full queue already has a pending decision so it's not waited */
+    APP_sendInput(DRIVER, INPUT_CONTROL_UPDATE, 0, 0);
+    APP_sendInput(PASSENGER, INPUT_CONTROL_UPDATE, 0, 0);
+
+    return TRUE;
+}
+
+
+BaseType_t APP_sendInput( uint8 instance, inputKind_Type kind, uint8 value, TickType_t ticksToWait ){
+
+    inputMessage_Type message;
+
+    message.kind = kind;
+    message.value = value;
+
+    return xQueueSend((instance == DRIVER) ? Q_inputDriver : Q_inputPassenger, &message, ticksToWait);
+}
+
+
+static uint8 APP_temperatureWindow( uint8 instance ){
+
+    return (instance == DRIVER) ? TEMPERATURE_DRIVER_WINDOW : TEMPERATURE_PASSENGER_WINDOW;
+}
+
+/* Time in ms since the previous sample of the window, the fault detection times the stuck reading by it */
+static uint32 APP_sampleElapsedMs( uint8 window ){
+
+    static TickType_t lastSampleTick[TEMPERATURE_ZONES];
+    TickType_t now = xTaskGetTickCount();
+    TickType_t ticks = now - lastSampleTick[window];
+
+    lastSampleTick[window] = now;
+
+    return (uint32)(((uint64)ticks * 1000u) / configTICK_RATE_HZ);
+}
+
+
+boolean APP_readTemperature( uint8 instance, uint8* temperature ){
+
+    uint8 window = APP_temperatureWindow(instance);
+    uint16 reading;
+
+    if(xSemaphoreTake(ADC_mutex, 0) != pdTRUE){
+
+        return FALSE;
+    }
+
+    reading = TEMPSENSOR_readRaw((instance == DRIVER) ? TEMPERATURE_DRIVER : TEMPERATURE_PASSENGER);
+    xSemaphoreGive(ADC_mutex);
+
+    /* Replaced by the seat thermal model while it's simulated, it's not recorded in the traces as the control never sees it */
+    *temperature = TEMPSENSOR_rawToTemperature(window, PLANT_adcSample(window, reading));
+
+    return TRUE;
+}
+
+/* Send the initial temperature to DataProcessing task so it decides the heater intensity level according to it,
+ * returns FALSE if the ADC or the input queue isn't available within the wait (nothing is sent then)
+ */
+static boolean APP_startTemperatureMonitoring( const info* seat, uint8* previousTemp, TickType_t ticksToWait ){
+
+    uint8 window = APP_temperatureWindow(seat->instance);
+    uint16 reading;
+
+    if(xSemaphoreTake(ADC_mutex, ticksToWait) != pdTRUE){
+
+        return FALSE;
+    }
+
+    reading = TEMPSENSOR_readRaw((seat->instance == DRIVER) ? TEMPERATURE_DRIVER : TEMPERATURE_PASSENGER);
+
+    /* Same path as the periodic samples so the first one is simulated, recorded or replayed too */
+    reading = PLANT_adcSample(window, reading);
+    reading = TRACE_adcSample(window, reading);
+
+    TEMPSENSOR_checkSample(window, reading, APP_sampleElapsedMs(window));
+    *previousTemp = TEMPSENSOR_rawToTemperature(window, reading);
+
+#if (APP_PERIODIC_JOBS == 0)
+    /* From now the hardware compares every sample with the window around the last sent temperature */
+    TEMPSENSOR_armChangeDetection(window, *previousTemp, g_controlConfigs.changeThreshold);
+#endif
+
+    xSemaphoreGive(ADC_mutex);
+
+    return (boolean)(APP_sendInput(seat->instance, INPUT_CURRENT_TEMPERATURE, *previousTemp, ticksToWait) == pdPASS);
+}
+
+/* Read the seat sensor once, send the temperature to the DataProcessing task if it changed by the threshold
+ * and the fault state if it changed, the sample or the message that isn't possible within the wait is skipped
+ */
+static void APP_sampleTemperature( const info* seat, uint8* previousTemp, TickType_t ticksToWait ){
+
+    uint8 currentTemp;
+    boolean isChanged;
+    boolean isFaultChanged;
+
+    /* ADC reading of the sensor, every reading is checked by the fault detection before it's converted */
+    uint16 reading;
+
+    uint8 window = APP_temperatureWindow(seat->instance);
+
+    /* Acquire the ADC resource as there is 6 tasks trying to access the same resource by time slicing.  */
+    if(xSemaphoreTake(ADC_mutex, ticksToWait) != pdTRUE){
+
+        return;
+    }
+
+    /* Check the temperature sensor of the seat */
+    reading = TEMPSENSOR_readRaw((seat->instance == DRIVER) ? TEMPERATURE_DRIVER : TEMPERATURE_PASSENGER);
+
+    /* Replaced by the seat thermal model while it's simulated, then recorded or replaced by the replayed reading */
+    reading = PLANT_adcSample(window, reading);
+    reading = TRACE_adcSample(window, reading);
+
+    currentTemp = TEMPSENSOR_rawToTemperature(window, reading);
+
+    /* If there is at least 2 degrees changed then print the current temperature on terminal and send it to DataProcessing task,
+     * if the sensor becomes faulty or recovers it's also printed and the DataProcessing task is told, in verbose logging every sample is printed
+     */
+    isChanged = CONTROL_isChanged(&g_controlConfigs, currentTemp, *previousTemp);
+    isFaultChanged = TEMPSENSOR_checkSample(window, reading, APP_sampleElapsedMs(window));
+
+#if (APP_PERIODIC_JOBS == 0)
+    /* Re-arm the window around the last sent temperature, a sample already outside it interrupts immediately */
+    TEMPSENSOR_armChangeDetection(window, isChanged ? currentTemp : *previousTemp, g_controlConfigs.changeThreshold);
+#endif
+
+    /* Release ADC resource */
+    xSemaphoreGive(ADC_mutex);
+
+    if((isFaultChanged == TRUE) && (TEMPSENSOR_isFaulty(window) == TRUE)){
+
+        NVM_logFault(window, TEMPSENSOR_getLastFault(window));
+    }
+
+    if(isFaultChanged){
+
+        APP_sendInput(seat->instance, INPUT_SENSOR_FAULT, TEMPSENSOR_isFaulty(window), ticksToWait);
+    }
+
+    /* The change is sent again by the next sample if the queue is full */
+    if(isChanged && (APP_sendInput(seat->instance, INPUT_CURRENT_TEMPERATURE, currentTemp, ticksToWait) == pdPASS)){
+
+        *previousTemp = currentTemp;
+    }
+
+    if((g_logLevel == LOG_VERBOSE) || ((isChanged || isFaultChanged) && (g_logLevel == LOG_NORMAL))){
+
+        /* Acquire the UART resource as there is 6 tasks trying to access the same resource by time slicing.  */
+        if(xSemaphoreTake(UART_mutex, ticksToWait) == pdTRUE){
+
+            UART0_SendString("Current temperature of ");
+            UART0_SendString(seat->name);
+            UART0_SendString(" seat is : ");
+            UART0_SendInteger(currentTemp);
+            UART0_SendString(" degree celsius\r\n");
+
+            /* Release UART resource */
+            xSemaphoreGive(UART_mutex);
+        }
+    }
+}
+
+/* Print the CPU load since the start (the time of all tasks except the idle and timer tasks) */
+static void APP_reportCpuLoad( void ){
+
+    uint8 ucCounter, ucCPU_Load;
+    uint64 ullTotalTasksTime = 0;
+
+    for(ucCounter = 1; ucCounter < RUNTIME_MEASUREMENTS_TASKS_NUM; ucCounter++)
+    {
+        ullTotalTasksTime += ullTasksTotalTime[ucCounter];
+    }
+    ucCPU_Load = (ullTotalTasksTime * 100) /  TIMEBASE_getCycles();
+
+    if(g_logLevel != LOG_QUIET){
 
-    UART0_Init();
-    GPTM_WTimer0Init();
+        taskENTER_CRITICAL();
+        UART0_SendString("CPU Load is ");
+        UART0_SendInteger(ucCPU_Load);
+        UART0_SendString("% \r\n");
+        taskEXIT_CRITICAL();
+    }
 }
 
 
@@ -155,11 +433,20 @@ void vSetupHardware( void )
 void vInitialValuesTask( void * pvParameters ){
 
     uint8 initialTemperature;
+    CRASH_causeType resetCause;
 
     xSemaphoreTake(ADC_mutex,portMAX_DELAY);
     xSemaphoreTake(UART_mutex,portMAX_DELAY);
     initialTemperature = TEMPSENSOR_getTemperature(TEMPERATURE_DRIVER);
 
+    /* Every capture (the watchdog included) resets through the system reset request, so the cause is in the record */
+    if(CRASH_getResetCause(&resetCause) == TRUE){
+
+        UART0_SendString("The system was reset after a crash : ");
+        UART0_SendString((const uint8*)CRASH_causeName(resetCause));
+        UART0_SendString("\r\n");
+    }
+
     UART0_SendString("Initial temperature of ");
     UART0_SendString("Driver");
     UART0_SendString(" seat is : ");
@@ -191,6 +478,9 @@ void vInitialValuesTask( void * pvParameters ){
 
     xSemaphoreGive(UART_mutex);
 
+    /* The handle is no more valid after deletion, clear it so nobody uses it */
+    task1handle = NULL;
+
     vTaskDelete(NULL);
 
     /* Processor will never reach this line */
@@ -201,88 +491,48 @@ void vInitialValuesTask( void * pvParameters ){
 void vTemperatureMonitoringTask( void * pvParameters ){
 
     /*
-     * The previousTemp and currentTemp are made to control which temperature to be monitored on the terminal,
+     * The previousTemp is made to control which temperature to be monitored on the terminal,
      * as no temperature will be monitored unless there is a change in the temperature at least 2 degrees
      * (prevent too much data on the terminal)
      */
-    uint8 currentTemp;
     uint8 previousTemp;
 
-    /* Send the initial temperature to DataProcessing task just in case these initial values need to be processed
-     * and decide the heater intensity level according to initial temperature
-     */
-    previousTemp = TEMPSENSOR_getTemperature(((info*)pvParameters)->instance);
+    /* Window of the ADC digital comparator that samples the sensor of this seat, it's also the fault detection zone */
+    uint8 window = APP_temperatureWindow(((info*)pvParameters)->instance);
 
-    if(((info*)pvParameters)->instance == DRIVER){
+    SUPERVISOR_register(SUPERVISOR_TEMPERATURE_MONITORING_DRIVER + ((info*)pvParameters)->instance,
+                        TEMPERATURE_MONITORING_BACKSTOP_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
 
-        xQueueSend(Q_currentTempDriver,(void*)(&previousTemp),portMAX_DELAY);
-    }
-    else if(((info*)pvParameters)->instance == PASSENGER){
-
-        xQueueSend(Q_currentTempPassenger,(void*)(&previousTemp),portMAX_DELAY);
-    }
+    APP_startTemperatureMonitoring((info*)pvParameters, &previousTemp, portMAX_DELAY);
 
     while(1){
 
-        /* Reduce CPU load */
-        vTaskDelay(pdMS_TO_TICKS(500));
-
-        /* Acquire the ADC resource as there is 6 tasks trying to access the same resource by time slicing.  */
-        xSemaphoreTake(ADC_mutex,portMAX_DELAY);
+        SUPERVISOR_CHECK_IN(SUPERVISOR_TEMPERATURE_MONITORING_DRIVER + ((info*)pvParameters)->instance);
 
-        /* As this function shared between two tasks (with different stacks so currentTemp variable not the same),
-         * we must guarantee that every task access the right channel for temperature sensor.
+        /* Blocked until the comparator interrupt reports that the temperature left its window,
+         * the timeout is only a backstop so the task still reads the sensor if an interrupt is ever lost,
+         * while a sensor fault or recovery is being confirmed the sensor is read every sample period instead
          */
-        if(((info*)pvParameters)->instance == DRIVER){
-
-            /* Check the temperature sensor in the driver seat */
-            currentTemp = TEMPSENSOR_getTemperature(TEMPERATURE_DRIVER);
-        }
-        else if(((info*)pvParameters)->instance == PASSENGER){
+        if(TEMPSENSOR_isFaultPending(window) == TRUE){
 
-            /* Check the temperature sensor in the passenger seat */
-            currentTemp = TEMPSENSOR_getTemperature(TEMPERATURE_PASSENGER);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TEMPERATURE_SAMPLE_PERIOD_MS));
         }
+        else{
 
-        /* Release ADC resource */
-        xSemaphoreGive(ADC_mutex);
-
-
-        /* If there is at least 2 degrees changed then print the current temperature on terminal and send it to DataProcessing task */
-        if((currentTemp - previousTemp) >= 2 | (previousTemp - currentTemp) >= 2){
-
-            if(((info*)pvParameters)->instance == DRIVER){
-
-                xQueueSend(Q_currentTempDriver,(void*)(&currentTemp),portMAX_DELAY);
-            }
-            else if(((info*)pvParameters)->instance == PASSENGER){
-
-                xQueueSend(Q_currentTempPassenger,(void*)(&currentTemp),portMAX_DELAY);
-            }
-
-            /* Acquire the UART resource as there is 6 tasks trying to access the same resource by time slicing.  */
-            xSemaphoreTake(UART_mutex,portMAX_DELAY);
-
-            UART0_SendString("Current temperature of ");
-            UART0_SendString(((info*)pvParameters)->name);
-            UART0_SendString(" seat is : ");
-            UART0_SendInteger(currentTemp);
-            UART0_SendString(" degree celsius\r\n");
-            previousTemp = currentTemp;
-
-            /* Release UART resource */
-            xSemaphoreGive(UART_mutex);
-
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TEMPERATURE_MONITORING_BACKSTOP_PERIOD));
         }
 
+        APP_sampleTemperature((info*)pvParameters, &previousTemp, portMAX_DELAY);
     }
 }
 
 /* Monitoring the desired temperature read from both push buttons and pass these temperatures to handler task through queue*/
 void vButtonMonitoringTask( void * pvParameters ){
 
-    /* This is a state counter to loop between the states of desired temperature */
-    heatingMode_Type desiredLevel = HEATER_OFF;
+    /* This is a state counter to loop between the states of desired temperature,
+     * it starts from the current desired level of the seat which may also be changed by the console
+     */
+    heatingMode_Type desiredLevel;
 
     /* This flag indicates if there is a change in the desired temperature to monitor the new state
      * (prevent too much data on the terminal)
@@ -293,9 +543,12 @@ void vButtonMonitoringTask( void * pvParameters ){
 
     EventBits_t PB_group_value;
 
-    while(1){
+    SUPERVISOR_register(SUPERVISOR_BUTTON_MONITORING_DRIVER + ((info*)pvParameters)->instance,
+                        TASK_CHECK_IN_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
 
+    while(1){
 
+        SUPERVISOR_CHECK_IN(SUPERVISOR_BUTTON_MONITORING_DRIVER + ((info*)pvParameters)->instance);
 
         /* As this function shared between two tasks (with different stacks so desiredLevel and flag variables not the same),
          * we must guarantee that every task access the right channel for the push button.
@@ -306,13 +559,15 @@ void vButtonMonitoringTask( void * pvParameters ){
                                                  BitsToWaitFor,       /* The three bits to check on */
                                                  pdTRUE,              /* Clear events on exit */
                                                  pdFALSE,             /* If any of push buttons are pressed get ready */
-                                                 portMAX_DELAY);       /* Max delay to stay in blocked state */
+                                                 pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD)); /* Max delay to stay in blocked state, no bit is set on timeout */
 
             /* Check on the push button of the driver seat and the push button on the driving wheel */
             if((PB_group_value & EVENTGROUP_DRIVER_SEAT_BIT) | (PB_group_value & EVENTGROUP_DRIVER_WHEEL_BIT)){
 
+                TRACE_record(TRACE_EVENT_BUTTON, DRIVER, PB_group_value & (EVENTGROUP_DRIVER_SEAT_BIT | EVENTGROUP_DRIVER_WHEEL_BIT));
+
                 /* Go to next state */
-                desiredLevel++;
+                desiredLevel = g_desiredLevel[DRIVER] + 1;
 
                 vTaskDelay(pdMS_TO_TICKS(50));
 
@@ -321,8 +576,11 @@ void vButtonMonitoringTask( void * pvParameters ){
                     desiredLevel = HEATER_OFF;
                 }
 
+                g_desiredLevel[DRIVER] = desiredLevel;
+                NVM_saveSetpoints();
+
                 /* Send the new state to DataProcessing task */
-                xQueueSend(Q_desiredTempDriver,(void*)(&desiredLevel),portMAX_DELAY);
+                APP_sendInput(DRIVER, INPUT_DESIRED_LEVEL, desiredLevel, portMAX_DELAY);
 
                 flag = 1;
 
@@ -335,13 +593,15 @@ void vButtonMonitoringTask( void * pvParameters ){
                                                  BitsToWaitFor,       /* The three bits to check on */
                                                  pdTRUE,              /* Clear events on exit */
                                                  pdFALSE,             /* If any of push buttons are pressed get ready */
-                                                 portMAX_DELAY);       /* Max delay to stay in blocked state */
+                                                 pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD)); /* Max delay to stay in blocked state, no bit is set on timeout */
 
             /* Check on the push button of the passenger seat */
             if(PB_group_value & EVENTGROUP_PASSENGER_SEAT_BIT){
 
+                TRACE_record(TRACE_EVENT_BUTTON, PASSENGER, EVENTGROUP_PASSENGER_SEAT_BIT);
+
                 /* Go to next state */
-                desiredLevel++;
+                desiredLevel = g_desiredLevel[PASSENGER] + 1;
 
                 vTaskDelay(pdMS_TO_TICKS(50));
 
@@ -351,8 +611,11 @@ void vButtonMonitoringTask( void * pvParameters ){
                     desiredLevel = HEATER_OFF;
                 }
 
+                g_desiredLevel[PASSENGER] = desiredLevel;
+                NVM_saveSetpoints();
+
                 /* Send the new state to DataProcessing task */
-                xQueueSend(Q_desiredTempPassenger,(void*)(&desiredLevel),portMAX_DELAY);
+                APP_sendInput(PASSENGER, INPUT_DESIRED_LEVEL, desiredLevel, portMAX_DELAY);
 
                 flag = 1;
             }
@@ -361,7 +624,7 @@ void vButtonMonitoringTask( void * pvParameters ){
 
 
 
-        if(flag == 1){
+        if((flag == 1) && (g_logLevel != LOG_QUIET)){
 
             /* Acquire the UART resource as there is 6 tasks trying to access the same resource by time slicing.  */
             xSemaphoreTake(UART_mutex,portMAX_DELAY);
@@ -393,10 +656,10 @@ void vButtonMonitoringTask( void * pvParameters ){
             /* Release UART resource */
             xSemaphoreGive(UART_mutex);
 
-            flag = 0;
-
         }
 
+        flag = 0;
+
     }
 }
 
@@ -410,25 +673,28 @@ void vHeatingLevelMonitoringTask( void * pvParameters ){
      */
     heatingMode_Type previousHeatingLevel = HEATER_OFF;
     heatingMode_Type currentHeatingLevel;
+    STATUS_seatType status;
+
+    SUPERVISOR_register(SUPERVISOR_HEATING_LEVEL_MONITORING_DRIVER + ((info*)pvParameters)->instance,
+                        HEATING_LEVEL_MONITORING_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
+    SCHED_declarePeriod(HEATING_LEVEL_MONITORING_PERIOD, HEATING_LEVEL_MONITORING_PERIOD);
 
     while(1){
 
-        /* As this function shared between two tasks
-         * (with different stacks so currentHeatingLevel and desiredHeatingLevel variables not the same),
-         * we must guarantee that every task access the right queue.
-         */
-        if(((info*)pvParameters)->instance == DRIVER){
+        SUPERVISOR_CHECK_IN(SUPERVISOR_HEATING_LEVEL_MONITORING_DRIVER + ((info*)pvParameters)->instance);
 
-            xQueueReceive(Q_heatingLevelDriver,&currentHeatingLevel , portMAX_DELAY);
-        }
+        vTaskDelay(pdMS_TO_TICKS(HEATING_LEVEL_MONITORING_PERIOD));
 
-        else if(((info*)pvParameters)->instance == PASSENGER){
+        /* The heater mode decided for this seat is read from the status table (nothing is published yet at start-up) */
+        if(STATUS_read(((info*)pvParameters)->instance, &status) == FALSE){
 
-            xQueueReceive(Q_heatingLevelPassenger,&currentHeatingLevel , portMAX_DELAY);
+            continue;
         }
 
+        currentHeatingLevel = status.mode;
+
         /* If there is a change in the heating level monitor it (prevent too much data to be monitored) */
-        if(currentHeatingLevel != previousHeatingLevel){
+        if((currentHeatingLevel != previousHeatingLevel) && (g_logLevel != LOG_QUIET)){
 
             /* Acquire the UART resource as there is 6 tasks trying to access the same resource by time slicing.  */
             xSemaphoreTake(UART_mutex,portMAX_DELAY);
@@ -463,9 +729,9 @@ void vHeatingLevelMonitoringTask( void * pvParameters ){
 
             /* Release UART resource */
             xSemaphoreGive(UART_mutex);
-
-            previousHeatingLevel = currentHeatingLevel;
         }
+
+        previousHeatingLevel = currentHeatingLevel;
     }
 
 }
@@ -473,131 +739,106 @@ void vHeatingLevelMonitoringTask( void * pvParameters ){
 
 
 /* This task receives the desired and current temperature and process them to decide the intensity level of the heater
- * then pass it to the handler task and also to the heating level monitoring task to be monitored */
+ * then pass it to the handler task and publish it in the status table of the seat to be monitored */
 void vDataProcessingTask( void * pvParameters ){
 
     /* This variable used to convert the desired temperature from a state (0,1,2,3) to actual temperature (off,25,30,35) */
-    heatingMode_Type desiredLevel;
+    heatingMode_Type desiredLevel = HEATER_OFF;
 
     /* The following two variables will receive the current or desired temperature from according queue */
     desiredTemp_Type desiredTemperature;
     uint8 currentTemperature;
 
-    /* This variable will receive the handle of one of both queues (current temperature or desired temperature)
-     * to know which temperature is changed
-     */
-    QueueHandle_t modeOrTemp;
+    /* No decision is taken till the first current temperature is received */
+    boolean hasCurrentTemperature = FALSE;
+
+    /* Every input of this seat is received here, its kind tells which input is changed */
+    inputMessage_Type input;
+    BaseType_t isReceived;
 
     /* The last decision of the heater intensity level will be places here and sent to the handler task */
     heatingMode_Type Mode=HEATER_OFF;
 
-    while(1){
+    /* Control parameters of this decision, copied at once as the console may change them */
+    controlConfig_Type control;
 
-        /* Check which task accessing this function (driver of passenger) */
-        if(((info*)pvParameters)->instance == DRIVER){
+    /* Inputs and decision of this seat published for the other tasks */
+    STATUS_seatType status;
 
+    SUPERVISOR_register(SUPERVISOR_DATA_PROCESSING_DRIVER + ((info*)pvParameters)->instance,
+                        TASK_CHECK_IN_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
 
-            /* The task will be blocked until desired temperature or current temperature change, every temperature is passed
-             * through their according queue, notice that both queues (current temperature and desired temperature) are in same queue set,
-             * so we must check which temperature is changed (desired or current)
-             *  */
-            modeOrTemp = xQueueSelectFromSet(QS_DriverTemp, portMAX_DELAY);
-
-            if(modeOrTemp == Q_currentTempDriver){
+    while(1){
 
-                xQueueReceive(Q_currentTempDriver, &currentTemperature , portMAX_DELAY);
-            }
-            else if(modeOrTemp == Q_desiredTempDriver){
+        SUPERVISOR_CHECK_IN(SUPERVISOR_DATA_PROCESSING_DRIVER + ((info*)pvParameters)->instance);
 
-                xQueueReceive(Q_desiredTempDriver, &desiredLevel , portMAX_DELAY);
-            }
+        /* The task will be blocked until any input of this seat changes, all inputs are passed through one queue
+         * so one receive gets both the kind of the input and its value
+         *  */
+        if(((info*)pvParameters)->instance == DRIVER){
 
+            isReceived = xQueueReceive(Q_inputDriver, &input, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD));
         }
         else if (((info*)pvParameters)->instance == PASSENGER){
 
-            modeOrTemp = xQueueSelectFromSet(QS_PassengerTemp, portMAX_DELAY);
-
-            if(modeOrTemp == Q_currentTempPassenger){
-
-                xQueueReceive(Q_currentTempPassenger, &currentTemperature , portMAX_DELAY);
-            }
-            else if(modeOrTemp == Q_desiredTempPassenger){
-
-                xQueueReceive(Q_desiredTempPassenger, &desiredLevel , portMAX_DELAY);
-            }
+            isReceived = xQueueReceive(Q_inputPassenger, &input, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD));
         }
 
-        /* Put the actual temperature in the desired level variable not just a state */
-        switch(desiredLevel){
-
-        case HEATER_OFF:
-
-            /* Off */
-            desiredTemperature = LEVEL0;
-            break;
+        if(isReceived == pdTRUE){
 
-        case HEATER_LOW:
+            switch(input.kind){
 
-            /* 25 degree celsius */
-            desiredTemperature = LEVEL1;
-            break;
-
-        case HEATER_MEDIUM:
-
-            /* 30 degree celsius */
-            desiredTemperature = LEVEL2;
-            break;
-
-        case HEATER_HIGH:
+            case INPUT_CURRENT_TEMPERATURE:
 
-            /* 35 degree celsius */
-            desiredTemperature = LEVEL3;
-            break;
-        }
+                currentTemperature = input.value;
+                hasCurrentTemperature = TRUE;
+                break;
 
+            case INPUT_DESIRED_LEVEL:
 
-        /* If the current temperature in this range then the temperature sensor is failed so turn off heater and turn on red LED */
-        if((currentTemperature > 40) || (currentTemperature < 5)){
+                desiredLevel = (heatingMode_Type)input.value;
+                break;
 
-            Mode = TEMPERATURE_SENSOR_FAILURE;
+            /* The fault state is read from the sensor module when deciding, the same as new control parameters */
+            case INPUT_SENSOR_FAULT:
+            case INPUT_CONTROL_UPDATE:
+            default:
+                break;
+            }
         }
 
-        /* If difference between desired temperature and current temperature 10 or greater then turn on heater on high intensity */
-        else if((desiredTemperature - currentTemperature) >= 10){
+        /* Nothing is received (timeout) or no decision can be taken yet */
+        if((isReceived != pdTRUE) || (hasCurrentTemperature == FALSE)){
 
-            Mode = HEATER_HIGH;
+            continue;
         }
 
-        /* If difference between desired temperature and current temperature 5 or greater then turn on heater on medium intensity */
-        else if((desiredTemperature - currentTemperature) >= 5){
-
-            Mode = HEATER_MEDIUM;
-        }
+        desiredTemperature = CONTROL_desiredTemperature(desiredLevel);
 
-        /* If difference between desired temperature and current temperature 2 or greater then turn on heater on low intensity */
-        else if((desiredTemperature - currentTemperature) >= 2){
+        taskENTER_CRITICAL();
+        control = g_controlConfigs;
+        taskEXIT_CRITICAL();
 
-            Mode = HEATER_LOW;
-        }
+        /* The control law (Control.h) is shared with the host tools */
+        Mode = CONTROL_decide(&control, desiredTemperature, currentTemperature, TEMPSENSOR_isFaulty(((info*)pvParameters)->instance));
 
-        /* If difference between desired temperature and current temperature less than 2 then turn off heater */
-        else{
+        status.currentTemperature = currentTemperature;
+        status.desiredTemperature = desiredTemperature;
+        status.desiredLevel = desiredLevel;
+        status.mode = Mode;
+        status.tick = xTaskGetTickCount();
 
-            Mode = HEATER_OFF;
-        }
+        /* Publish the decision for the heater monitoring task, the console and any other reader */
+        STATUS_publish(((info*)pvParameters)->instance, &status);
 
         if(((info*)pvParameters)->instance == DRIVER){
 
             /* Send the decided mode to the handler task to handle heater */
             xQueueSend(Q_heatingModeDriver,&Mode,portMAX_DELAY);
-
-            /* Send the decided mode to the heater monitoring task to monitor the heater intensity level */
-            xQueueSend(Q_heatingLevelDriver,&Mode,portMAX_DELAY);
         }
         else if(((info*)pvParameters)->instance == PASSENGER){
 
             xQueueSend(Q_heatingModePassenger,&Mode,portMAX_DELAY);
-            xQueueSend(Q_heatingLevelPassenger,&Mode,portMAX_DELAY);
         }
     }
 }
@@ -608,20 +849,39 @@ void vHeaterHandlerTask( void * pvParameters ){
 
     /* This is the variable in which the task will receive the heater intensity level from Data processing task */
     heatingMode_Type Mode=HEATER_OFF;
+    BaseType_t isReceived = pdFALSE;
 
+    /* Only the changes of the heater are recorded in the trace */
+    heatingMode_Type previousMode = HEATER_OFF;
+
+    SUPERVISOR_register(SUPERVISOR_HEATER_HANDLER_DRIVER + ((info*)pvParameters)->instance,
+                        TASK_CHECK_IN_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
 
     while(1){
 
+        SUPERVISOR_CHECK_IN(SUPERVISOR_HEATER_HANDLER_DRIVER + ((info*)pvParameters)->instance);
+
         /* As this function shared between two tasks (with different stacks so Mode variable not the same),
          * we must guarantee that every task access the right heater.
          */
         if(((info*)pvParameters)->instance == DRIVER){
 
-            xQueueReceive(Q_heatingModeDriver, &Mode, portMAX_DELAY);
+            isReceived = xQueueReceive(Q_heatingModeDriver, &Mode, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD));
         }
         else if(((info*)pvParameters)->instance == PASSENGER){
 
-            xQueueReceive(Q_heatingModePassenger, &Mode, portMAX_DELAY);
+            isReceived = xQueueReceive(Q_heatingModePassenger, &Mode, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD));
+        }
+
+        if(isReceived == pdFALSE){
+
+            continue;
+        }
+
+        if(Mode != previousMode){
+
+            TRACE_record(TRACE_EVENT_HEATER, ((info*)pvParameters)->instance, Mode);
+            previousMode = Mode;
         }
 
         /* Handle the heater according to the received mode from DataProcessing task */
@@ -634,15 +894,15 @@ void vHeaterHandlerTask( void * pvParameters ){
              */
             if(((info*)pvParameters)->instance == DRIVER){
 
-                LED_set(LED_DRIVER_RED, LED_OFF);
-                LED_set(LED_DRIVER_GREEN, LED_OFF);
-                LED_set(LED_DRIVER_BLUE, LED_OFF);
+                LED_SET(LED_DRIVER_RED, LED_OFF);
+                LED_SET(LED_DRIVER_GREEN, LED_OFF);
+                LED_SET(LED_DRIVER_BLUE, LED_OFF);
             }
             else if(((info*)pvParameters)->instance == PASSENGER){
 
-                LED_set(LED_PASSENGER_RED, LED_OFF);
-                LED_set(LED_PASSENGER_GREEN, LED_OFF);
-                LED_set(LED_PASSENGER_BLUE, LED_OFF);
+                LED_SET(LED_PASSENGER_RED, LED_OFF);
+                LED_SET(LED_PASSENGER_GREEN, LED_OFF);
+                LED_SET(LED_PASSENGER_BLUE, LED_OFF);
             }
 
             break;
@@ -651,15 +911,15 @@ void vHeaterHandlerTask( void * pvParameters ){
 
             if(((info*)pvParameters)->instance == DRIVER){
 
-                LED_set(LED_DRIVER_RED, LED_OFF);
-                LED_set(LED_DRIVER_GREEN, LED_ON);
-                LED_set(LED_DRIVER_BLUE, LED_OFF);
+                LED_SET(LED_DRIVER_RED, LED_OFF);
+                LED_SET(LED_DRIVER_GREEN, LED_ON);
+                LED_SET(LED_DRIVER_BLUE, LED_OFF);
             }
             else if(((info*)pvParameters)->instance == PASSENGER){
 
-                LED_set(LED_PASSENGER_RED, LED_OFF);
-                LED_set(LED_PASSENGER_GREEN, LED_ON);
-                LED_set(LED_PASSENGER_BLUE, LED_OFF);
+                LED_SET(LED_PASSENGER_RED, LED_OFF);
+                LED_SET(LED_PASSENGER_GREEN, LED_ON);
+                LED_SET(LED_PASSENGER_BLUE, LED_OFF);
             }
 
             break;
@@ -668,15 +928,15 @@ void vHeaterHandlerTask( void * pvParameters ){
 
             if(((info*)pvParameters)->instance == DRIVER){
 
-                LED_set(LED_DRIVER_RED, LED_OFF);
-                LED_set(LED_DRIVER_GREEN, LED_OFF);
-                LED_set(LED_DRIVER_BLUE, LED_ON);
+                LED_SET(LED_DRIVER_RED, LED_OFF);
+                LED_SET(LED_DRIVER_GREEN, LED_OFF);
+                LED_SET(LED_DRIVER_BLUE, LED_ON);
             }
             else if(((info*)pvParameters)->instance == PASSENGER){
 
-                LED_set(LED_PASSENGER_RED, LED_OFF);
-                LED_set(LED_PASSENGER_GREEN, LED_OFF);
-                LED_set(LED_PASSENGER_BLUE, LED_ON);
+                LED_SET(LED_PASSENGER_RED, LED_OFF);
+                LED_SET(LED_PASSENGER_GREEN, LED_OFF);
+                LED_SET(LED_PASSENGER_BLUE, LED_ON);
             }
 
             break;
@@ -685,15 +945,15 @@ void vHeaterHandlerTask( void * pvParameters ){
 
             if(((info*)pvParameters)->instance == DRIVER){
 
-                LED_set(LED_DRIVER_RED, LED_OFF);
-                LED_set(LED_DRIVER_GREEN, LED_ON);
-                LED_set(LED_DRIVER_BLUE, LED_ON);
+                LED_SET(LED_DRIVER_RED, LED_OFF);
+                LED_SET(LED_DRIVER_GREEN, LED_ON);
+                LED_SET(LED_DRIVER_BLUE, LED_ON);
             }
             else if(((info*)pvParameters)->instance == PASSENGER){
 
-                LED_set(LED_PASSENGER_RED, LED_OFF);
-                LED_set(LED_PASSENGER_GREEN, LED_ON);
-                LED_set(LED_PASSENGER_BLUE, LED_ON);
+                LED_SET(LED_PASSENGER_RED, LED_OFF);
+                LED_SET(LED_PASSENGER_GREEN, LED_ON);
+                LED_SET(LED_PASSENGER_BLUE, LED_ON);
             }
 
             break;
@@ -703,15 +963,15 @@ void vHeaterHandlerTask( void * pvParameters ){
 
             if(((info*)pvParameters)->instance == DRIVER){
 
-                LED_set(LED_DRIVER_RED, LED_ON);
-                LED_set(LED_DRIVER_GREEN, LED_OFF);
-                LED_set(LED_DRIVER_BLUE, LED_OFF);
+                LED_SET(LED_DRIVER_RED, LED_ON);
+                LED_SET(LED_DRIVER_GREEN, LED_OFF);
+                LED_SET(LED_DRIVER_BLUE, LED_OFF);
             }
             else if(((info*)pvParameters)->instance == PASSENGER){
 
-                LED_set(LED_PASSENGER_RED, LED_ON);
-                LED_set(LED_PASSENGER_GREEN, LED_OFF);
-                LED_set(LED_PASSENGER_BLUE, LED_OFF);
+                LED_SET(LED_PASSENGER_RED, LED_ON);
+                LED_SET(LED_PASSENGER_GREEN, LED_OFF);
+                LED_SET(LED_PASSENGER_BLUE, LED_OFF);
             }
 
             break;
@@ -724,22 +984,63 @@ void vHeaterHandlerTask( void * pvParameters ){
 /* Runtime measurements */
 void vRunTimeMeasurementsTask(void *pvParameters){
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    static PERIODIC_taskType periodic;
+
+    SUPERVISOR_register(SUPERVISOR_RUNTIME_MEASUREMENTS, RUNTIME_MEASUREMENTS_TASK_PERIODICITY + SUPERVISOR_CHECK_IN_MARGIN);
+    PERIODIC_start(&periodic, "Runtime measurements", RUNTIME_MEASUREMENTS_TASK_PERIODICITY, RUNTIME_MEASUREMENTS_DEADLINE);
+
     for (;;)
     {
-        uint8 ucCounter, ucCPU_Load;
-        uint32 ullTotalTasksTime = 0;
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(RUNTIME_MEASUREMENTS_TASK_PERIODICITY));
-        for(ucCounter = 1; ucCounter < 13; ucCounter++)
-        {
-            ullTotalTasksTime += ullTasksTotalTime[ucCounter];
-        }
-        ucCPU_Load = (ullTotalTasksTime * 100) /  GPTM_WTimer0Read();
+        SUPERVISOR_CHECK_IN(SUPERVISOR_RUNTIME_MEASUREMENTS);
+        PERIODIC_waitRelease(&periodic);
+        APP_reportCpuLoad();
+        PERIODIC_complete(&periodic);
+    }
+}
 
-        taskENTER_CRITICAL();
-        UART0_SendString("CPU Load is ");
-        UART0_SendInteger(ucCPU_Load);
-        UART0_SendString("% \r\n");
-        taskEXIT_CRITICAL();
+/****************************************************************************
+ *                               Jobs definition
+ * ************************************************************************/
+
+#if (APP_PERIODIC_JOBS == 1)
+
+/* Last sent temperature of every seat and if its initial temperature is sent */
+static uint8 g_jobPreviousTemp[2];
+static boolean g_isJobStarted[2] = {FALSE, FALSE};
+
+void vTemperatureMonitoringJob(void *pvParameters){
+
+    uint8 instance = ((info*)pvParameters)->instance;
+
+    if(g_isJobStarted[instance] == FALSE){
+
+        SUPERVISOR_register(SUPERVISOR_TEMPERATURE_MONITORING_DRIVER + instance,
+                            TEMPERATURE_SAMPLE_PERIOD_MS + SUPERVISOR_CHECK_IN_MARGIN);
+
+        /* Retried by the next release if the ADC or the queue is busy */
+        g_isJobStarted[instance] = APP_startTemperatureMonitoring((info*)pvParameters, &g_jobPreviousTemp[instance], 0);
     }
+    else{
+
+        APP_sampleTemperature((info*)pvParameters, &g_jobPreviousTemp[instance], 0);
+    }
+
+    SUPERVISOR_CHECK_IN(SUPERVISOR_TEMPERATURE_MONITORING_DRIVER + instance);
 }
+
+
+void vRunTimeMeasurementsJob(void *pvParameters){
+
+    static boolean isRegistered = FALSE;
+
+    if(isRegistered == FALSE){
+
+        SUPERVISOR_register(SUPERVISOR_RUNTIME_MEASUREMENTS, RUNTIME_MEASUREMENTS_TASK_PERIODICITY + SUPERVISOR_CHECK_IN_MARGIN);
+        isRegistered = TRUE;
+    }
+
+    SUPERVISOR_CHECK_IN(SUPERVISOR_RUNTIME_MEASUREMENTS);
+    APP_reportCpuLoad();
+}
+
+#endif
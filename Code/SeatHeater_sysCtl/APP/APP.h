@@ -32,20 +32,22 @@
 #include"HAL/LED.h"
 #include"HAL/pushbutton.h"
 #include"HAL/Temperature_sensor.h"
+#include"Control.h"
 
 /* other includes */
 
+#include"MCAL/SysCtl.h"
 #include"MCAL/UART0.h"
-#include"MCAL/GPTM.h"
+#include"MCAL/Timebase.h"
+#include"MCAL/Format.h"
 #include"MCAL/delay.h"
 
 /***************************************************************************
  *                                Definitions
  *************************************************************************** */
 
-#define QUEUE_CURRENT_TEMP_SIZE     5u
-#define QUEUE_DESIRED_TEMP_SIZE     5u
-#define QUEUE_HEATING_LEVEL_SIZE    5u
+/* Room for the current temperature, desired level, fault and control updates of one seat */
+#define QUEUE_INPUT_SIZE            10u
 #define QUEUE_HEATING_MODE_SIZE     5u
 
 #define EVENTGROUP_DRIVER_SEAT_BIT          (1ul<<0ul)
@@ -53,12 +55,34 @@
 #define EVENTGROUP_PASSENGER_SEAT_BIT       (1ul<<2)
 
 #define PB_INTERRUPT_PRIORITY       5
+#define UART0_RX_INTERRUPT_PRIORITY 6
+#define ADC_COMPARATOR_INTERRUPT_PRIORITY 6
+
+/* Above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY so no critical section or failed assertion masks the watchdog */
+#define WATCHDOG_INTERRUPT_PRIORITY 0
+
+/* The monitoring task reads the temperature at least once every period even if the comparator never interrupts */
+#define TEMPERATURE_MONITORING_BACKSTOP_PERIOD  10000
 
 #define DRIVER                      0u
 #define PASSENGER                   1u
 
 #define RUNTIME_MEASUREMENTS_TASK_PERIODICITY   5000
 
+/* Deadline from every release of the runtime measurements (task or job) */
+#define RUNTIME_MEASUREMENTS_DEADLINE           100
+
+/* Deadline from the release of the temperature monitoring jobs in the periodic jobs mode (APP_PERIODIC_JOBS) */
+#define TEMPERATURE_MONITORING_JOB_DEADLINE     20
+
+/* Event driven tasks block for at most this time on their queues, event groups and notifications
+ * so they check in with the supervisor even when there are no events
+ */
+#define TASK_CHECK_IN_PERIOD                    1000
+
+/* The heating level monitoring tasks poll the status table of their seat (Status.h) every this time */
+#define HEATING_LEVEL_MONITORING_PERIOD         100
+
 /***************************************************************************
  *                             Types declaration
  *************************************************************************** */
@@ -73,22 +97,28 @@ typedef struct{
 
 typedef enum{
 
-    HEATER_OFF,
-    HEATER_LOW,
-    HEATER_MEDIUM,
-    HEATER_HIGH,
-    TEMPERATURE_SENSOR_FAILURE
+    LOG_QUIET,      /* Nothing is printed except console replies */
+    LOG_NORMAL,     /* Changes in temperature, desired temperature and heater state are printed */
+    LOG_VERBOSE     /* Every temperature sample is printed */
 
-}heatingMode_Type;
+}logLevel_Type;
 
+/* Kind of every message in the input queue of a DataProcessing task, add a new input kind here and handle it in the task */
 typedef enum{
 
-    LEVEL0=HEATER_OFF,
-    LEVEL1=25,
-    LEVEL2=30,
-    LEVEL3=35
+    INPUT_CURRENT_TEMPERATURE,  /* value is the temperature in degree celsius */
+    INPUT_DESIRED_LEVEL,        /* value is the heatingMode_Type level (HEATER_OFF to HEATER_HIGH) */
+    INPUT_SENSOR_FAULT,         /* value is TRUE when the sensor becomes faulty and FALSE when it recovers */
+    INPUT_CONTROL_UPDATE        /* value is unused, the control parameters are changed */
+
+}inputKind_Type;
 
-}desiredTemp_Type;
+typedef struct{
+
+    uint8 kind;     /* inputKind_Type */
+    uint8 value;
+
+}inputMessage_Type;
 
 /****************************************************************************
  *                              Global variables
@@ -100,27 +130,15 @@ extern SemaphoreHandle_t ADC_mutex;
 /* This mutex for the mutual exclusion between Driver and passenger of UART in any monitoring task */
 extern SemaphoreHandle_t UART_mutex;
 
-/* The following two queues refer to the temperature set by both driver and passenger by the push buttons */
-extern QueueHandle_t     Q_desiredTempDriver;
-extern QueueHandle_t     Q_desiredTempPassenger;
-
-/* The following two queues refer to the temperature measured by temperature sensor in both seats */
-extern QueueHandle_t     Q_currentTempDriver;
-extern QueueHandle_t     Q_currentTempPassenger;
-
-/* Each of the following queue sets combine both the current and desired temperature (queue set for driver and other for passenger) */
-extern QueueSetHandle_t QS_DriverTemp;
-extern QueueSetHandle_t QS_PassengerTemp;
-
-/* Heater handler pass heating level of driver seat through this queue to be monitored */
-extern QueueHandle_t     Q_heatingLevelDriver;
+/* Every input of the DataProcessing task of each seat (current temperature, desired level, fault and control updates)
+ * is a tagged inputMessage_Type in one of the following two queues, use APP_sendInput to send to them
+ */
+extern QueueHandle_t     Q_inputDriver;
+extern QueueHandle_t     Q_inputPassenger;
 
 /* Data processing task pass heating level of driver seat through this queue to be handled */
 extern QueueHandle_t     Q_heatingModeDriver;
 
-/* Heater handler pass heating level of passenger seat through this queue to be monitored */
-extern QueueHandle_t     Q_heatingLevelPassenger;
-
 /* Data processing task pass heating level of passenger seat through this queue to be handled */
 extern QueueHandle_t     Q_heatingModePassenger;
 
@@ -131,13 +149,22 @@ extern EventGroupHandle_t PB_group;
 extern info driver;
 extern info passenger;
 
+/* Desired level of every seat (indexed by instance), changed by the push buttons and the console */
+extern volatile heatingMode_Type g_desiredLevel[2];
+
+/* Verbosity of the monitoring messages on the terminal, changed by the console */
+extern volatile logLevel_Type g_logLevel;
+
+/* Control parameters, read only, use APP_setControlConfigs to change them */
+extern controlConfig_Type g_controlConfigs;
+
 /******************************************************************************/
 /* RTOS Runtime Measurements. *************************************************/
 /******************************************************************************/
 
-extern uint32 ullTasksOutTime[13];
-extern uint32 ullTasksInTime[13];
-extern uint32 ullTasksTotalTime[13];
+extern uint64 ullTasksOutTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+extern uint64 ullTasksInTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+extern uint64 ullTasksTotalTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
 
 TaskHandle_t task0handle;   /* RunTime measurements task */
 TaskHandle_t task1handle;   /* vInitialValuesTask */
@@ -151,6 +178,9 @@ TaskHandle_t task8handle;   /* vHeaterHandlerTask for driver */
 TaskHandle_t task9handle;   /* vHeaterHandlerTask for passenger */
 TaskHandle_t task10handle;  /* vDataProcessingTask for driver */
 TaskHandle_t task11handle;  /* vDataProcessingTask for passenger */
+TaskHandle_t task12handle;  /* vConsoleTask */
+TaskHandle_t task13handle;  /* vNvmWriterTask */
+TaskHandle_t task14handle;  /* vSupervisorTask */
 
 /****************************************************************************
  *                              Hooks prototype
@@ -169,6 +199,20 @@ void vApplicationMallocFailedHook( void );
 /* Initialize all hardware components */
 void vSetupHardware( void );
 
+/* Turn off both heaters and turn on both red LEDs, it only writes the LEDs so it can be called from any context */
+void vHeatersSafeState( void );
+
+/* Returns FALSE and keeps the old parameters unless (high band > medium band > low band) and the change threshold isn't 0,
+ * the parameters are changed at once so no task sees a mix of old and new parameters */
+boolean APP_setControlConfigs( const controlConfig_Type* configs );
+
+/* Send one input to the DataProcessing task of the seat, returns pdPASS or errQUEUE_FULL after waiting the given ticks */
+BaseType_t APP_sendInput( uint8 instance, inputKind_Type kind, uint8 value, TickType_t ticksToWait );
+
+/* Read the temperature of the seat without the fault detection, the traces or the change detection,
+ * returns FALSE at once if the ADC is in use (it never blocks so it can be called from a timer callback) */
+boolean APP_readTemperature( uint8 instance, uint8* temperature );
+
 /****************************************************************************
  *                               Tasks prototype
  * ************************************************************************/
@@ -186,7 +230,7 @@ void vButtonMonitoringTask( void * pvParameters );
 void vHeatingLevelMonitoringTask( void * pvParameters );
 
 /* This task receives the desired and current temperature and process them to decide the intensity level of the heater
- * then pass it to the handler task and also to the heating level monitoring task to be monitored */
+ * then pass it to the handler task and publish it in the status table of the seat to be monitored */
 void vDataProcessingTask( void * pvParameters );
 
 /* Handler task which receive the intensity level of the heater which been decided by the DataProcessing task*/
@@ -197,6 +241,21 @@ void vHeaterHandlerTask( void * pvParameters );
 /* Runtime measurements */
 void vRunTimeMeasurementsTask(void *pvParameters);
 
+/****************************************************************************
+ *                               Jobs prototype
+ * ************************************************************************/
+
+#if (APP_PERIODIC_JOBS == 1)
+
+/* Same as vTemperatureMonitoringTask but the sensor is read once every release instead of waiting for the comparator,
+ * the ADC, the queue and the UART are never waited for */
+void vTemperatureMonitoringJob(void *pvParameters);
+
+/* Same as vRunTimeMeasurementsTask, one report every release */
+void vRunTimeMeasurementsJob(void *pvParameters);
+
+#endif
+
 
 
 
@@ -0,0 +1,714 @@
+/**********************************************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Benchmark.c
+ *
+ * Description: Source file of the micro benchmarks of the FreeRTOS primitives used by the application
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Benchmark.h"
+#include"Status.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Header of every heap_4 block (BlockLink_t) rounded up to the heap alignment */
+#define BENCH_HEAP_HEADER_SIZE      ((sizeof(void*) + sizeof(size_t) + portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK))
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    uint32 min;
+    uint32 max;
+    uint32 total;
+
+}BENCH_statsType;
+
+/* Measured, busy and blocked cycles of the calls of one delay */
+typedef struct{
+
+    BENCH_statsType measured;
+    uint64 busy;
+    uint64 blocked;
+
+}BENCH_delayStatsType;
+
+/* One delay row : _delay_us or _delay_ms with the requested time */
+typedef struct{
+
+    const char* name;
+    boolean isMs;
+    uint32 time;
+
+}BENCH_delayType;
+
+/* Object the helper task is blocked on, in the order they are measured */
+typedef enum{
+
+    BENCH_HANDOFF_INPUT,
+#if (configUSE_QUEUE_SETS == 1)
+    BENCH_HANDOFF_QUEUE_SET,
+#endif
+    BENCH_HANDOFF_EVENT_GROUP,
+    BENCH_HANDOFF_NOTIFY,
+    BENCH_HANDOFF_MUTEX,
+    BENCH_HANDOFFS_NUM
+
+}BENCH_handoffType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static QueueHandle_t g_queue;
+#if (configUSE_QUEUE_SETS == 1)
+static QueueHandle_t g_setMember;
+static QueueSetHandle_t g_set;
+#endif
+static EventGroupHandle_t g_group;
+static SemaphoreHandle_t g_mutex;
+static TaskHandle_t g_helper;
+
+/* Handoff the helper blocks on next time and the cycle counter when it ran for the last time */
+static volatile BENCH_handoffType g_handoff;
+static volatile uint32 g_wakeCycles;
+
+/* Cycles of reading the counter twice, subtracted from every measurement */
+static uint32 g_overhead;
+
+/* Output of the format rows, not on the stack so the unused conversions aren't optimized away */
+static uint8 g_formatText[FORMAT_NUMBER_SIZE];
+
+/* Formatted values : a temperature, a runtime in micro seconds and the largest magnitude the former conversion handles */
+static const sint64 g_formatValues[BENCH_FORMAT_VALUES_NUM] = {35, 1234567, -9223372036854775807ll};
+
+static const char* const g_formatNames[BENCH_FORMAT_VALUES_NUM][2] = {
+
+    {"format_legacy_2_digits",  "format_sint64_2_digits"},
+    {"format_legacy_7_digits",  "format_sint64_7_digits"},
+    {"format_legacy_19_digits", "format_sint64_19_digits"}
+};
+
+/* Short settling waits busy-wait, the waits of a tick or more block the task for the whole ticks */
+static const BENCH_delayType g_delays[BENCH_DELAYS_NUM] = {
+
+    {"delay_us_1",   FALSE, 1},
+    {"delay_us_10",  FALSE, 10},
+    {"delay_us_100", FALSE, 100},
+    {"delay_ms_1",   TRUE,  1},
+    {"delay_ms_2",   TRUE,  2},
+    {"delay_ms_5",   TRUE,  5}
+};
+
+static const char* const g_handoffNames[BENCH_HANDOFFS_NUM] = {
+
+    "input",
+#if (configUSE_QUEUE_SETS == 1)
+    "queue_set",
+#endif
+    "event_group", "notify", "mutex"
+};
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Heap taken by one allocation in the worst case : the header, the alignment and a remainder of the free block
+ * too small to be split off (heap_4 splits only remainders of two headers or more)
+ */
+static size_t BENCH_heapBlock(size_t size){
+
+    return ((size + BENCH_HEAP_HEADER_SIZE + portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK)) + (2u * BENCH_HEAP_HEADER_SIZE);
+}
+
+/* Heap of every object BENCH_run creates, the static types have the sizes of the kernel objects */
+static size_t BENCH_requiredHeap(void){
+
+    size_t size = BENCH_heapBlock(sizeof(StaticQueue_t) + sizeof(inputMessage_Type))     /* Input queue */
+                + BENCH_heapBlock(sizeof(StaticEventGroup_t))                           /* Event group */
+                + BENCH_heapBlock(sizeof(StaticQueue_t))                                /* Mutex */
+                + BENCH_heapBlock(sizeof(StaticTask_t))                                 /* Helper TCB */
+                + BENCH_heapBlock(configMINIMAL_STACK_SIZE * sizeof(StackType_t));      /* Helper stack */
+
+#if (configUSE_QUEUE_SETS == 1)
+    size += BENCH_heapBlock(sizeof(StaticQueue_t) + sizeof(uint8))                      /* Set member */
+          + BENCH_heapBlock(sizeof(StaticQueue_t) + sizeof(void*));                     /* Queue set */
+#endif
+
+    return size;
+}
+
+static void BENCH_reset(BENCH_statsType* stats){
+
+    stats->min = 0xFFFFFFFFul;
+    stats->max = 0;
+    stats->total = 0;
+}
+
+static void BENCH_add(BENCH_statsType* stats, uint32 cycles){
+
+    cycles = (cycles > g_overhead) ? (cycles - g_overhead) : 0;
+
+    if(cycles < stats->min){
+
+        stats->min = cycles;
+    }
+
+    if(cycles > stats->max){
+
+        stats->max = cycles;
+    }
+
+    stats->total += cycles;
+}
+
+static void BENCH_print(const char* name, const char* kind, const BENCH_statsType* stats){
+
+    uint8 line[BENCH_LINE_SIZE];
+
+    FORMAT_print(line, sizeof(line), "%s,%s,%lu,%lu,%lu,%lu\r\n", name, kind, (uint32)BENCH_ITERATIONS,
+                 stats->min, stats->total / BENCH_ITERATIONS, stats->max);
+    UART0_SendString(line);
+}
+
+/* The conversion UART0_SendInteger used before the formatting module, one 64-bit division and modulo per digit */
+static uint8 BENCH_legacyFormat(uint8* buffer, sint64 number){
+
+    uint8 digits[20];
+    sint8 counter = 0;
+    uint8 length = 0;
+
+    if(number < 0){
+
+        buffer[length++] = '-';
+        number *= -1;
+    }
+
+    do{
+
+        digits[counter++] = number % 10 + '0';
+        number /= 10;
+
+    }while(number != 0);
+
+    for(counter--; counter >= 0; counter--){
+
+        buffer[length++] = digits[counter];
+    }
+
+    buffer[length] = '\0';
+
+    return length;
+}
+
+static void BENCH_measureOverhead(void){
+
+    uint32 i;
+    uint32 t0;
+    uint32 cycles;
+
+    g_overhead = 0xFFFFFFFFul;
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        cycles = TIMEBASE_DWT_CYCCNT - t0;
+
+        if(cycles < g_overhead){
+
+            g_overhead = cycles;
+        }
+    }
+}
+
+static void BENCH_uncontended(void){
+
+    BENCH_statsType first, second;
+    uint32 i;
+    uint32 t0, t1, t2;
+    inputMessage_Type input = {INPUT_CURRENT_TEMPERATURE, 0};
+    STATUS_seatType status;
+#if (configUSE_QUEUE_SETS == 1)
+    BENCH_statsType third;
+    uint32 t3;
+#endif
+
+    /* Send and receive of one tagged input (the path of the DataProcessing tasks) */
+    BENCH_reset(&first);
+    BENCH_reset(&second);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xQueueSend(g_queue, &input, 0);
+        t1 = TIMEBASE_DWT_CYCCNT;
+        xQueueReceive(g_queue, &input, 0);
+        t2 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+        BENCH_add(&second, t2 - t1);
+    }
+
+    BENCH_print("input_send", "uncontended", &first);
+    BENCH_print("input_receive", "uncontended", &second);
+
+#if (configUSE_QUEUE_SETS == 1)
+    /* Send into a queue of a set, select from the set then receive (the former path of the DataProcessing tasks) */
+    BENCH_reset(&first);
+    BENCH_reset(&second);
+    BENCH_reset(&third);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xQueueSend(g_setMember, &input.value, 0);
+        t1 = TIMEBASE_DWT_CYCCNT;
+        xQueueSelectFromSet(g_set, 0);
+        t2 = TIMEBASE_DWT_CYCCNT;
+        xQueueReceive(g_setMember, &input.value, 0);
+        t3 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+        BENCH_add(&second, t2 - t1);
+        BENCH_add(&third, t3 - t2);
+    }
+
+    BENCH_print("queue_set_send", "uncontended", &first);
+    BENCH_print("queue_set_select", "uncontended", &second);
+    BENCH_print("queue_set_receive", "uncontended", &third);
+#endif
+
+    /* Event group set and wait with the bit already set */
+    BENCH_reset(&first);
+    BENCH_reset(&second);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xEventGroupSetBits(g_group, 1);
+        t1 = TIMEBASE_DWT_CYCCNT;
+        xEventGroupWaitBits(g_group, 1, pdTRUE, pdFALSE, 0);
+        t2 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+        BENCH_add(&second, t2 - t1);
+    }
+
+    BENCH_print("event_group_set", "uncontended", &first);
+    BENCH_print("event_group_wait", "uncontended", &second);
+
+    /* Event group set from ISR only posts the set to the timer task, the yield lets the timer task do it before the next call */
+    BENCH_reset(&first);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xEventGroupSetBitsFromISR(g_group, 1, NULL);
+        t1 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+
+        taskYIELD();
+        xEventGroupClearBits(g_group, 1);
+    }
+
+    BENCH_print("event_group_set_from_isr", "uncontended", &first);
+
+    /* Mutex take and give */
+    BENCH_reset(&first);
+    BENCH_reset(&second);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xSemaphoreTake(g_mutex, 0);
+        t1 = TIMEBASE_DWT_CYCCNT;
+        xSemaphoreGive(g_mutex);
+        t2 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+        BENCH_add(&second, t2 - t1);
+    }
+
+    BENCH_print("mutex_take", "uncontended", &first);
+    BENCH_print("mutex_give", "uncontended", &second);
+
+    /* Task notification as the lightest reference */
+    BENCH_reset(&first);
+    BENCH_reset(&second);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+        t1 = TIMEBASE_DWT_CYCCNT;
+        ulTaskNotifyTake(pdTRUE, 0);
+        t2 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+        BENCH_add(&second, t2 - t1);
+    }
+
+    BENCH_print("notify_give", "uncontended", &first);
+    BENCH_print("notify_take", "uncontended", &second);
+
+    /* Snapshot of the status table of a seat, the alternative to a mutex take, copy and give */
+    BENCH_reset(&first);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        STATUS_read(DRIVER, &status);
+        t1 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&first, t1 - t0);
+    }
+
+    BENCH_print("status_read", "uncontended", &first);
+}
+
+static void BENCH_formatting(void){
+
+    BENCH_statsType legacy, format;
+    uint32 i;
+    uint8 value;
+    uint32 t0, t1, t2;
+
+    for(value = 0; value < BENCH_FORMAT_VALUES_NUM; value++){
+
+        BENCH_reset(&legacy);
+        BENCH_reset(&format);
+
+        for(i = 0; i < BENCH_ITERATIONS; i++){
+
+            t0 = TIMEBASE_DWT_CYCCNT;
+            BENCH_legacyFormat(g_formatText, g_formatValues[value]);
+            t1 = TIMEBASE_DWT_CYCCNT;
+            FORMAT_sint64(g_formatText, g_formatValues[value]);
+            t2 = TIMEBASE_DWT_CYCCNT;
+
+            BENCH_add(&legacy, t1 - t0);
+            BENCH_add(&format, t2 - t1);
+        }
+
+        BENCH_print(g_formatNames[value][0], "format", &legacy);
+        BENCH_print(g_formatNames[value][1], "format", &format);
+    }
+
+    /* A Q8 temperature with one decimal and a line of the printf subset */
+    BENCH_reset(&legacy);
+    BENCH_reset(&format);
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        t0 = TIMEBASE_DWT_CYCCNT;
+        FORMAT_fixed(g_formatText, 0x1780, 8, 1);
+        t1 = TIMEBASE_DWT_CYCCNT;
+        FORMAT_print(g_formatText, sizeof(g_formatText), "T=%d C %lu%%", 35, (uint32)42);
+        t2 = TIMEBASE_DWT_CYCCNT;
+
+        BENCH_add(&legacy, t1 - t0);
+        BENCH_add(&format, t2 - t1);
+    }
+
+    BENCH_print("format_fixed_q8", "format", &legacy);
+    BENCH_print("format_print", "format", &format);
+}
+
+/* Cycles the calling task ran since the start, the running time so far included */
+static uint64 BENCH_ownCycles(uint32 tag){
+
+    uint64 cycles;
+
+    taskENTER_CRITICAL();
+    cycles = ullTasksTotalTime[tag] + (TIMEBASE_getCycles() - ullTasksInTime[tag]);
+    taskEXIT_CRITICAL();
+
+    return cycles;
+}
+
+/* Every delay against its requested time, the busy time is the benchmark task running (busy-wait) and the blocked time
+ * is the rest of the call (the other tasks ran meanwhile)
+ */
+static void BENCH_delays(void){
+
+    BENCH_delayStatsType stats;
+    const BENCH_delayType* delay;
+    uint32 tag = (uint32)xTaskGetApplicationTaskTag(NULL);
+    uint64 requested;
+    uint64 own0, own1;
+    uint64 t0, t1;
+    uint8 line[BENCH_LINE_SIZE];
+    uint8 d;
+    uint32 i;
+
+    UART0_SendString("name,kind,iterations,requested_cycles,min_cycles,avg_cycles,max_cycles,busy_cycles,blocked_cycles\r\n");
+
+    for(d = 0; d < BENCH_DELAYS_NUM; d++){
+
+        delay = &g_delays[d];
+        requested = (delay->isMs == TRUE) ? ((uint64)delay->time * 1000u * TIMEBASE_CYCLES_PER_US) : TIMEBASE_usToCycles(delay->time);
+
+        BENCH_reset(&stats.measured);
+        stats.busy = 0;
+        stats.blocked = 0;
+
+        for(i = 0; i < BENCH_DELAY_ITERATIONS; i++){
+
+            own0 = BENCH_ownCycles(tag);
+            t0 = TIMEBASE_getCycles();
+
+            if(delay->isMs == TRUE){
+
+                _delay_ms(delay->time);
+            }
+            else{
+
+                _delay_us(delay->time);
+            }
+
+            t1 = TIMEBASE_getCycles();
+            own1 = BENCH_ownCycles(tag);
+
+            BENCH_add(&stats.measured, (uint32)(t1 - t0));
+            stats.busy += ((own1 - own0) < (t1 - t0)) ? (own1 - own0) : (t1 - t0);
+            stats.blocked += ((own1 - own0) < (t1 - t0)) ? ((t1 - t0) - (own1 - own0)) : 0;
+        }
+
+        FORMAT_print(line, sizeof(line), "%s,delay,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n", delay->name, (uint32)BENCH_DELAY_ITERATIONS,
+                     (uint32)requested, stats.measured.min, stats.measured.total / BENCH_DELAY_ITERATIONS, stats.measured.max,
+                     (uint32)(stats.busy / BENCH_DELAY_ITERATIONS), (uint32)(stats.blocked / BENCH_DELAY_ITERATIONS));
+        UART0_SendString(line);
+    }
+}
+
+/* Wake the helper blocked on the object of the handoff, it preempts the benchmark at once */
+static void BENCH_trigger(BENCH_handoffType handoff){
+
+    inputMessage_Type input = {INPUT_CURRENT_TEMPERATURE, 0};
+
+    switch(handoff){
+
+    case BENCH_HANDOFF_INPUT:
+        xQueueSend(g_queue, &input, 0);
+        break;
+
+#if (configUSE_QUEUE_SETS == 1)
+    case BENCH_HANDOFF_QUEUE_SET:
+        xQueueSend(g_setMember, &input.value, 0);
+        break;
+#endif
+
+    case BENCH_HANDOFF_EVENT_GROUP:
+        xEventGroupSetBits(g_group, 1);
+        break;
+
+    case BENCH_HANDOFF_NOTIFY:
+        xTaskNotifyGive(g_helper);
+        break;
+
+    case BENCH_HANDOFF_MUTEX:
+        xSemaphoreGive(g_mutex);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void BENCH_helperTask(void* pvParameters){
+
+    inputMessage_Type input;
+
+    while(1){
+
+        switch(g_handoff){
+
+        case BENCH_HANDOFF_INPUT:
+            xQueueReceive(g_queue, &input, portMAX_DELAY);
+            break;
+
+#if (configUSE_QUEUE_SETS == 1)
+        case BENCH_HANDOFF_QUEUE_SET:
+            xQueueSelectFromSet(g_set, portMAX_DELAY);
+            xQueueReceive(g_setMember, &input.value, 0);
+            break;
+#endif
+
+        case BENCH_HANDOFF_EVENT_GROUP:
+            xEventGroupWaitBits(g_group, 1, pdTRUE, pdFALSE, portMAX_DELAY);
+            break;
+
+        case BENCH_HANDOFF_NOTIFY:
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            break;
+
+        case BENCH_HANDOFF_MUTEX:
+            /* Armed by the benchmark while it holds the mutex, so the take blocks till the benchmark gives it */
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            xSemaphoreTake(g_mutex, portMAX_DELAY);
+            g_wakeCycles = TIMEBASE_DWT_CYCCNT;
+            xSemaphoreGive(g_mutex);
+            continue;
+
+        default:
+            break;
+        }
+
+        g_wakeCycles = TIMEBASE_DWT_CYCCNT;
+    }
+}
+
+static void BENCH_handoffs(void){
+
+    BENCH_statsType stats;
+    BENCH_handoffType handoff;
+    uint32 i;
+    uint32 t0;
+
+    for(handoff = BENCH_HANDOFF_INPUT; handoff < BENCH_HANDOFFS_NUM; handoff++){
+
+        BENCH_reset(&stats);
+
+        for(i = 0; i < BENCH_ITERATIONS; i++){
+
+            if(handoff == BENCH_HANDOFF_MUTEX){
+
+                /* The helper blocks on the mutex and the benchmark inherits its priority */
+                xSemaphoreTake(g_mutex, 0);
+                xTaskNotifyGive(g_helper);
+            }
+
+            t0 = TIMEBASE_DWT_CYCCNT;
+            BENCH_trigger(handoff);
+            BENCH_add(&stats, g_wakeCycles - t0);
+        }
+
+        BENCH_print(g_handoffNames[handoff], "handoff", &stats);
+
+        /* Move the helper to the next object, it reads the new handoff once it's woken from the current one */
+        if(handoff < BENCH_HANDOFF_MUTEX){
+
+            g_handoff = (BENCH_handoffType)(handoff + 1);
+            BENCH_trigger(handoff);
+        }
+    }
+}
+
+static void BENCH_deleteObjects(void){
+
+    if(g_helper != NULL){
+
+        vTaskDelete(g_helper);
+        g_helper = NULL;
+    }
+
+#if (configUSE_QUEUE_SETS == 1)
+    if((g_set != NULL) && (g_setMember != NULL)){
+
+        xQueueRemoveFromSet(g_setMember, g_set);
+    }
+
+    if(g_set != NULL){
+
+        vQueueDelete(g_set);
+        g_set = NULL;
+    }
+
+    if(g_setMember != NULL){
+
+        vQueueDelete(g_setMember);
+        g_setMember = NULL;
+    }
+#endif
+
+    if(g_queue != NULL){
+
+        vQueueDelete(g_queue);
+        g_queue = NULL;
+    }
+
+    if(g_group != NULL){
+
+        vEventGroupDelete(g_group);
+        g_group = NULL;
+    }
+
+    if(g_mutex != NULL){
+
+        vSemaphoreDelete(g_mutex);
+        g_mutex = NULL;
+    }
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+boolean BENCH_run(void){
+
+    UBaseType_t priority = uxTaskPriorityGet(NULL);
+    boolean isCreated;
+
+    /* A failed allocation resets the system (malloc failed hook) so the heap is checked before anything is created,
+     * the benchmark is the only code allocating after the start and it frees everything, so the free heap is one block
+     */
+    if(xPortGetFreeHeapSize() < BENCH_requiredHeap()){
+
+        return FALSE;
+    }
+
+    g_queue = xQueueCreate(1, sizeof(inputMessage_Type));
+    g_group = xEventGroupCreate();
+    g_mutex = xSemaphoreCreateMutex();
+
+    isCreated = (boolean)((g_queue != NULL) && (g_group != NULL) && (g_mutex != NULL));
+
+#if (configUSE_QUEUE_SETS == 1)
+    g_setMember = xQueueCreate(1, sizeof(uint8));
+    g_set = xQueueCreateSet(1);
+
+    isCreated = (boolean)(isCreated && (g_setMember != NULL) && (g_set != NULL) && (xQueueAddToSet(g_setMember, g_set) == pdPASS));
+#endif
+
+    if(isCreated == FALSE){
+
+        BENCH_deleteObjects();
+        return FALSE;
+    }
+
+    vTaskPrioritySet(NULL, BENCH_PRIORITY);
+
+    UART0_SendString("# cpu_hz=");
+    UART0_SendInteger(SYSCTL_SYSTEM_CLOCK_HZ);
+    UART0_SendString("\r\nname,kind,iterations,min_cycles,avg_cycles,max_cycles\r\n");
+
+    BENCH_measureOverhead();
+    BENCH_uncontended();
+    BENCH_formatting();
+
+    /* The helper blocks on the first handoff object once it's created as it has the higher priority */
+    g_handoff = BENCH_HANDOFF_INPUT;
+
+    if(xTaskCreate(BENCH_helperTask, "Benchmark helper", configMINIMAL_STACK_SIZE, NULL, BENCH_HELPER_PRIORITY, &g_helper) == pdPASS){
+
+        BENCH_handoffs();
+    }
+
+    BENCH_deleteObjects();
+
+    /* Last, as its rows have their own columns */
+    BENCH_delays();
+
+    vTaskPrioritySet(NULL, priority);
+
+    return TRUE;
+}
@@ -0,0 +1,87 @@
+/**********************************************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Benchmark.h
+ *
+ * Description: Header file of the micro benchmarks of the FreeRTOS primitives used by the application
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_BENCHMARK_H_
+#define APP_BENCHMARK_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/*
+ * NOTE:
+ *
+ * Every benchmark uses its own queue, queue set, event group and mutex (never the application ones)
+ * and measures every operation alone by the DWT cycle counter, the cost of reading the counter is subtracted.
+ *
+ * The input rows use a queue of inputMessage_Type like the input queues of the DataProcessing tasks,
+ * the queue set rows (the former input path of the DataProcessing tasks) are measured only when configUSE_QUEUE_SETS is 1,
+ * as enabling the queue sets also adds their bookkeeping to every queue send.
+ *
+ *  uncontended : the call never blocks and no task is waiting on the object (status_read reads the application status table).
+ *  handoff     : a higher priority helper task is blocked on the object, the time is from the call in the benchmark
+ *                till the helper runs (the call, the context switch and the return of the helper from its blocking call).
+ *  format      : the conversion of UART0_SendInteger before the formatting module (legacy) against FORMAT_sint64
+ *                for short and long values, then FORMAT_fixed and FORMAT_print, into a buffer without the UART.
+ *  delay       : _delay_us and _delay_ms (delay.h) against the requested time, the busy cycles are the benchmark task
+ *                running (busy-wait) and the blocked cycles are the rest of the call, in which the other tasks ran.
+ *
+ * The results are printed as CSV, one line per operation :
+ *
+ *  name,kind,iterations,min_cycles,avg_cycles,max_cycles
+ *
+ * then the delays under their own header (averages per call) :
+ *
+ *  name,kind,iterations,requested_cycles,min_cycles,avg_cycles,max_cycles,busy_cycles,blocked_cycles
+ *
+ * The interrupts aren't disabled so the maximum includes any interrupt that happened during the operation.
+ *
+ *  */
+
+#define BENCH_ITERATIONS            100u
+
+/* The delay rows wait for real, so they have fewer iterations */
+#define BENCH_DELAY_ITERATIONS      10u
+#define BENCH_DELAYS_NUM            6u
+
+/* Formatted values of the format rows and the longest CSV line */
+#define BENCH_FORMAT_VALUES_NUM     3u
+#define BENCH_LINE_SIZE             96u
+
+/* With 5 priorities nothing fits between the application tasks : the benchmark shares priority 3 with the DataProcessing
+ * tasks and runs below the runtime measurements and supervisor tasks (4), the helper must preempt the benchmark so it
+ * shares priority 4 with them and the timer task. Any row can include a preemption or a time slice of those tasks,
+ * the min column is the clean cost.
+ * The console holds UART_mutex for the whole run and the rows are printed by polling the UART at this priority, so every task
+ * logging meanwhile blocks on the mutex and the lower priority tasks don't run. Their check-ins are only safe because the
+ * run is short (under 40 rows and 80 ms of delays, about 0.2 s at 115200 baud) against SUPERVISOR_CHECK_IN_MARGIN, more rows or iterations
+ * must give the UART back between rows like the history dump does.
+ */
+#define BENCH_PRIORITY              (configMAX_PRIORITIES - 2)
+#define BENCH_HELPER_PRIORITY       (configMAX_PRIORITIES - 1)
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Run all benchmarks and print their results on UART0 (the caller must own the UART),
+ * returns FALSE without creating anything if the free heap is below what the benchmark objects and its helper task need */
+boolean BENCH_run(void);
+
+
+#endif /* APP_BENCHMARK_H_ */
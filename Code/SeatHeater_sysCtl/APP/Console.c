@@ -0,0 +1,966 @@
+/**********************************************************************************************************
+ *
+ * Module: Console
+ *
+ * File Name: Console.c
+ *
+ * Description: Source file of the UART0 command console used to control and query the system at runtime
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Console.h"
+#include"NVM.h"
+#include"Supervisor.h"
+#include"Trace.h"
+#include"Plant.h"
+#include"Benchmark.h"
+#include"Crash.h"
+#include"Jobs.h"
+#include"Periodic.h"
+#include"Schedulability.h"
+#include"Contention.h"
+#include"QueueStats.h"
+#include"Status.h"
+#include"History.h"
+#include"Telemetry.h"
+
+#include<string.h>
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    const char* name;
+
+    /* Minimum number of words in the line including the command itself */
+    uint8 minArgs;
+
+    void (*handler)(uint8 argc, uint8* argv[]);
+
+}CONSOLE_commandType;
+
+/****************************************************************************
+ *                         Private functions prototype
+ * ************************************************************************/
+
+static void CONSOLE_cmdHelp(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdSet(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdStats(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdMem(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdLog(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdFaults(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdCal(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdHang(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdTrace(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdPlay(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdPlant(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdCtl(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdBench(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdCrash(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdJobs(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdPeriodic(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdSched(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdMutex(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdQueues(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdStatus(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdHistory(uint8 argc, uint8* argv[]);
+static void CONSOLE_cmdTelemetry(uint8 argc, uint8* argv[]);
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* To add a new command just add its name and handler here */
+static const CONSOLE_commandType CONSOLE_commands[] = {
+
+    {"help",  1, CONSOLE_cmdHelp},
+    {"set",   3, CONSOLE_cmdSet},
+    {"stats", 1, CONSOLE_cmdStats},
+    {"mem",   1, CONSOLE_cmdMem},
+    {"log",   2, CONSOLE_cmdLog},
+    {"faults",1, CONSOLE_cmdFaults},
+    {"cal",   5, CONSOLE_cmdCal},
+    {"hang",  1, CONSOLE_cmdHang},
+    {"trace", 2, CONSOLE_cmdTrace},
+    {"play",  5, CONSOLE_cmdPlay},
+    {"plant", 2, CONSOLE_cmdPlant},
+    {"ctl",   1, CONSOLE_cmdCtl},
+    {"bench", 1, CONSOLE_cmdBench},
+    {"crash", 1, CONSOLE_cmdCrash},
+    {"jobs",  1, CONSOLE_cmdJobs},
+    {"periodic", 1, CONSOLE_cmdPeriodic},
+    {"sched", 1, CONSOLE_cmdSched},
+    {"mutex", 1, CONSOLE_cmdMutex},
+    {"queues", 1, CONSOLE_cmdQueues},
+    {"status", 1, CONSOLE_cmdStatus},
+    {"history", 1, CONSOLE_cmdHistory},
+    {"telemetry", 1, CONSOLE_cmdTelemetry}
+};
+
+#define CONSOLE_COMMANDS_NUM    (sizeof(CONSOLE_commands)/sizeof(CONSOLE_commands[0]))
+
+/* Handle of every application task indexed by (task tag - 1) */
+static TaskHandle_t* const CONSOLE_tasks[RUNTIME_MEASUREMENTS_TASKS_NUM - 1] = {
+
+    &task0handle, &task1handle, &task2handle,  &task3handle,  &task4handle,  &task5handle,
+    &task6handle, &task7handle, &task8handle,  &task9handle,  &task10handle, &task11handle,
+    &task12handle, &task13handle, &task14handle
+};
+
+/* Names of the trace events as dumped and played (indexed by TRACE_eventIdType) */
+static const char* const CONSOLE_traceEvents[TRACE_EVENT_TYPES] = {"adc", "button", "heater"};
+
+/* Set by the hang command, the console task then stops checking in with the supervisor */
+static boolean g_isHangInjected = FALSE;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Send the value rounded to one decimal digit */
+static void CONSOLE_sendTenths(float32 value){
+
+    uint8 text[FORMAT_NUMBER_SIZE];
+
+    FORMAT_decimal(text, (sint32)((value * 10.0f) + ((value < 0.0f) ? -0.5f : 0.5f)), 1);
+    UART0_SendString(text);
+}
+
+/* Convert a decimal string into number, returns FALSE if it's not a valid number or it doesn't fit in 32 bits */
+static boolean CONSOLE_parseNumber(const uint8* str, uint32* value){
+
+    uint32 digit;
+
+    *value = 0;
+
+    if(*str == '\0'){
+
+        return FALSE;
+    }
+
+    for(; *str != '\0'; str++){
+
+        if((*str < '0') || (*str > '9')){
+
+            return FALSE;
+        }
+
+        digit = (uint32)(*str - '0');
+
+        /* A number above the uint32 range would wrap into a valid looking value */
+        if(*value > ((0xFFFFFFFFu - digit) / 10u)){
+
+            return FALSE;
+        }
+
+        *value = (*value * 10) + digit;
+    }
+
+    return TRUE;
+}
+
+/* Split the line in place into words separated by spaces, returns number of words */
+static uint8 CONSOLE_split(uint8* line, uint8* argv[]){
+
+    uint8 argc = 0;
+
+    while(*line != '\0'){
+
+        /* Skip spaces */
+        while(*line == ' '){
+
+            *line++ = '\0';
+        }
+
+        if((*line == '\0') || (argc == CONSOLE_MAX_ARGS)){
+
+            break;
+        }
+
+        argv[argc++] = line;
+
+        while((*line != ' ') && (*line != '\0')){
+
+            line++;
+        }
+    }
+
+    return argc;
+}
+
+/* Print the tag and name of the task, tasks deleted after finishing their job have NULL handle */
+static void CONSOLE_sendTaskName(uint8 tag){
+
+    UART0_SendInteger(tag);
+    UART0_SendString(" ");
+
+    if(*CONSOLE_tasks[tag - 1] == NULL){
+
+        UART0_SendString("(deleted)");
+    }
+    else{
+
+        UART0_SendString((const uint8*)pcTaskGetName(*CONSOLE_tasks[tag - 1]));
+    }
+
+    UART0_SendString(" : ");
+}
+
+static void CONSOLE_execute(uint8* line){
+
+    uint8* argv[CONSOLE_MAX_ARGS];
+    uint8 argc;
+    uint8 i;
+
+    argc = CONSOLE_split(line, argv);
+
+    if(argc == 0){
+
+        return;
+    }
+
+    for(i=0; i<CONSOLE_COMMANDS_NUM; i++){
+
+        if(strcmp((const char*)argv[0], CONSOLE_commands[i].name) == 0){
+
+            if(argc < CONSOLE_commands[i].minArgs){
+
+                UART0_SendString("ERR missing arguments\r\n");
+            }
+            else{
+
+                CONSOLE_commands[i].handler(argc, argv);
+            }
+
+            return;
+        }
+    }
+
+    UART0_SendString("ERR unknown command, type help\r\n");
+}
+
+static void CONSOLE_cmdHelp(uint8 argc, uint8* argv[]){
+
+    UART0_SendString("help | set <driver|passenger> <0-3> | stats | mem | log <0-2> | faults\r\n");
+    UART0_SendString("cal <driver|passenger> <min> <max> <mV> | hang\r\n");
+    UART0_SendString("trace <record|replay|stop|dump> | play <ms> <adc|button|heater> <id> <value>\r\n");
+    UART0_SendString("plant <start <ambient> <scale> [noise]|stop|report> | ctl [<high> <medium> <low> <change>]\r\n");
+    UART0_SendString("bench | crash | jobs | periodic | sched [reset] | mutex [reset] | queues [reset] | status\r\n");
+    UART0_SendString("history [summary|dump|reset] | telemetry [on [ms]|off]\r\n");
+}
+
+/* Convert the seat name into its instance, returns FALSE and prints the error if it's unknown */
+static boolean CONSOLE_parseSeat(const uint8* str, uint8* instance){
+
+    if(strcmp((const char*)str, "driver") == 0){
+
+        *instance = DRIVER;
+    }
+    else if(strcmp((const char*)str, "passenger") == 0){
+
+        *instance = PASSENGER;
+    }
+    else{
+
+        UART0_SendString("ERR unknown seat\r\n");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void CONSOLE_cmdSet(uint8 argc, uint8* argv[]){
+
+    uint32 level;
+    heatingMode_Type desiredLevel;
+    uint8 instance;
+
+    if(CONSOLE_parseSeat(argv[1], &instance) == FALSE){
+
+        return;
+    }
+
+    if((CONSOLE_parseNumber(argv[2], &level) == FALSE) || (level > HEATER_HIGH)){
+
+        UART0_SendString("ERR level must be 0 to 3\r\n");
+        return;
+    }
+
+    desiredLevel = (heatingMode_Type)level;
+
+    /* Never wait on a full queue, the control tasks must not be delayed by the console */
+    if(APP_sendInput(instance, INPUT_DESIRED_LEVEL, desiredLevel, 0) == pdPASS){
+
+        g_desiredLevel[instance] = desiredLevel;
+        NVM_saveSetpoints();
+        UART0_SendString("OK\r\n");
+    }
+    else{
+
+        UART0_SendString("ERR busy, try again\r\n");
+    }
+}
+
+static void CONSOLE_cmdStats(uint8 argc, uint8* argv[]){
+
+    uint8 tag;
+    uint64 totalTime = 0;
+    uint64 elapsedTime = TIMEBASE_getCycles();
+
+    for(tag = 1; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+        totalTime += ullTasksTotalTime[tag];
+
+        CONSOLE_sendTaskName(tag);
+        UART0_SendInteger(TIMEBASE_cyclesToUs(ullTasksTotalTime[tag]));
+        UART0_SendString(" us\r\n");
+    }
+
+    UART0_SendString("CPU Load is ");
+    UART0_SendInteger((totalTime * 100) / elapsedTime);
+    UART0_SendString("% \r\n");
+}
+
+static void CONSOLE_cmdMem(uint8 argc, uint8* argv[]){
+
+    uint8 tag;
+
+    for(tag = 1; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+        CONSOLE_sendTaskName(tag);
+
+        /* Tasks deleted after finishing their job (initial values task) have no stack any more */
+        if(*CONSOLE_tasks[tag - 1] == NULL){
+
+            UART0_SendString("deleted\r\n");
+        }
+        else{
+
+            UART0_SendInteger(uxTaskGetStackHighWaterMark(*CONSOLE_tasks[tag - 1]));
+            UART0_SendString(" words free\r\n");
+        }
+    }
+
+    UART0_SendString("Heap free : ");
+    UART0_SendInteger(xPortGetFreeHeapSize());
+    UART0_SendString(" bytes, minimum ever : ");
+    UART0_SendInteger(xPortGetMinimumEverFreeHeapSize());
+    UART0_SendString(" bytes\r\n");
+}
+
+static void CONSOLE_cmdLog(uint8 argc, uint8* argv[]){
+
+    uint32 level;
+
+    if((CONSOLE_parseNumber(argv[1], &level) == FALSE) || (level > LOG_VERBOSE)){
+
+        UART0_SendString("ERR log level must be 0 to 2\r\n");
+        return;
+    }
+
+    g_logLevel = (logLevel_Type)level;
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdFaults(uint8 argc, uint8* argv[]){
+
+    static const char* const zoneNames[TEMPERATURE_ZONES] = {"Driver", "Passenger"};
+    static const char* const faultNames[TEMPSENSOR_FAULT_TYPES] = {"none", "rail", "range", "rate", "stuck"};
+    uint8 zone;
+    uint8 fault;
+    uint8 i;
+    NVM_faultLogType log;
+    const NVM_faultLogEntryType* entry;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        UART0_SendString((const uint8*)zoneNames[zone]);
+        UART0_SendString((TEMPSENSOR_isFaulty(zone) == TRUE) ? " : FAULTY (" : " : OK (last ");
+        UART0_SendString((const uint8*)faultNames[TEMPSENSOR_getLastFault(zone)]);
+        UART0_SendString(")");
+
+        for(fault = TEMPSENSOR_FAULT_RAIL; fault < TEMPSENSOR_FAULT_TYPES; fault++){
+
+            UART0_SendString(" ");
+            UART0_SendString((const uint8*)faultNames[fault]);
+            UART0_SendString("=");
+            UART0_SendInteger(TEMPSENSOR_getFaultCounter(zone, (TEMPSENSOR_faultType)fault));
+        }
+
+        UART0_SendString("\r\n");
+    }
+
+    /* Fault log kept in the NVM across resets, newest first */
+    NVM_getFaultLog(&log);
+
+    UART0_SendString("Fault log : ");
+    UART0_SendInteger(log.totalFaults);
+    UART0_SendString(" faults\r\n");
+
+    for(i = 0; (i < NVM_FAULT_LOG_ENTRIES) && (i < log.totalFaults); i++){
+
+        entry = &log.entries[(log.totalFaults - 1 - i) % NVM_FAULT_LOG_ENTRIES];
+
+        UART0_SendString("  ");
+        UART0_SendString((const uint8*)zoneNames[entry->zone % TEMPERATURE_ZONES]);
+        UART0_SendString(" ");
+        UART0_SendString((const uint8*)faultNames[entry->fault % TEMPSENSOR_FAULT_TYPES]);
+        UART0_SendString(" after ");
+        UART0_SendInteger(entry->uptime);
+        UART0_SendString(" s\r\n");
+    }
+}
+
+static void CONSOLE_cmdCal(uint8 argc, uint8* argv[]){
+
+    uint8 instance;
+    uint32 minTemperature, maxTemperature, maxMilliVolt;
+    TEMPSENSOR_calibrationType calibration;
+    boolean isValid;
+
+    if(CONSOLE_parseSeat(argv[1], &instance) == FALSE){
+
+        return;
+    }
+
+    if((CONSOLE_parseNumber(argv[2], &minTemperature) == FALSE) || (minTemperature > 255) ||
+       (CONSOLE_parseNumber(argv[3], &maxTemperature) == FALSE) || (maxTemperature > 255) ||
+       (CONSOLE_parseNumber(argv[4], &maxMilliVolt) == FALSE) || (maxMilliVolt > 0xFFFF)){
+
+        UART0_SendString("ERR invalid number\r\n");
+        return;
+    }
+
+    calibration.minTemperature = (uint8)minTemperature;
+    calibration.maxTemperature = (uint8)maxTemperature;
+    calibration.maxMilliVolt = (uint16)maxMilliVolt;
+
+    /* No conversion of the sensor may run while its calibration is changed */
+    xSemaphoreTake(ADC_mutex,portMAX_DELAY);
+    isValid = TEMPSENSOR_setCalibration(instance, &calibration);
+    xSemaphoreGive(ADC_mutex);
+
+    if(isValid == TRUE){
+
+        NVM_saveCalibration();
+        UART0_SendString("OK\r\n");
+    }
+    else{
+
+        UART0_SendString("ERR min must be below max and mV from 1 to the ADC reference\r\n");
+    }
+}
+
+static void CONSOLE_cmdHang(uint8 argc, uint8* argv[]){
+
+    g_isHangInjected = TRUE;
+    UART0_SendString("OK the console stopped checking in\r\n");
+}
+
+static void CONSOLE_cmdTrace(uint8 argc, uint8* argv[]){
+
+    TRACE_eventType event;
+    uint8 i;
+
+    if(strcmp((const char*)argv[1], "record") == 0){
+
+        TRACE_setMode(TRACE_RECORD);
+    }
+    else if(strcmp((const char*)argv[1], "replay") == 0){
+
+        TRACE_setMode(TRACE_REPLAY);
+    }
+    else if(strcmp((const char*)argv[1], "stop") == 0){
+
+        TRACE_setMode(TRACE_OFF);
+    }
+    else if(strcmp((const char*)argv[1], "dump") == 0){
+
+        /* Every line can be played back as it is after "play " */
+        for(i = 0; TRACE_getEvent(i, &event) == TRUE; i++){
+
+            UART0_SendInteger(event.time);
+            UART0_SendString(" ");
+            UART0_SendString((const uint8*)CONSOLE_traceEvents[event.type]);
+            UART0_SendString(" ");
+            UART0_SendInteger(event.id);
+            UART0_SendString(" ");
+            UART0_SendInteger(event.value);
+            UART0_SendString("\r\n");
+        }
+    }
+    else{
+
+        UART0_SendString("ERR unknown trace command\r\n");
+        return;
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdPlay(uint8 argc, uint8* argv[]){
+
+    TRACE_eventType event;
+    uint32 time, id, value;
+
+    if((CONSOLE_parseNumber(argv[1], &time) == FALSE) ||
+       (CONSOLE_parseNumber(argv[3], &id) == FALSE) || (id > 255) ||
+       (CONSOLE_parseNumber(argv[4], &value) == FALSE) || (value > 0xFFFF)){
+
+        UART0_SendString("ERR invalid number\r\n");
+        return;
+    }
+
+    for(event.type = 0; event.type < TRACE_EVENT_TYPES; event.type++){
+
+        if(strcmp((const char*)argv[2], CONSOLE_traceEvents[event.type]) == 0){
+
+            break;
+        }
+    }
+
+    event.time = time;
+    event.id = (uint8)id;
+    event.value = (uint16)value;
+
+    /* The host sends the next event only after the reply, so a full queue just means try again later */
+    if(TRACE_play(&event) == TRUE){
+
+        UART0_SendString("OK\r\n");
+    }
+    else{
+
+        UART0_SendString("ERR not replaying, invalid event or queue full\r\n");
+    }
+}
+
+static void CONSOLE_cmdPlant(uint8 argc, uint8* argv[]){
+
+    static const char* const zoneNames[TEMPERATURE_ZONES] = {"Driver", "Passenger"};
+    PLANT_reportType report;
+    uint32 ambient, scale;
+    uint32 noise = PLANT_DEFAULT_NOISE;
+    uint8 zone;
+
+    if(strcmp((const char*)argv[1], "start") == 0){
+
+        if((argc < 4) || (CONSOLE_parseNumber(argv[2], &ambient) == FALSE) || (ambient > TEMPERATURE_MAX) ||
+           (CONSOLE_parseNumber(argv[3], &scale) == FALSE) ||
+           ((argc > 4) && ((CONSOLE_parseNumber(argv[4], &noise) == FALSE) || (noise < PLANT_MIN_NOISE) || (noise > PLANT_MAX_NOISE))) ||
+           (PLANT_start((uint8)ambient, scale, (uint8)noise) == FALSE)){
+
+            UART0_SendString("ERR plant start <ambient 0-45> <scale 1-1000> [noise 1-50]\r\n");
+            return;
+        }
+    }
+    else if(strcmp((const char*)argv[1], "stop") == 0){
+
+        PLANT_stop();
+    }
+    else if(strcmp((const char*)argv[1], "report") == 0){
+
+        for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+            if(PLANT_getReport(zone, &report) == FALSE){
+
+                UART0_SendString("ERR the simulation never started\r\n");
+                return;
+            }
+
+            UART0_SendString((const uint8*)zoneNames[zone]);
+            UART0_SendString(" : seat ");
+            CONSOLE_sendTenths(report.seatTemperature);
+            UART0_SendString(" C desired ");
+            UART0_SendInteger(report.desiredTemperature);
+            UART0_SendString(" C, ");
+
+            if(report.isSettled == TRUE){
+
+                UART0_SendString("settled after ");
+                UART0_SendInteger((sint64)report.settlingTime);
+                UART0_SendString(" s");
+            }
+            else{
+
+                UART0_SendString("not settled");
+            }
+
+            UART0_SendString(", overshoot ");
+            CONSOLE_sendTenths(report.overshoot);
+            UART0_SendString(" C, ");
+            UART0_SendInteger(report.switches);
+            UART0_SendString(" switches, ");
+            UART0_SendInteger((sint64)report.energy);
+            UART0_SendString(" J in ");
+            UART0_SendInteger((sint64)report.time);
+            UART0_SendString(" s\r\n");
+        }
+    }
+    else{
+
+        UART0_SendString("ERR unknown plant command\r\n");
+        return;
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdCtl(uint8 argc, uint8* argv[]){
+
+    controlConfig_Type control;
+    uint32 values[4];
+    uint8 i;
+
+    if(argc >= 5){
+
+        for(i = 0; i < 4; i++){
+
+            if((CONSOLE_parseNumber(argv[i + 1], &values[i]) == FALSE) || (values[i] > TEMPERATURE_MAX)){
+
+                UART0_SendString("ERR invalid number\r\n");
+                return;
+            }
+        }
+
+        control.highBand = (uint8)values[0];
+        control.mediumBand = (uint8)values[1];
+        control.lowBand = (uint8)values[2];
+        control.changeThreshold = (uint8)values[3];
+
+        if(APP_setControlConfigs(&control) == FALSE){
+
+            UART0_SendString("ERR bands must be high > medium > low and change at least 1\r\n");
+            return;
+        }
+    }
+    else if(argc != 1){
+
+        UART0_SendString("ERR ctl [<high> <medium> <low> <change>]\r\n");
+        return;
+    }
+
+    control = g_controlConfigs;
+
+    UART0_SendString("high ");
+    UART0_SendInteger(control.highBand);
+    UART0_SendString(" medium ");
+    UART0_SendInteger(control.mediumBand);
+    UART0_SendString(" low ");
+    UART0_SendInteger(control.lowBand);
+    UART0_SendString(" change ");
+    UART0_SendInteger(control.changeThreshold);
+    UART0_SendString("\r\nOK\r\n");
+}
+
+static void CONSOLE_cmdBench(uint8 argc, uint8* argv[]){
+
+    if(BENCH_run() == FALSE){
+
+        UART0_SendString("ERR not enough heap\r\n");
+        return;
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdCrash(uint8 argc, uint8* argv[]){
+
+    if(CRASH_dump() == FALSE){
+
+        UART0_SendString("No crash since power up\r\n");
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdJobs(uint8 argc, uint8* argv[]){
+
+    JOB_statsType stats;
+    uint8 i;
+
+    if(JOB_getJobsNum() == 0){
+
+        UART0_SendString("No jobs, APP_PERIODIC_JOBS is 0\r\n");
+    }
+
+    for(i = 0; i < JOB_getJobsNum(); i++){
+
+        JOB_getStats(i, &stats);
+
+        UART0_SendString((const uint8*)stats.name);
+        UART0_SendString(" : period ");
+        UART0_SendInteger(stats.periodMs);
+        UART0_SendString(" phase ");
+        UART0_SendInteger(stats.phaseMs);
+        UART0_SendString(" deadline ");
+        UART0_SendInteger(stats.deadlineMs);
+        UART0_SendString(" ms, runs ");
+        UART0_SendInteger(stats.runs);
+        UART0_SendString(" lateness ");
+        UART0_SendInteger((stats.runs != 0) ? stats.minLateness : 0);
+        UART0_SendString("-");
+        UART0_SendInteger(stats.maxLateness);
+        UART0_SendString(" us, max response ");
+        UART0_SendInteger(stats.maxResponse);
+        UART0_SendString(" us, misses ");
+        UART0_SendInteger(stats.misses);
+        UART0_SendString("\r\n");
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdPeriodic(uint8 argc, uint8* argv[]){
+
+    PERIODIC_statsType stats;
+    uint8 i;
+
+    for(i = 0; i < PERIODIC_getTasksNum(); i++){
+
+        PERIODIC_getStats(i, &stats);
+
+        UART0_SendString((const uint8*)stats.name);
+        UART0_SendString(" : period ");
+        UART0_SendInteger(stats.periodMs);
+        UART0_SendString(" deadline ");
+        UART0_SendInteger(stats.deadlineMs);
+        UART0_SendString(" ms, releases ");
+        UART0_SendInteger(stats.releases);
+        UART0_SendString(" max lateness ");
+        UART0_SendInteger(stats.maxLateness);
+        UART0_SendString(" us, max response ");
+        UART0_SendInteger(stats.maxResponse);
+        UART0_SendString(" us, misses ");
+        UART0_SendInteger(stats.misses);
+        UART0_SendString(" overruns ");
+        UART0_SendInteger(stats.overruns);
+        UART0_SendString("\r\n");
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdSched(uint8 argc, uint8* argv[]){
+
+    if(argc == 2){
+
+        if(strcmp((const char*)argv[1], "reset") != 0){
+
+            UART0_SendString("ERR sched [reset]\r\n");
+            return;
+        }
+
+        SCHED_reset();
+    }
+    else if(SCHED_report() == FALSE){
+
+        UART0_SendString("WARNING deadline missed or margin below ");
+        UART0_SendInteger(SCHED_MIN_MARGIN_PERCENT);
+        UART0_SendString("%\r\n");
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdMutex(uint8 argc, uint8* argv[]){
+
+    if(argc == 2){
+
+        if(strcmp((const char*)argv[1], "reset") != 0){
+
+            UART0_SendString("ERR mutex [reset]\r\n");
+            return;
+        }
+
+        CONTENTION_reset();
+    }
+    else{
+
+        CONTENTION_report();
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdQueues(uint8 argc, uint8* argv[]){
+
+    if(argc == 2){
+
+        if(strcmp((const char*)argv[1], "reset") != 0){
+
+            UART0_SendString("ERR queues [reset]\r\n");
+            return;
+        }
+
+        QSTATS_reset();
+    }
+    else{
+
+        QSTATS_report();
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdStatus(uint8 argc, uint8* argv[]){
+
+    static const char* const zoneNames[TEMPERATURE_ZONES] = {"Driver", "Passenger"};
+    static const char* const modeNames[] = {"OFF", "LOW", "MEDIUM", "HIGH", "SENSOR FAILURE"};
+    STATUS_seatType status;
+    uint8 zone;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        UART0_SendString((const uint8*)zoneNames[zone]);
+
+        if(STATUS_read(zone, &status) == FALSE){
+
+            UART0_SendString(" : no decision yet\r\n");
+            continue;
+        }
+
+        UART0_SendString(" : current ");
+        UART0_SendInteger(status.currentTemperature);
+        UART0_SendString(" C desired ");
+        UART0_SendInteger(status.desiredTemperature);
+        UART0_SendString(" C (level ");
+        UART0_SendInteger(status.desiredLevel);
+        UART0_SendString("), heater ");
+        UART0_SendString((const uint8*)modeNames[status.mode]);
+        UART0_SendString(" at tick ");
+        UART0_SendInteger(status.tick);
+        UART0_SendString(", publishes ");
+        UART0_SendInteger(STATUS_getPublishes(zone));
+        UART0_SendString("\r\n");
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdHistory(uint8 argc, uint8* argv[]){
+
+    if(argc == 1){
+
+        HISTORY_report();
+    }
+    else if(strcmp((const char*)argv[1], "summary") == 0){
+
+        HISTORY_summary();
+    }
+    else if(strcmp((const char*)argv[1], "dump") == 0){
+
+        /* The frames sent between two blocks would be taken for blocks */
+        if(TELEMETRY_isRunning() == TRUE){
+
+            UART0_SendString("ERR history dump needs telemetry off\r\n");
+            return;
+        }
+
+        HISTORY_dump();
+    }
+    else if(strcmp((const char*)argv[1], "reset") == 0){
+
+        HISTORY_reset();
+    }
+    else{
+
+        UART0_SendString("ERR history [summary|dump|reset]\r\n");
+        return;
+    }
+
+    UART0_SendString("OK\r\n");
+}
+
+static void CONSOLE_cmdTelemetry(uint8 argc, uint8* argv[]){
+
+    uint32 periodMs = TELEMETRY_DEFAULT_PERIOD;
+
+    if(argc >= 2){
+
+        if(strcmp((const char*)argv[1], "off") == 0){
+
+            TELEMETRY_stop();
+        }
+        else if((strcmp((const char*)argv[1], "on") != 0)
+                || ((argc == 3) && (CONSOLE_parseNumber(argv[2], &periodMs) == FALSE))
+                || (TELEMETRY_start(periodMs) == FALSE)){
+
+            UART0_SendString("ERR telemetry [on [20-10000 ms]|off]\r\n");
+            return;
+        }
+    }
+
+    TELEMETRY_report();
+    UART0_SendString("OK\r\n");
+}
+
+/****************************************************************************
+ *                               Tasks definition
+ * ************************************************************************/
+
+/* Assemble the received bytes from UART0 into lines and execute every line as a command */
+void vConsoleTask( void * pvParameters ){
+
+    uint8 line[CONSOLE_LINE_SIZE];
+    uint8 length = 0;
+    uint8 data;
+
+    /* Set when the line exceeds the line buffer, the whole line is then discarded */
+    boolean isOverflow = FALSE;
+
+    /* Enable the receive interrupt only now, so the interrupt never notifies a task that isn't created yet */
+    UART0_EnableRxInterrupt(UART0_RX_INTERRUPT_PRIORITY);
+
+    SUPERVISOR_register(SUPERVISOR_CONSOLE, TASK_CHECK_IN_PERIOD + SUPERVISOR_CHECK_IN_MARGIN);
+
+    while(1){
+
+        if(g_isHangInjected == FALSE){
+
+            SUPERVISOR_CHECK_IN(SUPERVISOR_CONSOLE);
+        }
+
+        /* Blocked until the receive interrupt receives a complete line or the check-in period passes */
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD));
+
+        while(UART0_ReadRxBuffer(&data) == TRUE){
+
+            if((data == '\r') || (data == '\n')){
+
+                if((isOverflow == TRUE) || (length != 0)){
+
+                    /* Acquire the UART resource as there is many tasks trying to access the same resource by time slicing.  */
+                    xSemaphoreTake(UART_mutex,portMAX_DELAY);
+
+                    if(isOverflow == TRUE){
+
+                        UART0_SendString("ERR line too long\r\n");
+                    }
+                    else{
+
+                        line[length] = '\0';
+                        CONSOLE_execute(line);
+                    }
+
+                    /* Release UART resource */
+                    xSemaphoreGive(UART_mutex);
+                }
+
+                length = 0;
+                isOverflow = FALSE;
+            }
+            else if(length < (CONSOLE_LINE_SIZE - 1)){
+
+                line[length++] = data;
+            }
+            else{
+
+                isOverflow = TRUE;
+            }
+        }
+    }
+}
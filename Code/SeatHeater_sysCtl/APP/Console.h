@@ -0,0 +1,76 @@
+/**********************************************************************************************************
+ *
+ * Module: Console
+ *
+ * File Name: Console.h
+ *
+ * Description: Header file of the UART0 command console used to control and query the system at runtime
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_CONSOLE_H_
+#define APP_CONSOLE_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Maximum length of one command line including the null terminator */
+#define CONSOLE_LINE_SIZE           32u
+
+/* Maximum number of words in one command line */
+#define CONSOLE_MAX_ARGS            5u
+
+/*
+ * Supported commands (every command ends with '\r' or '\n'):
+ *
+ *  help                          : List the commands
+ *  set <driver|passenger> <0-3>  : Set the desired level of the seat (0:OFF, 1:25, 2:30, 3:35 degree celsius)
+ *  stats                         : Dump the runtime of every task and the CPU load
+ *  mem                           : Dump the stack high water mark of every task and the heap watermarks
+ *  log <0-2>                     : Change the logging verbosity (0:quiet, 1:normal, 2:verbose)
+ *  faults                        : Dump the sensor fault state and the confirmed faults counters of every seat and the fault log
+ *  cal <driver|passenger> <min> <max> <mV> : Calibrate the seat sensor (temperature at 0 V, at the maximum voltage and the maximum voltage)
+ *  hang                          : Stop the console checking in with the supervisor to test the watchdog (the system resets)
+ *  trace <record|replay|stop|dump> : Record the inputs and heater changes, replay the played inputs or dump the recorded events
+ *  play <ms> <adc|button|heater> <id> <value> : Queue one dumped event to be replayed at its time (the heater events are ignored)
+ *  plant start <ambient> <scale> [noise] : Replace both sensors by the seats thermal model starting at the ambient temperature,
+ *                                  scale is simulated/real time and noise is the sensor noise in ADC counts (1 to 50, 1 by default)
+ *  plant <stop|report>           : Stop the simulation or report the settling time, overshoot, heater switches and energy of every seat
+ *  ctl [<high> <medium> <low> <change>] : Change the heater bands and the monitoring change threshold in degrees, then print them
+ *  bench                         : Measure the cost of the FreeRTOS primitives in cycles and print them as CSV (see Benchmark.h)
+ *  crash                         : Dump the last crash record again (it's dumped once at the boot after the crash)
+ *  jobs                          : Dump the period, phase, deadline, lateness range (jitter), worst response and deadline misses of every periodic job
+ *  periodic                      : Dump the period, deadline, releases, worst lateness and response, deadline misses and overruns of every periodic task
+ *  sched [reset]                 : Run the response time analysis on the declared periods and the measured execution and mutex hold times
+ *                                  and print the optimal priority order (see Schedulability.h), or clear the jobs measurements (mutex reset clears the hold times)
+ *  mutex [reset]                 : Dump the takes, contentions, timeouts, priority inheritances, wait and hold histograms of
+ *                                  ADC_mutex and UART_mutex and the longest blocking pairs (see Contention.h), or clear them
+ *  queues [reset]                : Dump the peak depth, unused bytes, time full, send and receive rates, failed sends, producers
+ *                                  block time and consumers wait time of every application queue (see QueueStats.h), or clear them
+ *  status                        : Dump the current and desired temperature and the heater mode of every seat from the status table
+ *  history [summary|dump|reset]  : Dump the recorded time, compression ratio and encode cycles of the temperature history,
+ *                                  its per minute minimum, maximum and mean temperatures as CSV, its binary dump (see History.h,
+ *                                  refused while the telemetry is on) or clear it
+ *  telemetry [on [ms]|off]       : Send a binary snapshot of both seats every period (100 ms by default) instead of the text logs
+ *                                  (see Telemetry.h), stop it, then print the frames, bytes and the reduction against the text lines
+ *
+ */
+
+/****************************************************************************
+ *                               Tasks prototype
+ * ************************************************************************/
+
+/* Assemble the received bytes from UART0 into lines and execute every line as a command */
+void vConsoleTask( void * pvParameters );
+
+
+#endif /* APP_CONSOLE_H_ */
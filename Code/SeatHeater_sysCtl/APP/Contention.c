@@ -0,0 +1,439 @@
+/**********************************************************************************************************
+ *
+ * Module: Contention
+ *
+ * File Name: Contention.c
+ *
+ * Description: Source file of the contention profiler of ADC_mutex and UART_mutex, it measures the wait
+ *              and hold times, the holders and waiters and the priority inheritances of every mutex
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Contention.h"
+
+#include<string.h>
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    uint32 takes;
+    uint32 contentions;         /* Takes that waited */
+    uint32 timeouts;
+    uint32 inheritances;
+    uint64 totalWait;           /* Cycles */
+    uint64 totalHold;           /* Cycles */
+    uint32 maxWait;             /* Cycles */
+    uint32 maxHold;             /* Cycles */
+    uint32 waitHistogram[CONTENTION_BUCKETS_NUM];
+    uint32 holdHistogram[CONTENTION_BUCKETS_NUM];
+
+}CONTENTION_mutexType;
+
+typedef struct{
+
+    uint8 mutex;
+    uint8 holder;               /* Tag */
+    uint8 waiter;               /* Tag */
+    uint32 waits;
+    uint64 totalWait;           /* Cycles */
+    uint32 maxWait;             /* Cycles */
+
+}CONTENTION_pairType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static CONTENTION_mutexType g_mutexes[CONTENTION_MUTEXES_NUM];
+static CONTENTION_pairType g_pairs[CONTENTION_PAIRS_NUM];
+static uint8 g_pairsNum = 0;
+static uint32 g_droppedWaits = 0;
+
+/* Holder (tag) and take time of every mutex, the holder is only valid while the mutex is taken */
+static uint8 g_holders[CONTENTION_MUTEXES_NUM];
+static uint64 g_takeTimes[CONTENTION_MUTEXES_NUM];
+static uint32 g_maxHolds[CONTENTION_MUTEXES_NUM][RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* Wait of every task (tag) : the mutex it waits on (-1 if none), its first block time and the holder at that time */
+static sint8 g_waitingOn[RUNTIME_MEASUREMENTS_TASKS_NUM] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+static uint64 g_waitStarts[RUNTIME_MEASUREMENTS_TASKS_NUM];
+static uint8 g_blockers[RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* Name of every tag, saved by the task itself on its first take or wait */
+static const char* g_names[RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* Upper limit of every histogram bucket except the last one */
+static const uint32 g_bucketLimits[CONTENTION_BUCKETS_NUM - 1] = {
+
+    10ul * TIMEBASE_CYCLES_PER_US,
+    100ul * TIMEBASE_CYCLES_PER_US,
+    1000ul * TIMEBASE_CYCLES_PER_US,
+    10000ul * TIMEBASE_CYCLES_PER_US,
+    100000ul * TIMEBASE_CYCLES_PER_US
+};
+
+static const char* const g_bucketNames[CONTENTION_BUCKETS_NUM] = {"<10us", "<100us", "<1ms", "<10ms", "<100ms", ">=100ms"};
+
+static const char* const g_mutexNames[CONTENTION_MUTEXES_NUM] = {"ADC_mutex", "UART_mutex"};
+
+/* Snapshots printed by CONTENTION_report, static so they aren't on the console stack */
+static CONTENTION_mutexType g_mutexesCopy[CONTENTION_MUTEXES_NUM];
+static CONTENTION_pairType g_pairsCopy[CONTENTION_PAIRS_NUM];
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static sint8 CONTENTION_mutexIndex(void* queue){
+
+    if(queue == NULL){
+
+        return -1;
+    }
+
+    if(queue == (void*)ADC_mutex){
+
+        return CONTENTION_ADC_MUTEX;
+    }
+
+    if(queue == (void*)UART_mutex){
+
+        return CONTENTION_UART_MUTEX;
+    }
+
+    return -1;
+}
+
+/* Tag of the calling task, the name of the tag is saved too */
+static uint8 CONTENTION_currentTag(void){
+
+    uint8 tag = (uint8)((uint32)xTaskGetApplicationTaskTag(NULL));
+
+    g_names[tag] = pcTaskGetName(NULL);
+
+    return tag;
+}
+
+static void CONTENTION_addToHistogram(uint32* histogram, uint32 cycles){
+
+    uint8 bucket = 0;
+
+    while((bucket < (CONTENTION_BUCKETS_NUM - 1)) && (cycles >= g_bucketLimits[bucket])){
+
+        bucket++;
+    }
+
+    histogram[bucket]++;
+}
+
+static void CONTENTION_addPair(uint8 mutex, uint8 holder, uint8 waiter, uint32 wait){
+
+    CONTENTION_pairType* pair = NULL;
+    uint8 i;
+
+    for(i = 0; i < g_pairsNum; i++){
+
+        if((g_pairs[i].mutex == mutex) && (g_pairs[i].holder == holder) && (g_pairs[i].waiter == waiter)){
+
+            pair = &g_pairs[i];
+            break;
+        }
+    }
+
+    if(pair == NULL){
+
+        if(g_pairsNum == CONTENTION_PAIRS_NUM){
+
+            g_droppedWaits++;
+            return;
+        }
+
+        pair = &g_pairs[g_pairsNum++];
+        pair->mutex = mutex;
+        pair->holder = holder;
+        pair->waiter = waiter;
+    }
+
+    pair->waits++;
+    pair->totalWait += wait;
+
+    if(wait > pair->maxWait){
+
+        pair->maxWait = wait;
+    }
+}
+
+static void CONTENTION_sendName(uint8 tag){
+
+    if((tag == 0) || (g_names[tag] == NULL)){
+
+        UART0_SendString("timer/idle");
+    }
+    else{
+
+        UART0_SendString((const uint8*)g_names[tag]);
+    }
+}
+
+static void CONTENTION_sendHistogram(const char* title, const uint32* histogram){
+
+    uint8 bucket;
+
+    UART0_SendString("  ");
+    UART0_SendString((const uint8*)title);
+
+    for(bucket = 0; bucket < CONTENTION_BUCKETS_NUM; bucket++){
+
+        UART0_SendString(" ");
+        UART0_SendString((const uint8*)g_bucketNames[bucket]);
+        UART0_SendString(":");
+        UART0_SendInteger(histogram[bucket]);
+    }
+
+    UART0_SendString("\r\n");
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void CONTENTION_taken(void* queue){
+
+    sint8 m = CONTENTION_mutexIndex(queue);
+    uint8 tag;
+    uint32 wait;
+
+    if(m < 0){
+
+        return;
+    }
+
+    tag = CONTENTION_currentTag();
+
+    g_holders[m] = tag;
+    g_takeTimes[m] = TIMEBASE_getCycles();
+    g_mutexes[m].takes++;
+
+    if(g_waitingOn[tag] == m){
+
+        wait = (uint32)(g_takeTimes[m] - g_waitStarts[tag]);
+
+        g_mutexes[m].contentions++;
+        g_mutexes[m].totalWait += wait;
+
+        if(wait > g_mutexes[m].maxWait){
+
+            g_mutexes[m].maxWait = wait;
+        }
+
+        CONTENTION_addToHistogram(g_mutexes[m].waitHistogram, wait);
+        CONTENTION_addPair((uint8)m, g_blockers[tag], tag, wait);
+
+        g_waitingOn[tag] = -1;
+    }
+}
+
+
+void CONTENTION_given(void* queue){
+
+    sint8 m = CONTENTION_mutexIndex(queue);
+    uint8 holder;
+    uint32 hold;
+
+    if(m < 0){
+
+        return;
+    }
+
+    holder = g_holders[m];
+    hold = (uint32)(TIMEBASE_getCycles() - g_takeTimes[m]);
+
+    g_mutexes[m].totalHold += hold;
+
+    if(hold > g_mutexes[m].maxHold){
+
+        g_mutexes[m].maxHold = hold;
+    }
+
+    if(hold > g_maxHolds[m][holder]){
+
+        g_maxHolds[m][holder] = hold;
+    }
+
+    CONTENTION_addToHistogram(g_mutexes[m].holdHistogram, hold);
+}
+
+
+void CONTENTION_waiting(void* queue){
+
+    sint8 m = CONTENTION_mutexIndex(queue);
+    uint8 tag;
+
+    if(m < 0){
+
+        return;
+    }
+
+    tag = CONTENTION_currentTag();
+
+    /* The wait loop of xSemaphoreTake blocks again if another task took the mutex first, the wait started at the first block */
+    if(g_waitingOn[tag] != m){
+
+        g_waitingOn[tag] = m;
+        g_waitStarts[tag] = TIMEBASE_getCycles();
+        g_blockers[tag] = g_holders[m];
+    }
+}
+
+
+void CONTENTION_timedOut(void* queue){
+
+    sint8 m = CONTENTION_mutexIndex(queue);
+    uint8 tag;
+
+    if(m < 0){
+
+        return;
+    }
+
+    tag = CONTENTION_currentTag();
+
+    g_mutexes[m].timeouts++;
+    g_waitingOn[tag] = -1;
+}
+
+
+void CONTENTION_priorityInherited(void){
+
+    /* The inheritance is done by the running task right after it blocks on the mutex */
+    sint8 m = g_waitingOn[(uint8)((uint32)xTaskGetApplicationTaskTag(NULL))];
+
+    if(m >= 0){
+
+        g_mutexes[m].inheritances++;
+    }
+}
+
+
+boolean CONTENTION_isWaiting(uint32 tag){
+
+    return (boolean)(g_waitingOn[tag] >= 0);
+}
+
+
+uint32 CONTENTION_getMaxHold(uint8 mutex, uint32 tag){
+
+    return g_maxHolds[mutex][tag];
+}
+
+
+void CONTENTION_reset(void){
+
+    uint8 m, tag;
+
+    taskENTER_CRITICAL();
+
+    for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+        memset(&g_mutexes[m], 0, sizeof(g_mutexes[m]));
+
+        for(tag = 0; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+            g_maxHolds[m][tag] = 0;
+        }
+    }
+
+    g_pairsNum = 0;
+    g_droppedWaits = 0;
+
+    taskEXIT_CRITICAL();
+}
+
+
+void CONTENTION_report(void){
+
+    CONTENTION_mutexType* mutex;
+    CONTENTION_pairType swap;
+    uint32 droppedWaits;
+    uint8 pairsNum, m, i, j;
+
+    taskENTER_CRITICAL();
+
+    memcpy(g_mutexesCopy, g_mutexes, sizeof(g_mutexes));
+    memcpy(g_pairsCopy, g_pairs, sizeof(g_pairs));
+    pairsNum = g_pairsNum;
+    droppedWaits = g_droppedWaits;
+
+    taskEXIT_CRITICAL();
+
+    for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+        mutex = &g_mutexesCopy[m];
+
+        UART0_SendString((const uint8*)g_mutexNames[m]);
+        UART0_SendString(" : takes ");
+        UART0_SendInteger(mutex->takes);
+        UART0_SendString(" contended ");
+        UART0_SendInteger(mutex->contentions);
+        UART0_SendString(" timeouts ");
+        UART0_SendInteger(mutex->timeouts);
+        UART0_SendString(" inheritances ");
+        UART0_SendInteger(mutex->inheritances);
+        UART0_SendString("\r\n  wait avg ");
+        UART0_SendInteger((mutex->contentions != 0) ? TIMEBASE_cyclesToUs(mutex->totalWait / mutex->contentions) : 0);
+        UART0_SendString(" max ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(mutex->maxWait));
+        UART0_SendString(" total ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(mutex->totalWait));
+        UART0_SendString(" us, hold avg ");
+        UART0_SendInteger((mutex->takes != 0) ? TIMEBASE_cyclesToUs(mutex->totalHold / mutex->takes) : 0);
+        UART0_SendString(" max ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(mutex->maxHold));
+        UART0_SendString(" us\r\n");
+
+        CONTENTION_sendHistogram("wait", mutex->waitHistogram);
+        CONTENTION_sendHistogram("hold", mutex->holdHistogram);
+    }
+
+    /* Sort the pairs by their total wait, longest first */
+    for(i = 1; i < pairsNum; i++){
+
+        for(j = i; (j > 0) && (g_pairsCopy[j].totalWait > g_pairsCopy[j - 1].totalWait); j--){
+
+            swap = g_pairsCopy[j];
+            g_pairsCopy[j] = g_pairsCopy[j - 1];
+            g_pairsCopy[j - 1] = swap;
+        }
+    }
+
+    UART0_SendString("Top blocking (waiter <- holder) :\r\n");
+
+    for(i = 0; (i < pairsNum) && (i < CONTENTION_TOP_NUM); i++){
+
+        UART0_SendString("  ");
+        CONTENTION_sendName(g_pairsCopy[i].waiter);
+        UART0_SendString(" <- ");
+        CONTENTION_sendName(g_pairsCopy[i].holder);
+        UART0_SendString(" on ");
+        UART0_SendString((const uint8*)g_mutexNames[g_pairsCopy[i].mutex]);
+        UART0_SendString(" : waits ");
+        UART0_SendInteger(g_pairsCopy[i].waits);
+        UART0_SendString(" total ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_pairsCopy[i].totalWait));
+        UART0_SendString(" max ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_pairsCopy[i].maxWait));
+        UART0_SendString(" us\r\n");
+    }
+
+    if(droppedWaits != 0){
+
+        UART0_SendString("  waits of untracked pairs ");
+        UART0_SendInteger(droppedWaits);
+        UART0_SendString("\r\n");
+    }
+}
@@ -0,0 +1,83 @@
+/**********************************************************************************************************
+ *
+ * Module: Contention
+ *
+ * File Name: Contention.h
+ *
+ * Description: Header file of the contention profiler of ADC_mutex and UART_mutex, it measures the wait
+ *              and hold times, the holders and waiters and the priority inheritances of every mutex
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_CONTENTION_H_
+#define APP_CONTENTION_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Profiled mutexes */
+#define CONTENTION_ADC_MUTEX        0u
+#define CONTENTION_UART_MUTEX       1u
+#define CONTENTION_MUTEXES_NUM      2u
+
+/* Decades of the wait and hold times histograms : <10 us, <100 us, <1 ms, <10 ms, <100 ms and >=100 ms */
+#define CONTENTION_BUCKETS_NUM      6u
+
+/* Waiter and holder pairs kept for the blocking report, the waits of any further pair are only counted as dropped */
+#define CONTENTION_PAIRS_NUM        12u
+
+/* Pairs printed by the blocking report */
+#define CONTENTION_TOP_NUM          5u
+
+/*
+ * NOTE:
+ *
+ * The queue trace hooks (FreeRTOSConfig.h) feed the profiler, so every xSemaphoreTake and xSemaphoreGive of
+ * the two mutexes is profiled without changing the callers, the hooks of the other queues only compare two pointers.
+ *
+ *  wait time   : from the first block of a task on the mutex till it takes it (a take without blocking isn't a wait).
+ *  hold time   : from the take till the give, including the preemption of the holder.
+ *  blocker     : the holder when the waiter blocked, if another waiter takes the mutex first the whole wait
+ *                is still charged to that holder.
+ *  inheritance : a waiter raised the priority of the holder.
+ *
+ * The profiler is always enabled, a take or a give costs one 64 bits cycle counter read and a few stores,
+ * a contended take also searches the pairs table.
+ *
+ *  */
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Called by the queue and priority trace hooks (FreeRTOSConfig.h), they must stay short */
+void CONTENTION_taken(void* queue);
+void CONTENTION_given(void* queue);
+void CONTENTION_waiting(void* queue);
+void CONTENTION_timedOut(void* queue);
+void CONTENTION_priorityInherited(void);
+
+/* TRUE while the task of the tag waits on a profiled mutex, so its job isn't over (Schedulability) */
+boolean CONTENTION_isWaiting(uint32 tag);
+
+/* Longest hold of the mutex by the task of the tag in cycles */
+uint32 CONTENTION_getMaxHold(uint8 mutex, uint32 tag);
+
+/* Clear all measurements */
+void CONTENTION_reset(void);
+
+/* Print the statistics and histograms of every mutex and the waiter and holder pairs with the longest total wait
+ * on UART0 (the caller must own the UART) */
+void CONTENTION_report(void);
+
+
+#endif /* APP_CONTENTION_H_ */
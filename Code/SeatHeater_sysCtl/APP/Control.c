@@ -0,0 +1,98 @@
+/**********************************************************************************************************
+ *
+ * Module: Control
+ *
+ * File Name: Control.c
+ *
+ * Description: Source file of the heating control law, the heater mode decision of the DataProcessing tasks and the
+ *              change test of the monitoring tasks, without any RTOS or hardware access so the host tools run it too
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Control.h"
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+boolean CONTROL_isValid(const controlConfig_Type* control){
+
+    return (boolean)((control->highBand > control->mediumBand) && (control->mediumBand > control->lowBand)
+                     && (control->changeThreshold != 0));
+}
+
+
+desiredTemp_Type CONTROL_desiredTemperature(heatingMode_Type desiredLevel){
+
+    /* Put the actual temperature in the desired level variable not just a state */
+    switch(desiredLevel){
+
+    case HEATER_LOW:
+
+        /* 25 degree celsius */
+        return LEVEL1;
+
+    case HEATER_MEDIUM:
+
+        /* 30 degree celsius */
+        return LEVEL2;
+
+    case HEATER_HIGH:
+
+        /* 35 degree celsius */
+        return LEVEL3;
+
+    case HEATER_OFF:
+    default:
+
+        /* Off */
+        return LEVEL0;
+    }
+}
+
+
+heatingMode_Type CONTROL_decide(const controlConfig_Type* control, desiredTemp_Type desiredTemperature,
+                                uint8 currentTemperature, boolean isSensorFaulty){
+
+    sint32 difference = (sint32)desiredTemperature - (sint32)currentTemperature;
+
+    /* If the fault detection confirmed a fault in the temperature sensor (out of range, rail, noise or stuck reading)
+     * then turn off heater and turn on red LED
+     */
+    if(isSensorFaulty == TRUE){
+
+        return TEMPERATURE_SENSOR_FAILURE;
+    }
+
+    /* If difference between desired temperature and current temperature is the high band (10) or greater then turn on heater on high intensity */
+    if(difference >= control->highBand){
+
+        return HEATER_HIGH;
+    }
+
+    /* If difference between desired temperature and current temperature is the medium band (5) or greater then turn on heater on medium intensity */
+    if(difference >= control->mediumBand){
+
+        return HEATER_MEDIUM;
+    }
+
+    /* If difference between desired temperature and current temperature is the low band (2) or greater then turn on heater on low intensity */
+    if(difference >= control->lowBand){
+
+        return HEATER_LOW;
+    }
+
+    /* If difference between desired temperature and current temperature less than the low band then turn off heater */
+    return HEATER_OFF;
+}
+
+
+boolean CONTROL_isChanged(const controlConfig_Type* control, uint8 currentTemperature, uint8 previousTemperature){
+
+    uint8 change = (currentTemperature > previousTemperature) ? (currentTemperature - previousTemperature)
+                                                              : (previousTemperature - currentTemperature);
+
+    return (boolean)(change >= control->changeThreshold);
+}
@@ -0,0 +1,94 @@
+/**********************************************************************************************************
+ *
+ * Module: Control
+ *
+ * File Name: Control.h
+ *
+ * Description: Header file of the heating control law, the heater mode decision of the DataProcessing tasks and the
+ *              change test of the monitoring tasks, without any RTOS or hardware access so the host tools run it too
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_CONTROL_H_
+#define APP_CONTROL_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"MCAL/std_types.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Default control parameters (g_controlConfigs), they can be changed at runtime by the console */
+
+/* Minimum change in degrees that is sent to the DataProcessing task */
+#define TEMPERATURE_CHANGE_THRESHOLD            2u
+
+/* Difference between the desired and current temperature from which the heater is on HIGH, MEDIUM and LOW intensity */
+#define HEATER_HIGH_BAND                        10u
+#define HEATER_MEDIUM_BAND                      5u
+#define HEATER_LOW_BAND                         2u
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef enum{
+
+    HEATER_OFF,
+    HEATER_LOW,
+    HEATER_MEDIUM,
+    HEATER_HIGH,
+    TEMPERATURE_SENSOR_FAILURE
+
+}heatingMode_Type;
+
+typedef enum{
+
+    LEVEL0=HEATER_OFF,
+    LEVEL1=25,
+    LEVEL2=30,
+    LEVEL3=35
+
+}desiredTemp_Type;
+
+typedef struct{
+
+    /* Difference between the desired and current temperature from which the heater is on HIGH, MEDIUM and LOW intensity,
+     * below the low band the heater is off
+     */
+    uint8 highBand;
+    uint8 mediumBand;
+    uint8 lowBand;
+
+    /* Minimum change in degrees that is sent to the DataProcessing task (hysteresis of the monitoring) */
+    uint8 changeThreshold;
+
+}controlConfig_Type;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* TRUE if the bands are decreasing (high > medium > low) and the change threshold isn't 0 */
+boolean CONTROL_isValid(const controlConfig_Type* control);
+
+/* Desired temperature of the desired level, LEVEL0 (off) for HEATER_OFF or an unknown level */
+desiredTemp_Type CONTROL_desiredTemperature(heatingMode_Type desiredLevel);
+
+/* Heater mode of the seat, TEMPERATURE_SENSOR_FAILURE if its sensor is faulty, otherwise by the band in which the
+ * difference between the desired and the current temperature is
+ */
+heatingMode_Type CONTROL_decide(const controlConfig_Type* control, desiredTemp_Type desiredTemperature,
+                                uint8 currentTemperature, boolean isSensorFaulty);
+
+/* TRUE if the temperature moved by the change threshold or more from the last temperature sent to the DataProcessing task */
+boolean CONTROL_isChanged(const controlConfig_Type* control, uint8 currentTemperature, uint8 previousTemperature);
+
+
+#endif /* APP_CONTROL_H_ */
@@ -0,0 +1,306 @@
+/**********************************************************************************************************
+ *
+ * Module: Crash
+ *
+ * File Name: Crash.c
+ *
+ * Description: Source file of the crash capture, the state of the system at a fault is kept in no-init RAM
+ *              across the reset and dumped on UART0 at the next boot
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Crash.h"
+
+#include<string.h>
+#include<stddef.h>
+
+/***************************************************************************
+ *                              Mapped registers
+ *************************************************************************** */
+
+/* System control block of the Cortex-M4 */
+#define CRASH_ICSR              (*((volatile uint32*)0xE000ED04))
+#define CRASH_AIRCR             (*((volatile uint32*)0xE000ED0C))
+#define CRASH_CFSR              (*((volatile uint32*)0xE000ED28))
+#define CRASH_HFSR              (*((volatile uint32*)0xE000ED2C))
+#define CRASH_MMFAR             (*((volatile uint32*)0xE000ED34))
+#define CRASH_BFAR              (*((volatile uint32*)0xE000ED38))
+
+#define CRASH_ICSR_VECTACTIVE_MASK      0x1FFul
+#define CRASH_AIRCR_VECTKEY             (0x05FAul << 16)
+#define CRASH_AIRCR_SYSRESETREQ         (1ul << 2)
+
+/* The stacked frame is copied only if it's fully inside the SRAM, a corrupted stack pointer must not fault again */
+#define CRASH_SRAM_START        0x20000000ul
+#define CRASH_SRAM_END          0x20008000ul
+#define CRASH_FRAME_WORDS       8u
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* Not initialized by the C start-up code so it keeps the capture across the reset */
+#pragma DATA_SECTION(g_crashRecord, ".noinit")
+static CRASH_recordType g_crashRecord;
+
+/* Ring of the last task switches, written on every switch */
+static CRASH_switchType g_switches[CRASH_SWITCHES_SIZE];
+static uint8 g_switchIndex = 0;
+
+/* TRUE if the record was captured just before this boot */
+static boolean g_isResetByCrash = FALSE;
+
+static const char* const g_causeNames[CRASH_CAUSES_NUM] = {"fault", "stack_overflow", "malloc_failed", "watchdog"};
+
+static const char* const g_queueNames[CRASH_QUEUES_NUM] = {
+
+    "input_driver", "mode_driver", "input_passenger", "mode_passenger"
+};
+
+/* Names of the configurable fault status bits (usage fault in the upper half, bus fault then memory manage fault in the lower half) */
+static const char* const g_cfsrNames[32] = {
+
+    "IACCVIOL", "DACCVIOL", NULL, "MUNSTKERR", "MSTKERR", "MLSPERR", NULL, "MMARVALID",
+    "IBUSERR", "PRECISERR", "IMPRECISERR", "UNSTKERR", "STKERR", "LSPERR", NULL, "BFARVALID",
+    "UNDEFINSTR", "INVSTATE", "INVPC", "NOCP", NULL, NULL, NULL, NULL,
+    "UNALIGNED", "DIVBYZERO", NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static uint32 CRASH_checksum(const CRASH_recordType* record){
+
+    const uint8* pData = (const uint8*)record;
+    uint32 sum = 0;
+    uint32 i;
+
+    /* Rotate then add, so swapped or shifted bytes change the result too */
+    for(i = 0; i < offsetof(CRASH_recordType, checksum); i++){
+
+        sum = ((sum << 5) | (sum >> 27)) + pData[i];
+    }
+
+    return sum;
+}
+
+static boolean CRASH_isValid(void){
+
+    return (boolean)((g_crashRecord.magic == CRASH_MAGIC) && (g_crashRecord.cause < CRASH_CAUSES_NUM)
+                     && (g_crashRecord.checksum == CRASH_checksum(&g_crashRecord)));
+}
+
+static void CRASH_sendHex(uint32 value){
+
+    uint8 text[FORMAT_NUMBER_SIZE];
+
+    FORMAT_print(text, sizeof(text), "0x%08lX", value);
+    UART0_SendString(text);
+}
+
+static void CRASH_sendField(const char* name, uint32 value){
+
+    UART0_SendString(" ");
+    UART0_SendString((const uint8*)name);
+    UART0_SendString("=");
+    CRASH_sendHex(value);
+}
+
+static void CRASH_saveQueue(const QueueHandle_t queue, uint8 index){
+
+    g_crashRecord.queues[index] = (queue != NULL) ? (uint8)uxQueueMessagesWaitingFromISR(queue) : 0;
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void CRASH_init(void){
+
+    if((CRASH_isValid() == TRUE) && (g_crashRecord.isReported != TRUE)){
+
+        CRASH_dump();
+        g_crashRecord.isReported = TRUE;
+        g_isResetByCrash = TRUE;
+    }
+    else if(CRASH_isValid() == FALSE){
+
+        /* Random content after power up */
+        g_crashRecord.magic = 0;
+    }
+}
+
+
+void CRASH_recordSwitch(uint32 tag){
+
+    g_switches[g_switchIndex].cycles = TIMEBASE_DWT_CYCCNT;
+    g_switches[g_switchIndex].tag = tag;
+    g_switchIndex = (g_switchIndex + 1u) % CRASH_SWITCHES_SIZE;
+}
+
+
+void CRASH_capture(CRASH_causeType cause, const uint32* frame, uint32 excReturn){
+
+    uint8 i;
+
+    taskDISABLE_INTERRUPTS();
+
+    /* The heaters first in case anything below faults again */
+    vHeatersSafeState();
+
+    memset(&g_crashRecord, 0, sizeof(g_crashRecord));
+
+    g_crashRecord.cause = cause;
+    g_crashRecord.vector = CRASH_ICSR & CRASH_ICSR_VECTACTIVE_MASK;
+    g_crashRecord.excReturn = excReturn;
+
+    if(((uint32)frame >= CRASH_SRAM_START) && ((uint32)frame <= (CRASH_SRAM_END - (CRASH_FRAME_WORDS * sizeof(uint32))))){
+
+        for(i = 0; i < CRASH_FRAME_WORDS; i++){
+
+            g_crashRecord.frame[i] = frame[i];
+        }
+    }
+
+    g_crashRecord.cfsr = CRASH_CFSR;
+    g_crashRecord.hfsr = CRASH_HFSR;
+    g_crashRecord.mmfar = CRASH_MMFAR;
+    g_crashRecord.bfar = CRASH_BFAR;
+
+    g_crashRecord.freeHeap = xPortGetFreeHeapSize();
+
+    /* The tick is read directly as the FromISR version asserts on the watchdog interrupt priority (above the kernel) */
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED){
+
+        g_crashRecord.tick = xTaskGetTickCount();
+        strncpy(g_crashRecord.taskName, pcTaskGetName(xTaskGetCurrentTaskHandle()), configMAX_TASK_NAME_LEN - 1);
+    }
+
+    CRASH_saveQueue(Q_inputDriver, 0);
+    CRASH_saveQueue(Q_heatingModeDriver, 1);
+    CRASH_saveQueue(Q_inputPassenger, 2);
+    CRASH_saveQueue(Q_heatingModePassenger, 3);
+
+    /* The oldest switch is the next one to be overwritten in the ring */
+    for(i = 0; i < CRASH_SWITCHES_SIZE; i++){
+
+        g_crashRecord.switches[i] = g_switches[(g_switchIndex + i) % CRASH_SWITCHES_SIZE];
+    }
+
+    g_crashRecord.magic = CRASH_MAGIC;
+    g_crashRecord.checksum = CRASH_checksum(&g_crashRecord);
+    g_crashRecord.isReported = FALSE;
+
+    /* Reset at once, the record is complete in RAM before the request */
+    __asm("    dsb");
+    CRASH_AIRCR = CRASH_AIRCR_VECTKEY | CRASH_AIRCR_SYSRESETREQ;
+    __asm("    dsb");
+
+    while(1){}
+}
+
+
+boolean CRASH_getResetCause(CRASH_causeType* cause){
+
+    if(g_isResetByCrash == FALSE){
+
+        return FALSE;
+    }
+
+    *cause = (CRASH_causeType)g_crashRecord.cause;
+
+    return TRUE;
+}
+
+
+const char* CRASH_causeName(CRASH_causeType cause){
+
+    return (cause < CRASH_CAUSES_NUM) ? g_causeNames[cause] : "unknown";
+}
+
+
+void CRASH_faultHandler(uint32* frame, uint32 excReturn){
+
+    CRASH_capture(CRASH_CAUSE_FAULT, frame, excReturn);
+}
+
+
+boolean CRASH_dump(void){
+
+    static const char* const registerNames[CRASH_FRAME_WORDS] = {"r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr"};
+    uint8 i;
+
+    if(CRASH_isValid() == FALSE){
+
+        return FALSE;
+    }
+
+    UART0_SendString("CRASH cause=");
+    UART0_SendString((const uint8*)g_causeNames[g_crashRecord.cause]);
+    UART0_SendString(" task=");
+    UART0_SendString((const uint8*)((g_crashRecord.taskName[0] != '\0') ? g_crashRecord.taskName : "none"));
+    UART0_SendString(" tick=");
+    UART0_SendInteger(g_crashRecord.tick);
+    UART0_SendString(" free_heap=");
+    UART0_SendInteger(g_crashRecord.freeHeap);
+    UART0_SendString("\r\n");
+
+    UART0_SendString("CRASH");
+
+    for(i = 0; i < CRASH_FRAME_WORDS; i++){
+
+        CRASH_sendField(registerNames[i], g_crashRecord.frame[i]);
+    }
+
+    CRASH_sendField("exc_return", g_crashRecord.excReturn);
+    CRASH_sendField("vector", g_crashRecord.vector);
+    UART0_SendString("\r\n");
+
+    UART0_SendString("CRASH");
+    CRASH_sendField("cfsr", g_crashRecord.cfsr);
+    CRASH_sendField("hfsr", g_crashRecord.hfsr);
+    CRASH_sendField("mmfar", g_crashRecord.mmfar);
+    CRASH_sendField("bfar", g_crashRecord.bfar);
+
+    /* Decode the fault status so no host tool is needed */
+    for(i = 0; i < 32u; i++){
+
+        if((g_crashRecord.cfsr & (1ul << i)) && (g_cfsrNames[i] != NULL)){
+
+            UART0_SendString(" ");
+            UART0_SendString((const uint8*)g_cfsrNames[i]);
+        }
+    }
+
+    if(g_crashRecord.hfsr & (1ul << 30)){
+
+        UART0_SendString(" FORCED");
+    }
+
+    UART0_SendString("\r\nCRASH queues");
+
+    for(i = 0; i < CRASH_QUEUES_NUM; i++){
+
+        UART0_SendString(" ");
+        UART0_SendString((const uint8*)g_queueNames[i]);
+        UART0_SendString("=");
+        UART0_SendInteger(g_crashRecord.queues[i]);
+    }
+
+    UART0_SendString("\r\nCRASH switches (tag@cycles, oldest first)");
+
+    for(i = 0; i < CRASH_SWITCHES_SIZE; i++){
+
+        UART0_SendString(" ");
+        UART0_SendInteger(g_crashRecord.switches[i].tag);
+        UART0_SendString("@");
+        UART0_SendInteger(g_crashRecord.switches[i].cycles);
+    }
+
+    UART0_SendString("\r\n");
+
+    return TRUE;
+}
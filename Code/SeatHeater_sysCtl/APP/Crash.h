@@ -0,0 +1,132 @@
+/**********************************************************************************************************
+ *
+ * Module: Crash
+ *
+ * File Name: Crash.h
+ *
+ * Description: Header file of the crash capture, the state of the system at a fault is kept in no-init RAM
+ *              across the reset and dumped on UART0 at the next boot
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_CRASH_H_
+#define APP_CRASH_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Marks a captured record, with the checksum it tells a record from the random RAM content after power up */
+#define CRASH_MAGIC                 0xC0DEDEADul
+
+/* Number of the last task switches kept in the record */
+#define CRASH_SWITCHES_SIZE         16u
+
+/* Number of the application queues whose waiting messages are kept in the record */
+#define CRASH_QUEUES_NUM            4u
+
+/*
+ * NOTE:
+ *
+ * The record is in the .noinit section (see tm4c123gh6pm.cmd) so it's not cleared by the C start-up code,
+ * it survives the reset that follows the capture but not a power cycle (the checksum fails then).
+ *
+ * A capture drives both heaters to the safe state first, saves the record then resets the system at once
+ * through the system reset request, without waiting for the watchdog.
+ *
+ * The task switches are recorded in a ring in normal RAM on every switch and copied to the record at the capture,
+ * so the boot and the scheduler after the reset don't overwrite them before they are dumped.
+ *
+ *  */
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef enum{
+
+    CRASH_CAUSE_FAULT,              /* Hard fault or an unexpected interrupt, the stacked frame and the fault registers are valid */
+    CRASH_CAUSE_STACK_OVERFLOW,
+    CRASH_CAUSE_MALLOC_FAILED,
+    CRASH_CAUSE_WATCHDOG,           /* The supervisor stopped feeding the watchdog */
+    CRASH_CAUSES_NUM
+
+}CRASH_causeType;
+
+typedef struct{
+
+    uint32 cycles;      /* Low word of the timebase at the switch */
+    uint32 tag;         /* Task tag of the task switched in */
+
+}CRASH_switchType;
+
+typedef struct{
+
+    uint32 magic;
+    uint32 cause;               /* CRASH_causeType */
+
+    /* Frame stacked by the exception entry : r0, r1, r2, r3, r12, lr, pc, xpsr (all 0 if it's not a fault) */
+    uint32 frame[8];
+    uint32 excReturn;
+    uint32 vector;              /* Active exception number */
+
+    /* Configurable fault status, hard fault status, memory manage and bus fault addresses */
+    uint32 cfsr;
+    uint32 hfsr;
+    uint32 mmfar;
+    uint32 bfar;
+
+    uint32 tick;                /* RTOS tick count at the capture */
+    uint32 freeHeap;
+    char taskName[configMAX_TASK_NAME_LEN];
+
+    /* Waiting messages of the input and heating mode queues of the driver then the passenger */
+    uint8 queues[CRASH_QUEUES_NUM];
+
+    /* Last task switches, the oldest first */
+    CRASH_switchType switches[CRASH_SWITCHES_SIZE];
+
+    /* Of all the previous bytes */
+    uint32 checksum;
+
+    uint32 isReported;          /* TRUE once dumped */
+
+}CRASH_recordType;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Dump the record over UART0 if there is a new one from before the reset, it's called before the scheduler starts */
+void CRASH_init(void);
+
+/* Save the task switched in, it's called by the task switch trace hook */
+void CRASH_recordSwitch(uint32 tag);
+
+/* Drive the heaters to the safe state, save the record then reset the system, it never returns.
+ * frame is the stacked exception frame or NULL when it's not a fault
+ */
+void CRASH_capture(CRASH_causeType cause, const uint32* frame, uint32 excReturn);
+
+/* Cause of the capture that reset the system just before this boot, returns FALSE if the last reset wasn't a capture */
+boolean CRASH_getResetCause(CRASH_causeType* cause);
+
+/* Name of the cause as printed in the dump */
+const char* CRASH_causeName(CRASH_causeType cause);
+
+/* Called by the fault handlers shim in the start-up file with the stack pointer of the stacked frame and EXC_RETURN */
+void CRASH_faultHandler(uint32* frame, uint32 excReturn);
+
+/* Dump the last record even if it's already reported, returns FALSE if there is no valid record */
+boolean CRASH_dump(void);
+
+
+#endif /* APP_CRASH_H_ */
@@ -0,0 +1,702 @@
+/**********************************************************************************************************
+ *
+ * Module: History
+ *
+ * File Name: History.c
+ *
+ * Description: Source file of the temperature history, the temperature, desired level and heater mode of every
+ *              seat are sampled periodically into a delta compressed ring in RAM for the analysis after a drive
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"History.h"
+#include"Status.h"
+#include"Supervisor.h"
+#include"timers.h"
+
+#include<string.h>
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Record header kinds (bits 7 and 6) */
+#define HISTORY_RECORD_RUN          0x00u
+#define HISTORY_RECORD_SMALL        0x40u
+#define HISTORY_RECORD_FULL         0x80u
+#define HISTORY_RECORD_KIND_MASK    0xC0u
+
+/* Temperature changes of the small record (3-bit zigzag) */
+#define HISTORY_SMALL_MIN           (-4)
+#define HISTORY_SMALL_MAX           3
+
+/* Largest record : header, 2 varints of up to 2 bytes and 2 state bytes */
+#define HISTORY_RECORD_MAX_SIZE     7u
+
+#define HISTORY_PERIOD_TICKS        pdMS_TO_TICKS(HISTORY_SAMPLE_PERIOD)
+#define HISTORY_MINUTE_TICKS        pdMS_TO_TICKS(60000)
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    uint8 temperatures[TEMPERATURE_ZONES];
+    uint8 states[TEMPERATURE_ZONES];        /* (desired level << 4) | heater mode */
+
+}HISTORY_sampleType;
+
+/* Minimum, maximum and sum of the temperatures of one minute of the summary */
+typedef struct{
+
+    uint32 minute;
+    uint16 samples;
+    uint8 minimum[TEMPERATURE_ZONES];
+    uint8 maximum[TEMPERATURE_ZONES];
+    uint32 sum[TEMPERATURE_ZONES];
+
+}HISTORY_minuteType;
+
+typedef void (*HISTORY_sampleCallbackType)(const HISTORY_sampleType* sample, TickType_t tick);
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static TimerHandle_t g_sampleTimer = NULL;
+
+/* Block number n is in the slot n % HISTORY_BLOCKS_NUM, the last HISTORY_BLOCKS_NUM started blocks are kept */
+static uint8 g_blocks[HISTORY_BLOCKS_NUM][HISTORY_BLOCK_SIZE];
+static uint8 g_blockLengths[HISTORY_BLOCKS_NUM];
+static uint16 g_blockSamples[HISTORY_BLOCKS_NUM];
+static uint32 g_blocksStarted = 0;
+
+/* The last byte of the current block is kept for the pending run, once it's used the next sample starts a new block */
+static boolean g_isBlockFull = FALSE;
+
+/* Unchanged samples not written yet */
+static uint8 g_run = 0;
+
+static HISTORY_sampleType g_lastSample;
+
+static uint32 g_encodes = 0;
+static uint64 g_encodeCycles = 0;
+static uint32 g_encodeMaxCycles = 0;
+
+/* Used by the console task only (summary and dump) */
+static uint8 g_blockCopy[HISTORY_BLOCK_SIZE];
+static HISTORY_minuteType g_minute;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static uint32 HISTORY_zigzag(sint32 value){
+
+    return (value >= 0) ? ((uint32)value << 1) : ((((uint32)(-value)) << 1) - 1u);
+}
+
+static sint32 HISTORY_unzigzag(uint32 value){
+
+    return (value & 1u) ? -(sint32)((value + 1u) >> 1) : (sint32)(value >> 1);
+}
+
+static uint8 HISTORY_putVarint(uint8* buffer, uint32 value){
+
+    uint8 length = 0;
+
+    while(value >= 0x80u){
+
+        buffer[length++] = (uint8)(value | 0x80u);
+        value >>= 7;
+    }
+
+    buffer[length++] = (uint8)value;
+
+    return length;
+}
+
+/* Returns FALSE if the varint runs past the end of the block */
+static boolean HISTORY_getVarint(const uint8* block, uint8 length, uint8* index, uint32* value){
+
+    uint8 shift = 0;
+
+    *value = 0;
+
+    while((*index < length) && (shift < 32u)){
+
+        *value |= (uint32)(block[*index] & 0x7Fu) << shift;
+
+        if((block[(*index)++] & 0x80u) == 0){
+
+            return TRUE;
+        }
+
+        shift += 7u;
+    }
+
+    return FALSE;
+}
+
+static uint8* HISTORY_currentBlock(void){
+
+    return g_blocks[(g_blocksStarted - 1u) % HISTORY_BLOCKS_NUM];
+}
+
+static uint8* HISTORY_currentLength(void){
+
+    return &g_blockLengths[(g_blocksStarted - 1u) % HISTORY_BLOCKS_NUM];
+}
+
+/* Write the sample as the keyframe of a new block, the oldest block is dropped if the ring is full */
+static void HISTORY_startBlock(const HISTORY_sampleType* sample, TickType_t tick){
+
+    uint8 slot = (uint8)(g_blocksStarted % HISTORY_BLOCKS_NUM);
+    uint8* block = g_blocks[slot];
+    uint8 length;
+    uint8 zone;
+
+    length = HISTORY_putVarint(block, tick);
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        block[length++] = sample->temperatures[zone];
+        block[length++] = sample->states[zone];
+    }
+
+    g_blockLengths[slot] = length;
+    g_blockSamples[slot] = 1;
+    g_blocksStarted++;
+
+    g_isBlockFull = FALSE;
+    g_run = 0;
+}
+
+/* The pending run fits as the last byte of the block is kept for it, the block is closed once that byte is used */
+static void HISTORY_flushRun(void){
+
+    uint8* length = HISTORY_currentLength();
+
+    if(g_run != 0){
+
+        if(*length < HISTORY_BLOCK_SIZE){
+
+            HISTORY_currentBlock()[(*length)++] = (uint8)(HISTORY_RECORD_RUN | (g_run - 1u));
+        }
+        else{
+
+            /* Never expected, the run is dropped rather than written past the block */
+            g_blockSamples[(g_blocksStarted - 1u) % HISTORY_BLOCKS_NUM] -= g_run;
+        }
+
+        g_run = 0;
+
+        if(*length >= (HISTORY_BLOCK_SIZE - 1u)){
+
+            g_isBlockFull = TRUE;
+        }
+    }
+}
+
+/* Returns the length of the record of the changes since the last sample, 0 if nothing changed */
+static uint8 HISTORY_encode(const HISTORY_sampleType* sample, uint8* record){
+
+    sint32 deltas[TEMPERATURE_ZONES];
+    boolean isSmall = TRUE;
+    boolean isChanged = FALSE;
+    uint8 flags = 0;
+    uint8 length;
+    uint8 zone;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        deltas[zone] = (sint32)sample->temperatures[zone] - (sint32)g_lastSample.temperatures[zone];
+
+        if(sample->states[zone] != g_lastSample.states[zone]){
+
+            /* The driver is bit 1 and the passenger bit 0 */
+            flags |= (uint8)(1u << (TEMPERATURE_ZONES - 1u - zone));
+        }
+
+        if(deltas[zone] != 0){
+
+            isChanged = TRUE;
+        }
+
+        if((deltas[zone] < HISTORY_SMALL_MIN) || (deltas[zone] > HISTORY_SMALL_MAX)){
+
+            isSmall = FALSE;
+        }
+    }
+
+    if((flags == 0) && (isChanged == FALSE)){
+
+        return 0;
+    }
+
+    if((flags == 0) && (isSmall == TRUE)){
+
+        record[0] = (uint8)(HISTORY_RECORD_SMALL | (HISTORY_zigzag(deltas[DRIVER]) << 3) | HISTORY_zigzag(deltas[PASSENGER]));
+        return 1;
+    }
+
+    record[0] = (uint8)(HISTORY_RECORD_FULL | flags);
+    length = 1;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        length += HISTORY_putVarint(&record[length], HISTORY_zigzag(deltas[zone]));
+    }
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        if(flags & (1u << (TEMPERATURE_ZONES - 1u - zone))){
+
+            record[length++] = sample->states[zone];
+        }
+    }
+
+    return length;
+}
+
+/* Called inside a critical section */
+static void HISTORY_add(const HISTORY_sampleType* sample, TickType_t tick){
+
+    uint8 record[HISTORY_RECORD_MAX_SIZE];
+    uint8* length;
+    uint8 recordLength;
+
+    if((g_blocksStarted == 0) || (g_isBlockFull == TRUE)){
+
+        HISTORY_startBlock(sample, tick);
+    }
+    else{
+
+        length = HISTORY_currentLength();
+        recordLength = HISTORY_encode(sample, record);
+
+        if(recordLength == 0){
+
+            g_run++;
+            g_blockSamples[(g_blocksStarted - 1u) % HISTORY_BLOCKS_NUM]++;
+
+            if(g_run == HISTORY_MAX_RUN){
+
+                HISTORY_flushRun();
+            }
+        }
+        else if((*length + ((g_run != 0) ? 1u : 0u) + recordLength) > (HISTORY_BLOCK_SIZE - 1u)){
+
+            HISTORY_flushRun();
+            HISTORY_startBlock(sample, tick);
+        }
+        else{
+
+            HISTORY_flushRun();
+            memcpy(&HISTORY_currentBlock()[*length], record, recordLength);
+            *length += recordLength;
+            g_blockSamples[(g_blocksStarted - 1u) % HISTORY_BLOCKS_NUM]++;
+        }
+    }
+
+    g_lastSample = *sample;
+}
+
+static void HISTORY_sampleCallback(TimerHandle_t timer){
+
+    HISTORY_sampleType sample;
+    STATUS_seatType status;
+    uint32 cycles;
+    uint8 zone;
+
+    (void)timer;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        /* The ADC is never waited for on the timer task, the previous temperature is kept while it's in use */
+        if(APP_readTemperature(zone, &sample.temperatures[zone]) == FALSE){
+
+            sample.temperatures[zone] = g_lastSample.temperatures[zone];
+        }
+
+        sample.states[zone] = (STATUS_read(zone, &status) == TRUE) ? (uint8)((status.desiredLevel << 4) | status.mode) : 0;
+    }
+
+    taskENTER_CRITICAL();
+
+    cycles = TIMEBASE_DWT_CYCCNT;
+    HISTORY_add(&sample, xTaskGetTickCount());
+    cycles = TIMEBASE_DWT_CYCCNT - cycles;
+
+    g_encodes++;
+    g_encodeCycles += cycles;
+
+    if(cycles > g_encodeMaxCycles){
+
+        g_encodeMaxCycles = cycles;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+/* Write the pending run then return the first and the end block numbers kept in the ring */
+static void HISTORY_getBlocks(uint32* first, uint32* end){
+
+    taskENTER_CRITICAL();
+
+    if(g_blocksStarted != 0){
+
+        HISTORY_flushRun();
+    }
+
+    *end = g_blocksStarted;
+    *first = (g_blocksStarted > HISTORY_BLOCKS_NUM) ? (g_blocksStarted - HISTORY_BLOCKS_NUM) : 0;
+
+    taskEXIT_CRITICAL();
+}
+
+/* Copy the block into g_blockCopy and return its length, 0 if it's dropped since HISTORY_getBlocks */
+static uint8 HISTORY_copyBlock(uint32 number){
+
+    uint8 length = 0;
+    uint8 slot = (uint8)(number % HISTORY_BLOCKS_NUM);
+
+    taskENTER_CRITICAL();
+
+    if((number < g_blocksStarted) && ((number + HISTORY_BLOCKS_NUM) >= g_blocksStarted)){
+
+        length = g_blockLengths[slot];
+        memcpy(g_blockCopy, g_blocks[slot], length);
+    }
+
+    taskEXIT_CRITICAL();
+
+    return length;
+}
+
+/* Call the callback for every sample of the block in order, a corrupted record ends the block */
+static void HISTORY_decode(const uint8* block, uint8 length, HISTORY_sampleCallbackType callback){
+
+    HISTORY_sampleType sample;
+    uint32 value;
+    uint8 index = 0;
+    uint8 header;
+    uint8 count;
+    uint8 zone;
+    TickType_t tick;
+
+    if(HISTORY_getVarint(block, length, &index, &value) == FALSE){
+
+        return;
+    }
+
+    tick = (TickType_t)value;
+
+    if((index + (2u * TEMPERATURE_ZONES)) > length){
+
+        return;
+    }
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        sample.temperatures[zone] = block[index++];
+        sample.states[zone] = block[index++];
+    }
+
+    callback(&sample, tick);
+
+    while(index < length){
+
+        header = block[index++];
+
+        switch(header & HISTORY_RECORD_KIND_MASK){
+
+        case HISTORY_RECORD_RUN:
+
+            for(count = (header & 0x3Fu) + 1u; count != 0; count--){
+
+                tick += HISTORY_PERIOD_TICKS;
+                callback(&sample, tick);
+            }
+            break;
+
+        case HISTORY_RECORD_SMALL:
+
+            sample.temperatures[DRIVER] += (uint8)HISTORY_unzigzag((header >> 3) & 0x07u);
+            sample.temperatures[PASSENGER] += (uint8)HISTORY_unzigzag(header & 0x07u);
+            tick += HISTORY_PERIOD_TICKS;
+            callback(&sample, tick);
+            break;
+
+        case HISTORY_RECORD_FULL:
+
+            for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+                if(HISTORY_getVarint(block, length, &index, &value) == FALSE){
+
+                    return;
+                }
+
+                sample.temperatures[zone] += (uint8)HISTORY_unzigzag(value);
+            }
+
+            for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+                if(header & (1u << (TEMPERATURE_ZONES - 1u - zone))){
+
+                    if(index >= length){
+
+                        return;
+                    }
+
+                    sample.states[zone] = block[index++];
+                }
+            }
+
+            tick += HISTORY_PERIOD_TICKS;
+            callback(&sample, tick);
+            break;
+
+        default:
+
+            return;
+        }
+    }
+}
+
+/* Give the UART to the tasks waiting for it between two lines of a long output, the caller owns it again on return,
+ * a waiting task of the same priority runs first as the caller yields */
+static void HISTORY_shareUart(void){
+
+    xSemaphoreGive(UART_mutex);
+    taskYIELD();
+    xSemaphoreTake(UART_mutex, portMAX_DELAY);
+}
+
+static void HISTORY_printMinute(void){
+
+    uint8 text[FORMAT_NUMBER_SIZE];
+    uint8 zone;
+
+    UART0_SendInteger(g_minute.minute);
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        UART0_SendString(",");
+        UART0_SendInteger(g_minute.minimum[zone]);
+        UART0_SendString(",");
+        UART0_SendInteger(g_minute.maximum[zone]);
+        UART0_SendString(",");
+
+        /* Mean in tenths of a degree, rounded */
+        FORMAT_decimal(text, (sint32)(((g_minute.sum[zone] * 20u) / g_minute.samples + 1u) / 2u), 1);
+        UART0_SendString(text);
+    }
+
+    UART0_SendString(",");
+    UART0_SendInteger(g_minute.samples);
+    UART0_SendString("\r\n");
+
+    HISTORY_shareUart();
+}
+
+static void HISTORY_summarySample(const HISTORY_sampleType* sample, TickType_t tick){
+
+    uint32 minute = tick / HISTORY_MINUTE_TICKS;
+    uint8 zone;
+
+    if((g_minute.samples != 0) && (minute != g_minute.minute)){
+
+        HISTORY_printMinute();
+        g_minute.samples = 0;
+    }
+
+    if(g_minute.samples == 0){
+
+        g_minute.minute = minute;
+
+        for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+            g_minute.minimum[zone] = sample->temperatures[zone];
+            g_minute.maximum[zone] = sample->temperatures[zone];
+            g_minute.sum[zone] = 0;
+        }
+    }
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        if(sample->temperatures[zone] < g_minute.minimum[zone]){
+
+            g_minute.minimum[zone] = sample->temperatures[zone];
+        }
+
+        if(sample->temperatures[zone] > g_minute.maximum[zone]){
+
+            g_minute.maximum[zone] = sample->temperatures[zone];
+        }
+
+        g_minute.sum[zone] += sample->temperatures[zone];
+    }
+
+    g_minute.samples++;
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void HISTORY_init(void){
+
+    g_sampleTimer = xTimerCreate("History", HISTORY_PERIOD_TICKS, pdTRUE, NULL, HISTORY_sampleCallback);
+
+    if(g_sampleTimer != NULL){
+
+        xTimerStart(g_sampleTimer, 0);
+    }
+}
+
+
+void HISTORY_reset(void){
+
+    taskENTER_CRITICAL();
+
+    g_blocksStarted = 0;
+    g_isBlockFull = FALSE;
+    g_run = 0;
+
+    g_encodes = 0;
+    g_encodeCycles = 0;
+    g_encodeMaxCycles = 0;
+
+    taskEXIT_CRITICAL();
+}
+
+
+void HISTORY_report(void){
+
+    uint32 first;
+    uint32 end;
+    uint32 number;
+    uint32 samples = 0;
+    uint32 bytes = 0;
+    uint32 encodes;
+    uint64 encodeCycles;
+    uint32 encodeMaxCycles;
+    uint8 text[FORMAT_NUMBER_SIZE];
+
+    HISTORY_getBlocks(&first, &end);
+
+    taskENTER_CRITICAL();
+
+    for(number = first; number < end; number++){
+
+        samples += g_blockSamples[number % HISTORY_BLOCKS_NUM];
+        bytes += g_blockLengths[number % HISTORY_BLOCKS_NUM];
+    }
+
+    encodes = g_encodes;
+    encodeCycles = g_encodeCycles;
+    encodeMaxCycles = g_encodeMaxCycles;
+
+    taskEXIT_CRITICAL();
+
+    UART0_SendString("history blocks=");
+    UART0_SendInteger(end - first);
+    UART0_SendString("/");
+    UART0_SendInteger(HISTORY_BLOCKS_NUM);
+    UART0_SendString(" dropped=");
+    UART0_SendInteger(first);
+    UART0_SendString(" samples=");
+    UART0_SendInteger(samples);
+    UART0_SendString(" time_s=");
+    UART0_SendInteger(((uint64)samples * HISTORY_SAMPLE_PERIOD) / 1000u);
+    UART0_SendString(" bytes=");
+    UART0_SendInteger(bytes);
+    UART0_SendString(" raw_bytes=");
+    UART0_SendInteger(samples * HISTORY_RAW_SAMPLE_SIZE);
+    UART0_SendString(" ratio=");
+
+    if(bytes != 0){
+
+        FORMAT_decimal(text, (sint32)(((uint64)samples * HISTORY_RAW_SAMPLE_SIZE * 10u) / bytes), 1);
+        UART0_SendString(text);
+    }
+    else{
+
+        UART0_SendString("-");
+    }
+
+    UART0_SendString("\r\nhistory encodes=");
+    UART0_SendInteger(encodes);
+    UART0_SendString(" avg_cycles=");
+    UART0_SendInteger((encodes != 0) ? (encodeCycles / encodes) : 0);
+    UART0_SendString(" max_cycles=");
+    UART0_SendInteger(encodeMaxCycles);
+    UART0_SendString("\r\n");
+}
+
+
+void HISTORY_summary(void){
+
+    uint32 first;
+    uint32 end;
+    uint32 number;
+    uint8 length;
+
+    HISTORY_getBlocks(&first, &end);
+
+    g_minute.samples = 0;
+
+    UART0_SendString("minute,driver_min,driver_max,driver_mean,passenger_min,passenger_max,passenger_mean,samples\r\n");
+
+    for(number = first; number < end; number++){
+
+        length = HISTORY_copyBlock(number);
+
+        if(length != 0){
+
+            HISTORY_decode(g_blockCopy, length, HISTORY_summarySample);
+        }
+
+        /* Printing the whole ring takes seconds, one block is at most a few hundred ms and the UART is shared after every line */
+        SUPERVISOR_CHECK_IN(SUPERVISOR_CONSOLE);
+    }
+
+    if(g_minute.samples != 0){
+
+        HISTORY_printMinute();
+    }
+}
+
+
+void HISTORY_dump(void){
+
+    uint32 first;
+    uint32 end;
+    uint32 number;
+    uint8 length;
+    uint8 line[48];
+
+    HISTORY_getBlocks(&first, &end);
+
+    FORMAT_print(line, sizeof(line), "HISTORY %u %lu %lu\r\n", HISTORY_SAMPLE_PERIOD, (uint32)configTICK_RATE_HZ, end - first);
+    UART0_SendString(line);
+
+    /* A block dropped during the dump is sent with the length 0 */
+    for(number = first; number < end; number++){
+
+        length = HISTORY_copyBlock(number);
+
+        UART0_SendByte(HISTORY_DUMP_BLOCK_MARK);
+        UART0_SendByte(length);
+        UART0_SendData(g_blockCopy, length);
+
+        HISTORY_shareUart();
+        SUPERVISOR_CHECK_IN(SUPERVISOR_CONSOLE);
+    }
+
+    UART0_SendString("\r\n");
+}
@@ -0,0 +1,100 @@
+/**********************************************************************************************************
+ *
+ * Module: History
+ *
+ * File Name: History.h
+ *
+ * Description: Header file of the temperature history, the temperature, desired level and heater mode of every
+ *              seat are sampled periodically into a delta compressed ring in RAM for the analysis after a drive
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_HISTORY_H_
+#define APP_HISTORY_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Sampling period of both seats in ms */
+#define HISTORY_SAMPLE_PERIOD       1000
+
+/* The ring is made of blocks, the oldest block is dropped when the ring is full (2 KB of static RAM) */
+#define HISTORY_BLOCK_SIZE          128u
+#define HISTORY_BLOCKS_NUM          16u
+
+/* Bytes of one uncompressed sample : 32-bit tick then temperature, desired level and heater mode of both seats */
+#define HISTORY_RAW_SAMPLE_SIZE     10u
+
+/* First byte of every block of the dump, the text lines are ASCII so it's never part of a line printed between two blocks */
+#define HISTORY_DUMP_BLOCK_MARK     0xA5u
+
+/* Longest run of unchanged samples in one record */
+#define HISTORY_MAX_RUN             64u
+
+/* Length of the per minute summary in samples */
+#define HISTORY_SUMMARY_SAMPLES     (60000u / HISTORY_SAMPLE_PERIOD)
+
+/*
+ * NOTE:
+ *
+ * Format of every block (the dump sends them as they are in RAM) :
+ *
+ *  keyframe : tick of the first sample (varint), then temperature and state of the driver then of the passenger,
+ *             a state byte is (desired level << 4) | heater mode. The block has its own full sample so it's
+ *             decoded alone, the samples after it are HISTORY_SAMPLE_PERIOD ms apart.
+ *  records  : till the end of the block, one of :
+ *              00rrrrrr        : r + 1 samples with no change in both seats.
+ *              01dddppp        : one sample, the temperature of the driver changed by d and of the passenger by p
+ *                                (zigzag, -4 to 3 degrees), both states unchanged.
+ *              100000xy        : one sample, the temperature change of the driver then of the passenger (zigzag varints)
+ *                                then the state byte of the driver if x is set and of the passenger if y is set.
+ *
+ *  varint : 7 bits per byte, least significant first, bit 7 is set if another byte follows.
+ *  zigzag : 0, -1, 1, -2, 2 ... are coded 0, 1, 2, 3, 4 ... so small changes of any sign are small numbers.
+ *
+ * The dump (console history dump) is the line "HISTORY <period ms> <tick rate> <blocks>" then every block oldest first
+ * as HISTORY_DUMP_BLOCK_MARK, one length byte and the block bytes (length 0 if the block is dropped during the dump),
+ * then "\r\n". Samples missing between two blocks are a gap of the recording.
+ *
+ * The summary and the dump give UART_mutex back between two lines or blocks, so the tasks logging on the UART never
+ * wait for the whole output and miss their check-in. A log line can then show up between two summary lines or
+ * two dumped blocks, the decoder skips any text before the mark of a block. The dump is refused while the binary
+ * telemetry runs, as its frames aren't text.
+ *
+ * tools/history_decode.py decodes a capture of the dump into one CSV row per sample or into the history summary.
+ *
+ *  */
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Create and start the sampling timer, it must be called before the scheduler starts */
+void HISTORY_init(void);
+
+/* Drop every recorded sample and clear the statistics */
+void HISTORY_reset(void);
+
+/* Print the recorded time, samples, bytes, compression ratio and encode cycles on UART0 (the caller must own the UART) */
+void HISTORY_report(void);
+
+/* Decode the ring and print the minimum, maximum and mean temperature of every seat per minute on UART0 as CSV,
+ * only the console may call it as it checks in for the console after every block, the caller must own the UART
+ * (it's given back and taken again between two lines) */
+void HISTORY_summary(void);
+
+/* Send the ring in the binary format above on UART0, the caller must own the UART (it's given back and taken again
+ * between two blocks) */
+void HISTORY_dump(void);
+
+
+#endif /* APP_HISTORY_H_ */
@@ -0,0 +1,160 @@
+/**********************************************************************************************************
+ *
+ * Module: Jobs
+ *
+ * File Name: Jobs.c
+ *
+ * Description: Source file of the periodic jobs that run as software timer callbacks on the timer task stack
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Jobs.h"
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    JOB_callbackType callback;
+    void* parameter;
+    TimerHandle_t timer;
+
+    /* Ideal release time of the current release in cycles, 0 till the first release */
+    uint64 release;
+
+    JOB_statsType stats;
+
+}JOB_type;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static JOB_type g_jobs[JOBS_MAX_NUM];
+static uint8 g_jobsNum = 0;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Callback of every job timer, the timer ID is the job index */
+static void JOB_dispatch(TimerHandle_t xTimer){
+
+    JOB_type* job = &g_jobs[(uint32)pvTimerGetTimerID(xTimer)];
+    uint64 start = TIMEBASE_getCycles();
+    uint64 end;
+    uint32 lateness;
+    uint32 response;
+
+    if(job->release == 0){
+
+        /* The first release is the reference of the next ones, then the timer continues by the period */
+        job->release = start;
+
+        if(job->stats.phaseMs != 0){
+
+            xTimerChangePeriod(xTimer, pdMS_TO_TICKS(job->stats.periodMs), 0);
+        }
+    }
+    else{
+
+        job->release += TIMEBASE_usToCycles((uint64)job->stats.periodMs * 1000u);
+    }
+
+    job->callback(job->parameter);
+
+    end = TIMEBASE_getCycles();
+
+    /* A release is never earlier than the tick it's due at, but the first one may be a little late itself */
+    lateness = (start > job->release) ? (uint32)TIMEBASE_cyclesToUs(start - job->release) : 0;
+    response = (end > job->release) ? (uint32)TIMEBASE_cyclesToUs(end - job->release) : 0;
+
+    if(lateness < job->stats.minLateness){
+
+        job->stats.minLateness = lateness;
+    }
+
+    if(lateness > job->stats.maxLateness){
+
+        job->stats.maxLateness = lateness;
+    }
+
+    if(response > job->stats.maxResponse){
+
+        job->stats.maxResponse = response;
+    }
+
+    if(response > (job->stats.deadlineMs * 1000u)){
+
+        job->stats.misses++;
+    }
+
+    job->stats.runs++;
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+boolean JOB_create(const char* name, JOB_callbackType callback, void* parameter, uint32 periodMs, uint32 phaseMs, uint32 deadlineMs){
+
+    JOB_type* job;
+
+    if((g_jobsNum >= JOBS_MAX_NUM) || (periodMs == 0) || (callback == NULL)){
+
+        return FALSE;
+    }
+
+    job = &g_jobs[g_jobsNum];
+
+    job->callback = callback;
+    job->parameter = parameter;
+    job->release = 0;
+
+    job->stats.name = name;
+    job->stats.periodMs = periodMs;
+    job->stats.phaseMs = phaseMs;
+    job->stats.deadlineMs = deadlineMs;
+    job->stats.runs = 0;
+    job->stats.misses = 0;
+    job->stats.minLateness = 0xFFFFFFFFul;
+    job->stats.maxLateness = 0;
+    job->stats.maxResponse = 0;
+
+    /* The first timer period is the phase, it's changed to the period at the first release */
+    job->timer = xTimerCreate(name, pdMS_TO_TICKS((phaseMs != 0) ? phaseMs : periodMs), pdTRUE, (void*)(uint32)g_jobsNum, JOB_dispatch);
+
+    if((job->timer == NULL) || (xTimerStart(job->timer, 0) != pdPASS)){
+
+        return FALSE;
+    }
+
+    g_jobsNum++;
+
+    return TRUE;
+}
+
+
+uint8 JOB_getJobsNum(void){
+
+    return g_jobsNum;
+}
+
+
+boolean JOB_getStats(uint8 index, JOB_statsType* stats){
+
+    if(index >= g_jobsNum){
+
+        return FALSE;
+    }
+
+    /* The timer task updates them */
+    taskENTER_CRITICAL();
+    *stats = g_jobs[index].stats;
+    taskEXIT_CRITICAL();
+
+    return TRUE;
+}
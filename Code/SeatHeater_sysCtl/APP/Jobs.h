@@ -0,0 +1,85 @@
+/**********************************************************************************************************
+ *
+ * Module: Jobs
+ *
+ * File Name: Jobs.h
+ *
+ * Description: Header file of the periodic jobs that run as software timer callbacks on the timer task stack
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_JOBS_H_
+#define APP_JOBS_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+#include"timers.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Maximum number of jobs */
+#define JOBS_MAX_NUM                4u
+
+/*
+ * NOTE:
+ *
+ * Every job is an auto-reload software timer, so all jobs share the stack of the timer task and run at its priority
+ * (the highest one), one after the other. A job must never block, every kernel call in a job uses a zero timeout
+ * and the job skips what it can't do now to its next release.
+ *
+ * The first release is phase after the scheduler starts (one period if the phase is 0) then every period.
+ *
+ * Every release is measured by the cycle counter :
+ *  lateness : start of the job - its ideal release time (the first start is the reference), its spread is the jitter.
+ *  response : end of the job - its ideal release time, it's a deadline miss if it's longer than the deadline.
+ *
+ * The periodic activities run as jobs only when APP_PERIODIC_JOBS is 1 (FreeRTOSConfig.h).
+ *
+ *  */
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef void (*JOB_callbackType)(void* parameter);
+
+typedef struct{
+
+    const char* name;
+    uint32 periodMs;
+    uint32 phaseMs;
+    uint32 deadlineMs;
+
+    uint32 runs;
+    uint32 misses;
+
+    /* In micro seconds */
+    uint32 minLateness;
+    uint32 maxLateness;
+    uint32 maxResponse;
+
+}JOB_statsType;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Create a job and start its timer (the timer runs once the scheduler starts),
+ * returns FALSE if all jobs are used, the period is 0 or there isn't enough heap for the timer */
+boolean JOB_create(const char* name, JOB_callbackType callback, void* parameter, uint32 periodMs, uint32 phaseMs, uint32 deadlineMs);
+
+/* Number of created jobs */
+uint8 JOB_getJobsNum(void);
+
+/* Copy the parameters and the measurements of one job, returns FALSE if there is no such job */
+boolean JOB_getStats(uint8 index, JOB_statsType* stats);
+
+
+#endif /* APP_JOBS_H_ */
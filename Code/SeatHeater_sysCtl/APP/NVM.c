@@ -0,0 +1,309 @@
+/**********************************************************************************************************
+ *
+ * Module: NVM
+ *
+ * File Name: NVM.c
+ *
+ * Description: Source file of the non-volatile storage of the setpoints, sensors calibration and fault log
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"NVM.h"
+#include"Supervisor.h"
+
+#include<string.h>
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    /* First EEPROM block and number of blocks (slots) of the record area */
+    uint8 firstBlock;
+    uint8 slots;
+
+    /* Payload length in bytes */
+    uint16 length;
+
+}NVM_areaType;
+
+typedef struct{
+
+    /* RAM image of the payload, it's always the newest data even before it's written */
+    uint32 payload[NVM_MAX_PAYLOAD_WORDS];
+
+    /* Slot and sequence number of the newest record in the EEPROM */
+    boolean isStored;
+    uint8 slot;
+    uint32 sequence;
+
+    /* The payload is changed and waits for the writer task */
+    boolean isDirty;
+
+}NVM_recordType;
+
+/***************************************************************************
+ *                          Compile-time checks
+ *************************************************************************** */
+
+/* The build fails here if any payload doesn't fit into one EEPROM block with the header and the CRC */
+typedef uint8 NVM_setpointsSizeCheck[(sizeof(NVM_setpointsType) <= (NVM_MAX_PAYLOAD_WORDS * 4u)) ? 1 : -1];
+typedef uint8 NVM_calibrationSizeCheck[(sizeof(NVM_calibrationType) <= (NVM_MAX_PAYLOAD_WORDS * 4u)) ? 1 : -1];
+typedef uint8 NVM_faultLogSizeCheck[(sizeof(NVM_faultLogType) <= (NVM_MAX_PAYLOAD_WORDS * 4u)) ? 1 : -1];
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* Areas must not overlap and must fit into the 32 blocks of the EEPROM */
+static const NVM_areaType NVM_areas[NVM_RECORDS_NUM] = {
+
+    {0,  8, sizeof(NVM_setpointsType)},      /* Setpoints   : blocks 0 to 7   */
+    {8,  4, sizeof(NVM_calibrationType)},    /* Calibration : blocks 8 to 11  */
+    {12, 8, sizeof(NVM_faultLogType)}        /* Fault log   : blocks 12 to 19 */
+};
+
+static NVM_recordType NVM_records[NVM_RECORDS_NUM];
+
+/* FALSE if the EEPROM can't be used, the records then live in RAM only */
+static boolean g_isEEPROMAvailable = FALSE;
+
+volatile uint32 NVM_writeErrors = 0;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) calculated bit by bit as the records are small */
+static uint32 NVM_crc32(const uint32* pData, uint32 numOfWords){
+
+    uint32 crc = 0xFFFFFFFFul;
+    uint32 i;
+    uint8 bit;
+
+    for(i=0; i<numOfWords; i++){
+
+        crc ^= pData[i];
+
+        for(bit=0; bit<32; bit++){
+
+            crc = (crc & 1u) ? ((crc >> 1) ^ 0xEDB88320ul) : (crc >> 1);
+        }
+    }
+
+    return ~crc;
+}
+
+static uint32 NVM_payloadWords(NVM_recordIdType id){
+
+    return (NVM_areas[id].length + 3u) / 4u;
+}
+
+/* Find the newest valid slot of the record and load its payload */
+static void NVM_loadRecord(NVM_recordIdType id){
+
+    uint32 block[EEPROM_WORDS_PER_BLOCK];
+    uint32 payloadWords = NVM_payloadWords(id);
+    uint8 slot;
+
+    for(slot=0; slot<NVM_areas[id].slots; slot++){
+
+        if(EEPROM_read((NVM_areas[id].firstBlock + slot) * EEPROM_BYTES_PER_BLOCK, block, EEPROM_WORDS_PER_BLOCK) == FALSE){
+
+            continue;
+        }
+
+        if((block[0] != (((uint32)NVM_MAGIC << 16) | ((uint32)id << 8) | NVM_FORMAT_VERSION)) ||
+           (block[2] != NVM_areas[id].length) ||
+           (block[NVM_HEADER_WORDS + payloadWords] != NVM_crc32(block, NVM_HEADER_WORDS + payloadWords))){
+
+            continue;
+        }
+
+        if((NVM_records[id].isStored == FALSE) || (block[1] > NVM_records[id].sequence)){
+
+            NVM_records[id].isStored = TRUE;
+            NVM_records[id].slot = slot;
+            NVM_records[id].sequence = block[1];
+            memcpy(NVM_records[id].payload, &block[NVM_HEADER_WORDS], payloadWords * 4u);
+        }
+    }
+}
+
+/* Write the payload into the slot after the newest one */
+static boolean NVM_storeRecord(NVM_recordIdType id, const uint32* payload){
+
+    uint32 block[EEPROM_WORDS_PER_BLOCK];
+    uint32 payloadWords = NVM_payloadWords(id);
+    uint32 sequence = NVM_records[id].sequence + 1u;
+    uint8 slot = 0;
+
+    if(NVM_records[id].isStored == TRUE){
+
+        slot = (NVM_records[id].slot + 1u) % NVM_areas[id].slots;
+    }
+
+    block[0] = ((uint32)NVM_MAGIC << 16) | ((uint32)id << 8) | NVM_FORMAT_VERSION;
+    block[1] = sequence;
+    block[2] = NVM_areas[id].length;
+    memcpy(&block[NVM_HEADER_WORDS], payload, payloadWords * 4u);
+    block[NVM_HEADER_WORDS + payloadWords] = NVM_crc32(block, NVM_HEADER_WORDS + payloadWords);
+
+    if(EEPROM_write((NVM_areas[id].firstBlock + slot) * EEPROM_BYTES_PER_BLOCK, block, NVM_HEADER_WORDS + payloadWords + 1u) == FALSE){
+
+        return FALSE;
+    }
+
+    NVM_records[id].isStored = TRUE;
+    NVM_records[id].slot = slot;
+    NVM_records[id].sequence = sequence;
+
+    return TRUE;
+}
+
+/* Mark the record changed and wake up the writer task, the payload must be already updated inside a critical section */
+static void NVM_requestWrite(NVM_recordIdType id){
+
+    NVM_records[id].isDirty = TRUE;
+
+    /* Before the writer task is created the record is written when the task starts */
+    if(task13handle != NULL){
+
+        xTaskNotifyGive(task13handle);
+    }
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void NVM_init(void){
+
+    NVM_setpointsType* setpoints = (NVM_setpointsType*)NVM_records[NVM_RECORD_SETPOINTS].payload;
+    NVM_calibrationType* calibration = (NVM_calibrationType*)NVM_records[NVM_RECORD_CALIBRATION].payload;
+    uint8 i;
+    NVM_recordIdType id;
+
+    g_isEEPROMAvailable = EEPROM_init();
+
+    if(g_isEEPROMAvailable == TRUE){
+
+        for(id=NVM_RECORD_SETPOINTS; id<NVM_RECORDS_NUM; id++){
+
+            NVM_loadRecord(id);
+        }
+    }
+
+    /* Restore the desired levels, an invalid level is ignored */
+    if(NVM_records[NVM_RECORD_SETPOINTS].isStored == TRUE){
+
+        for(i=0; i<2; i++){
+
+            if(setpoints->desiredLevel[i] <= HEATER_HIGH){
+
+                g_desiredLevel[i] = (heatingMode_Type)setpoints->desiredLevel[i];
+            }
+        }
+    }
+
+    /* Restore the calibration, an invalid calibration keeps the default one */
+    if(NVM_records[NVM_RECORD_CALIBRATION].isStored == TRUE){
+
+        for(i=0; i<TEMPERATURE_ZONES; i++){
+
+            TEMPSENSOR_setCalibration(i, &calibration->zones[i]);
+        }
+    }
+}
+
+void NVM_saveSetpoints(void){
+
+    NVM_setpointsType* setpoints = (NVM_setpointsType*)NVM_records[NVM_RECORD_SETPOINTS].payload;
+
+    taskENTER_CRITICAL();
+    setpoints->desiredLevel[DRIVER] = (uint8)g_desiredLevel[DRIVER];
+    setpoints->desiredLevel[PASSENGER] = (uint8)g_desiredLevel[PASSENGER];
+    NVM_requestWrite(NVM_RECORD_SETPOINTS);
+    taskEXIT_CRITICAL();
+}
+
+void NVM_saveCalibration(void){
+
+    NVM_calibrationType* calibration = (NVM_calibrationType*)NVM_records[NVM_RECORD_CALIBRATION].payload;
+
+    taskENTER_CRITICAL();
+    memcpy(calibration->zones, TEMPSENSOR_calibration, sizeof(calibration->zones));
+    NVM_requestWrite(NVM_RECORD_CALIBRATION);
+    taskEXIT_CRITICAL();
+}
+
+void NVM_logFault(uint8 zone, TEMPSENSOR_faultType fault){
+
+    NVM_faultLogType* log = (NVM_faultLogType*)NVM_records[NVM_RECORD_FAULT_LOG].payload;
+    NVM_faultLogEntryType* entry;
+
+    taskENTER_CRITICAL();
+    entry = &log->entries[log->totalFaults % NVM_FAULT_LOG_ENTRIES];
+    entry->uptime = xTaskGetTickCount() / configTICK_RATE_HZ;
+    entry->zone = zone;
+    entry->fault = (uint8)fault;
+    entry->reserved = 0;
+    log->totalFaults++;
+    NVM_requestWrite(NVM_RECORD_FAULT_LOG);
+    taskEXIT_CRITICAL();
+}
+
+void NVM_getFaultLog(NVM_faultLogType* log){
+
+    taskENTER_CRITICAL();
+    memcpy(log, NVM_records[NVM_RECORD_FAULT_LOG].payload, sizeof(NVM_faultLogType));
+    taskEXIT_CRITICAL();
+}
+
+/****************************************************************************
+ *                               Tasks definition
+ * ************************************************************************/
+
+/* Write every changed record into the EEPROM, it's the only task that waits for the EEPROM program cycles */
+void vNvmWriterTask( void * pvParameters ){
+
+    uint32 payload[NVM_MAX_PAYLOAD_WORDS];
+    NVM_recordIdType id;
+
+    /* A burst is written after the settle time, every record may need a sector copy of the EEPROM */
+    SUPERVISOR_register(SUPERVISOR_NVM_WRITER, TASK_CHECK_IN_PERIOD + NVM_WRITE_SETTLE_TIME + SUPERVISOR_CHECK_IN_MARGIN);
+
+    while(1){
+
+        SUPERVISOR_CHECK_IN(SUPERVISOR_NVM_WRITER);
+
+        for(id=NVM_RECORD_SETPOINTS; id<NVM_RECORDS_NUM; id++){
+
+            if(NVM_records[id].isDirty == FALSE){
+
+                continue;
+            }
+
+            /* Take a copy so the payload can be changed again while it's being written */
+            taskENTER_CRITICAL();
+            memcpy(payload, NVM_records[id].payload, sizeof(payload));
+            NVM_records[id].isDirty = FALSE;
+            taskEXIT_CRITICAL();
+
+            if((g_isEEPROMAvailable == FALSE) || (NVM_storeRecord(id, payload) == FALSE)){
+
+                NVM_writeErrors++;
+            }
+        }
+
+        /* Blocked until a record is changed or the check-in period passes */
+        if(ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_CHECK_IN_PERIOD)) != 0){
+
+            /* Collect the other changes of the same burst */
+            vTaskDelay(pdMS_TO_TICKS(NVM_WRITE_SETTLE_TIME));
+        }
+    }
+}
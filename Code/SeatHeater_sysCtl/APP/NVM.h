@@ -0,0 +1,138 @@
+/**********************************************************************************************************
+ *
+ * Module: NVM
+ *
+ * File Name: NVM.h
+ *
+ * Description: Header file of the non-volatile storage of the setpoints, sensors calibration and fault log
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_NVM_H_
+#define APP_NVM_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+#include"MCAL/EEPROM.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/*
+ * NOTE:
+ *
+ * Every record has its own area of EEPROM blocks (slots) and every save writes the record into the next slot,
+ * so the wear is spread over all the slots of the area. The record with a valid CRC and the highest sequence number
+ * is the current one, so a save interrupted by a reset just leaves the previous record current.
+ *
+ * Layout of one slot (one EEPROM block) :
+ *
+ *  word 0          : magic (bits 31:16) | record id (bits 15:8) | format version (bits 7:0)
+ *  word 1          : sequence number
+ *  word 2          : payload length in bytes
+ *  words 3..       : payload
+ *  word after it   : CRC-32 of all the previous words
+ *
+ * Records of another format version are ignored and the defaults are used.
+ *
+ *  */
+
+#define NVM_MAGIC                   0x5348u
+#define NVM_FORMAT_VERSION          1u
+
+#define NVM_HEADER_WORDS            3u
+#define NVM_MAX_PAYLOAD_WORDS       (EEPROM_WORDS_PER_BLOCK - NVM_HEADER_WORDS - 1u)
+
+#define NVM_FAULT_LOG_ENTRIES       5u
+
+/* The writer task waits this time after the first save request so a burst of saves (button presses) is written once */
+#define NVM_WRITE_SETTLE_TIME       2000
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef enum{
+
+    NVM_RECORD_SETPOINTS,
+    NVM_RECORD_CALIBRATION,
+    NVM_RECORD_FAULT_LOG,
+    NVM_RECORDS_NUM
+
+}NVM_recordIdType;
+
+typedef struct{
+
+    /* Last desired level of every seat (indexed by instance) */
+    uint8 desiredLevel[2];
+
+}NVM_setpointsType;
+
+typedef struct{
+
+    TEMPSENSOR_calibrationType zones[TEMPERATURE_ZONES];
+
+}NVM_calibrationType;
+
+typedef struct{
+
+    /* Seconds since the boot in which the fault is confirmed */
+    uint32 uptime;
+
+    uint8 zone;
+    uint8 fault;
+    uint16 reserved;
+
+}NVM_faultLogEntryType;
+
+typedef struct{
+
+    /* Number of logged faults since the log is created, the newest entry is at index (totalFaults - 1) % NVM_FAULT_LOG_ENTRIES */
+    uint32 totalFaults;
+
+    NVM_faultLogEntryType entries[NVM_FAULT_LOG_ENTRIES];
+
+}NVM_faultLogType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* Number of record writes that failed */
+extern volatile uint32 NVM_writeErrors;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Load every record from the EEPROM and restore the desired levels and sensors calibration, call it before the scheduler starts */
+void NVM_init(void);
+
+/* The following functions only copy the data and wake up the writer task, they never wait for the EEPROM */
+
+/* Save the desired level of both seats */
+void NVM_saveSetpoints(void);
+
+/* Save the calibration of both sensors */
+void NVM_saveCalibration(void);
+
+/* Add a confirmed sensor fault to the fault log */
+void NVM_logFault(uint8 zone, TEMPSENSOR_faultType fault);
+
+void NVM_getFaultLog(NVM_faultLogType* log);
+
+/****************************************************************************
+ *                               Tasks prototype
+ * ************************************************************************/
+
+/* Write every changed record into the EEPROM, it's the only task that waits for the EEPROM program cycles */
+void vNvmWriterTask( void * pvParameters );
+
+
+#endif /* APP_NVM_H_ */
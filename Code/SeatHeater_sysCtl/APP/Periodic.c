@@ -0,0 +1,127 @@
+/**********************************************************************************************************
+ *
+ * Module: Periodic
+ *
+ * File Name: Periodic.c
+ *
+ * Description: Source file of the periodic tasks releases on absolute times with their response time,
+ *              lateness and deadline misses
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Periodic.h"
+#include"Schedulability.h"
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static PERIODIC_taskType* g_periodicTasks[PERIODIC_MAX_NUM];
+static uint8 g_periodicTasksNum = 0;
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void PERIODIC_start(PERIODIC_taskType* periodic, const char* name, uint32 periodMs, uint32 deadlineMs){
+
+    periodic->lastWakeTime = xTaskGetTickCount();
+    periodic->release = 0;
+
+    periodic->stats.name = name;
+    periodic->stats.periodMs = periodMs;
+    periodic->stats.deadlineMs = deadlineMs;
+    periodic->stats.releases = 0;
+    periodic->stats.misses = 0;
+    periodic->stats.overruns = 0;
+    periodic->stats.maxLateness = 0;
+    periodic->stats.maxResponse = 0;
+
+    taskENTER_CRITICAL();
+
+    if(g_periodicTasksNum < PERIODIC_MAX_NUM){
+
+        g_periodicTasks[g_periodicTasksNum] = periodic;
+        g_periodicTasksNum++;
+    }
+
+    taskEXIT_CRITICAL();
+
+    /* The response time analysis takes the declared period instead of the measured wake-ups */
+    SCHED_declarePeriod(periodMs, deadlineMs);
+}
+
+
+void PERIODIC_waitRelease(PERIODIC_taskType* periodic){
+
+    uint64 now;
+    uint32 lateness;
+
+    /* The wake time is advanced by exactly one period every call, it doesn't wait if the release is already due */
+    if(xTaskDelayUntil(&periodic->lastWakeTime, pdMS_TO_TICKS(periodic->stats.periodMs)) == pdFALSE){
+
+        periodic->stats.overruns++;
+    }
+
+    now = TIMEBASE_getCycles();
+
+    /* The first wake up is the reference of the next releases, it's on a tick like all of them */
+    if(periodic->release == 0){
+
+        periodic->release = now;
+    }
+    else{
+
+        periodic->release += TIMEBASE_usToCycles((uint64)periodic->stats.periodMs * 1000u);
+    }
+
+    lateness = (now > periodic->release) ? (uint32)TIMEBASE_cyclesToUs(now - periodic->release) : 0;
+
+    if(lateness > periodic->stats.maxLateness){
+
+        periodic->stats.maxLateness = lateness;
+    }
+
+    periodic->stats.releases++;
+}
+
+
+void PERIODIC_complete(PERIODIC_taskType* periodic){
+
+    uint64 now = TIMEBASE_getCycles();
+    uint32 response = (now > periodic->release) ? (uint32)TIMEBASE_cyclesToUs(now - periodic->release) : 0;
+
+    if(response > periodic->stats.maxResponse){
+
+        periodic->stats.maxResponse = response;
+    }
+
+    if(response > (periodic->stats.deadlineMs * 1000u)){
+
+        periodic->stats.misses++;
+    }
+}
+
+
+uint8 PERIODIC_getTasksNum(void){
+
+    return g_periodicTasksNum;
+}
+
+
+boolean PERIODIC_getStats(uint8 index, PERIODIC_statsType* stats){
+
+    if(index >= g_periodicTasksNum){
+
+        return FALSE;
+    }
+
+    /* The periodic task updates them */
+    taskENTER_CRITICAL();
+    *stats = g_periodicTasks[index]->stats;
+    taskEXIT_CRITICAL();
+
+    return TRUE;
+}
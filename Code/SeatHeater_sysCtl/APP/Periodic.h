@@ -0,0 +1,98 @@
+/**********************************************************************************************************
+ *
+ * Module: Periodic
+ *
+ * File Name: Periodic.h
+ *
+ * Description: Header file of the periodic tasks releases on absolute times with their response time,
+ *              lateness and deadline misses
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_PERIODIC_H_
+#define APP_PERIODIC_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Maximum number of periodic tasks */
+#define PERIODIC_MAX_NUM            4u
+
+/*
+ * NOTE:
+ *
+ * A periodic task calls PERIODIC_start once then every loop :
+ *
+ *  PERIODIC_waitRelease(&periodic);    blocked till the next release (vTaskDelayUntil, so the period never drifts)
+ *  ... the work of one release ...
+ *  PERIODIC_complete(&periodic);
+ *
+ * The releases are on absolute times : the first release then every period after it, measured by the cycle counter :
+ *  lateness : wake up of the task - its release time (preemption by higher priority tasks and interrupts).
+ *  response : PERIODIC_complete - its release time, it's a deadline miss if it's longer than the deadline.
+ *  overrun  : the previous release completed after the current release time, so the task didn't wait at all.
+ *
+ *  */
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    const char* name;
+    uint32 periodMs;
+    uint32 deadlineMs;
+
+    uint32 releases;
+    uint32 misses;
+    uint32 overruns;
+
+    /* In micro seconds */
+    uint32 maxLateness;
+    uint32 maxResponse;
+
+}PERIODIC_statsType;
+
+typedef struct{
+
+    TickType_t lastWakeTime;
+
+    /* Release time of the current release in cycles, 0 till the first release */
+    uint64 release;
+
+    PERIODIC_statsType stats;
+
+}PERIODIC_taskType;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Called once by the task before its loop, the first release is one period later,
+ * the task is listed for PERIODIC_getStats if there is room */
+void PERIODIC_start(PERIODIC_taskType* periodic, const char* name, uint32 periodMs, uint32 deadlineMs);
+
+/* Block till the next release */
+void PERIODIC_waitRelease(PERIODIC_taskType* periodic);
+
+/* The work of the current release is done */
+void PERIODIC_complete(PERIODIC_taskType* periodic);
+
+/* Number of listed periodic tasks */
+uint8 PERIODIC_getTasksNum(void);
+
+/* Copy the parameters and the measurements of one periodic task, returns FALSE if there is no such task */
+boolean PERIODIC_getStats(uint8 index, PERIODIC_statsType* stats);
+
+
+#endif /* APP_PERIODIC_H_ */
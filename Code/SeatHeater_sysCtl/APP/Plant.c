@@ -0,0 +1,172 @@
+/**********************************************************************************************************
+ *
+ * Module: Plant
+ *
+ * File Name: Plant.c
+ *
+ * Description: Source file of the seats thermal model that replaces the temperature sensors to evaluate the heating control
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Plant.h"
+#include"timers.h"
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    /* Seat, sensor and metrics of the zone */
+    PLANT_modelType model;
+
+    /* Simulated sensor reading read by the monitoring task */
+    uint16 adc;
+
+    heatingMode_Type desiredLevel;
+
+}PLANT_zoneType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static PLANT_zoneType g_zones[TEMPERATURE_ZONES];
+
+static volatile boolean g_isRunning = FALSE;
+static boolean g_isStarted = FALSE;
+
+static float32 g_ambientTemperature;
+
+/* Simulated seconds of one step */
+static float32 g_stepTime;
+
+static TimerHandle_t g_stepTimer;
+
+/* Random seed and amplitude in ADC counts of the sensor noise */
+static uint32 g_seed = 1;
+static uint8 g_noise;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Power of the heater of the zone as set on its LEDs */
+static float32 PLANT_heaterPower(uint8 zone){
+
+    float32 power = 0.0f;
+
+    if(zone == DRIVER){
+
+        power += (LED_GET(LED_DRIVER_GREEN) == LED_ON) ? PLANT_GREEN_POWER : 0.0f;
+        power += (LED_GET(LED_DRIVER_BLUE) == LED_ON) ? PLANT_BLUE_POWER : 0.0f;
+    }
+    else{
+
+        power += (LED_GET(LED_PASSENGER_GREEN) == LED_ON) ? PLANT_GREEN_POWER : 0.0f;
+        power += (LED_GET(LED_PASSENGER_BLUE) == LED_ON) ? PLANT_BLUE_POWER : 0.0f;
+    }
+
+    return power;
+}
+
+static void PLANT_stepZone(uint8 zoneNum){
+
+    PLANT_zoneType* zone = &g_zones[zoneNum];
+
+    if(g_desiredLevel[zoneNum] != zone->desiredLevel){
+
+        zone->desiredLevel = g_desiredLevel[zoneNum];
+        PLANT_modelRestartMetrics(&zone->model, CONTROL_desiredTemperature(zone->desiredLevel));
+    }
+
+    PLANT_modelStep(&zone->model, PLANT_heaterPower(zoneNum), g_ambientTemperature, g_stepTime);
+
+    zone->adc = PLANT_modelReading(&zone->model, &TEMPSENSOR_calibration[zoneNum], g_noise, &g_seed);
+}
+
+/* Runs in the timer task every PLANT_STEP_PERIOD while the simulation runs, so it must never block */
+static void PLANT_stepCallback(TimerHandle_t xTimer){
+
+    PLANT_stepZone(DRIVER);
+    PLANT_stepZone(PASSENGER);
+
+#if (APP_PERIODIC_JOBS == 0)
+    /* The comparators don't see the simulated readings, so the monitoring tasks read every step (the jobs read every step anyway) */
+    xTaskNotifyGive(task2handle);
+    xTaskNotifyGive(task3handle);
+#endif
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void PLANT_init(void){
+
+    g_stepTimer = xTimerCreate("Plant step", pdMS_TO_TICKS(PLANT_STEP_PERIOD), pdTRUE, NULL, PLANT_stepCallback);
+}
+
+boolean PLANT_start(uint8 ambientTemperature, uint32 timeScale, uint8 noise){
+
+    uint8 zone;
+
+    if((timeScale == 0) || (timeScale > PLANT_MAX_TIME_SCALE) || (noise < PLANT_MIN_NOISE) || (noise > PLANT_MAX_NOISE)){
+
+        return FALSE;
+    }
+
+    PLANT_stop();
+
+    g_ambientTemperature = ambientTemperature;
+    g_noise = noise;
+    g_stepTime = (timeScale * PLANT_STEP_PERIOD) / 1000.0f;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        g_zones[zone].desiredLevel = g_desiredLevel[zone];
+        PLANT_modelStart(&g_zones[zone].model, ambientTemperature, PLANT_heaterPower(zone),
+                         CONTROL_desiredTemperature(g_zones[zone].desiredLevel));
+        g_zones[zone].adc = PLANT_modelReading(&g_zones[zone].model, &TEMPSENSOR_calibration[zone], g_noise, &g_seed);
+    }
+
+    g_isStarted = TRUE;
+    g_isRunning = TRUE;
+
+    xTimerStart(g_stepTimer, 0);
+
+    return TRUE;
+}
+
+void PLANT_stop(void){
+
+    xTimerStop(g_stepTimer, 0);
+    g_isRunning = FALSE;
+}
+
+uint16 PLANT_adcSample(uint8 zone, uint16 adc){
+
+    if((g_isRunning == TRUE) && (zone < TEMPERATURE_ZONES)){
+
+        return g_zones[zone].adc;
+    }
+
+    return adc;
+}
+
+boolean PLANT_getReport(uint8 zone, PLANT_reportType* report){
+
+    if((g_isStarted == FALSE) || (zone >= TEMPERATURE_ZONES)){
+
+        return FALSE;
+    }
+
+    /* The step runs in the timer task which has a higher priority */
+    taskENTER_CRITICAL();
+    *report = g_zones[zone].model.report;
+    taskEXIT_CRITICAL();
+
+    return TRUE;
+}
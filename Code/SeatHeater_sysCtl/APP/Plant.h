@@ -0,0 +1,73 @@
+/**********************************************************************************************************
+ *
+ * Module: Plant
+ *
+ * File Name: Plant.h
+ *
+ * Description: Header file of the seats thermal model that replaces the temperature sensors to evaluate the heating control
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_PLANT_H_
+#define APP_PLANT_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+#include"PlantModel.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/*
+ * NOTE:
+ *
+ * While the simulation runs, every seat is a thermal mass heated by its heater and losing heat to the cabin (ambient),
+ * its sensor follows the seat temperature with a first order lag. The heater power is read from the heater LEDs
+ * (green and blue add their power, red is off) so the loop is closed through the LED and ADC paths of the firmware
+ * without any change in the control tasks, the simulated sensor reading replaces the ADC reading of the monitoring tasks.
+ *
+ * Every PLANT_STEP_PERIOD of real time the model advances (time scale * PLANT_STEP_PERIOD) of simulated time,
+ * the control reacts once every PLANT_STEP_PERIOD so high time scales make the control coarser than on a real seat.
+ *
+ * The metrics restart with the simulation and whenever the desired level of the seat changes.
+ *
+ *  */
+
+/* Real time between two steps of the model, the monitoring tasks read the simulated sensors every step */
+#define PLANT_STEP_PERIOD               TEMPERATURE_SAMPLE_PERIOD_MS
+
+#define PLANT_MAX_TIME_SCALE            1000u
+
+/* Sensor noise is uniform within plus or minus this number of ADC counts, at least 1 so a steady seat isn't a stuck sensor */
+#define PLANT_MIN_NOISE                 1u
+#define PLANT_DEFAULT_NOISE             1u
+#define PLANT_MAX_NOISE                 50u
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Create the step timer, must be called before the scheduler starts */
+void PLANT_init(void);
+
+/* Start the simulation with both seats at the ambient temperature,
+ * returns FALSE if the time scale isn't 1 to PLANT_MAX_TIME_SCALE or the noise isn't PLANT_MIN_NOISE to PLANT_MAX_NOISE */
+boolean PLANT_start(uint8 ambientTemperature, uint32 timeScale, uint8 noise);
+
+/* Stop the simulation, the monitoring tasks read the real sensors again and the metrics are kept for the report */
+void PLANT_stop(void);
+
+/* Returns the simulated sensor reading of the zone while the simulation runs, otherwise the real reading */
+uint16 PLANT_adcSample(uint8 zone, uint16 adc);
+
+/* Metrics of the zone since they restarted, returns FALSE if the simulation never started */
+boolean PLANT_getReport(uint8 zone, PLANT_reportType* report);
+
+
+#endif /* APP_PLANT_H_ */
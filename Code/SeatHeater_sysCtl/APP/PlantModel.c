@@ -0,0 +1,133 @@
+/**********************************************************************************************************
+ *
+ * Module: Plant model
+ *
+ * File Name: PlantModel.c
+ *
+ * Description: Source file of the thermal model of one seat and its sensor, every model is its own instance without
+ *              any RTOS or hardware access, so the Plant module runs one per seat and the host tools run many at once
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"PlantModel.h"
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void PLANT_modelStart(PLANT_modelType* model, float32 temperature, float32 power, uint8 desiredTemperature){
+
+    model->seatTemperature = temperature;
+    model->sensorTemperature = temperature;
+    model->power = power;
+
+    PLANT_modelRestartMetrics(model, desiredTemperature);
+    model->report.seatTemperature = temperature;
+}
+
+
+void PLANT_modelRestartMetrics(PLANT_modelType* model, uint8 desiredTemperature){
+
+    model->report.time = 0.0f;
+    model->report.desiredTemperature = desiredTemperature;
+    model->report.isSettled = FALSE;
+    model->report.settlingTime = 0.0f;
+    model->report.overshoot = 0.0f;
+    model->report.switches = 0;
+    model->report.energy = 0.0f;
+    model->lastOutsideTime = 0.0f;
+}
+
+
+void PLANT_modelStep(PLANT_modelType* model, float32 power, float32 ambientTemperature, float32 stepTime){
+
+    PLANT_reportType* report = &model->report;
+    float32 error;
+    float32 dt;
+    uint32 substeps;
+    uint32 i;
+
+    if(power != model->power){
+
+        model->power = power;
+        report->switches++;
+    }
+
+    substeps = (uint32)(stepTime / PLANT_INTEGRATION_STEP) + 1u;
+    dt = stepTime / substeps;
+
+    for(i = 0; i < substeps; i++){
+
+        model->seatTemperature += ((power - ((model->seatTemperature - ambientTemperature) / PLANT_THERMAL_RESISTANCE))
+                                   / PLANT_THERMAL_MASS) * dt;
+        model->sensorTemperature += ((model->seatTemperature - model->sensorTemperature) / PLANT_SENSOR_TIME_CONSTANT) * dt;
+
+        report->energy += power * dt;
+        report->time += dt;
+
+        if(report->desiredTemperature != 0){
+
+            error = model->seatTemperature - report->desiredTemperature;
+
+            if(error > report->overshoot){
+
+                report->overshoot = error;
+            }
+
+            if((error > PLANT_SETTLING_BAND) || (error < -PLANT_SETTLING_BAND)){
+
+                model->lastOutsideTime = report->time;
+            }
+        }
+    }
+
+    report->seatTemperature = model->seatTemperature;
+    report->isSettled = (boolean)((report->desiredTemperature != 0)
+                                  && ((report->time - model->lastOutsideTime) >= PLANT_SETTLING_HOLD_TIME));
+    report->settlingTime = model->lastOutsideTime;
+}
+
+
+uint16 PLANT_modelReading(const PLANT_modelType* model, const TEMPSENSOR_calibrationType* calibration, uint8 noise, uint32* seed){
+
+    float32 maxADC = ((float32)ADC_MAX_VALUE * calibration->maxMilliVolt) / TEMPERATURE_V_REF_MILLI_VOLT;
+    float32 adc;
+
+    *seed = (*seed * 1664525ul) + 1013904223ul;
+
+    adc = ((model->sensorTemperature - calibration->minTemperature) * (maxADC - ADC_MIN_VALUE))
+            / (calibration->maxTemperature - calibration->minTemperature) + ADC_MIN_VALUE;
+    adc += (float32)((sint32)((*seed >> 16) % ((2u * noise) + 1u)) - noise);
+
+    if(adc < ADC_MIN_VALUE){
+
+        adc = ADC_MIN_VALUE;
+    }
+    else if(adc > ADC_MAX_VALUE){
+
+        adc = ADC_MAX_VALUE;
+    }
+
+    return (uint16)(adc + 0.5f);
+}
+
+
+float32 PLANT_modePower(heatingMode_Type mode){
+
+    switch(mode){
+
+    case HEATER_LOW:
+        return PLANT_GREEN_POWER;
+
+    case HEATER_MEDIUM:
+        return PLANT_BLUE_POWER;
+
+    case HEATER_HIGH:
+        return PLANT_GREEN_POWER + PLANT_BLUE_POWER;
+
+    default:
+        return 0.0f;
+    }
+}
@@ -0,0 +1,115 @@
+/**********************************************************************************************************
+ *
+ * Module: Plant model
+ *
+ * File Name: PlantModel.h
+ *
+ * Description: Header file of the thermal model of one seat and its sensor, every model is its own instance without
+ *              any RTOS or hardware access, so the Plant module runs one per seat and the host tools run many at once
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_PLANTMODEL_H_
+#define APP_PLANTMODEL_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"HAL/Temperature_sensor.h"
+#include"Control.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Longest integration step in simulated seconds, well below the sensor time constant so the integration is stable */
+#define PLANT_INTEGRATION_STEP          1.0f
+
+/* Heater power in watt of every heater LED (LOW : green, MEDIUM : blue, HIGH : green and blue) */
+#define PLANT_GREEN_POWER               20.0f
+#define PLANT_BLUE_POWER                40.0f
+
+/* Joule per degree of the heated seat surface */
+#define PLANT_THERMAL_MASS              2000.0f
+
+/* Degree per watt between the seat and the cabin */
+#define PLANT_THERMAL_RESISTANCE        0.5f
+
+/* Seconds of the sensor first order lag */
+#define PLANT_SENSOR_TIME_CONSTANT      5.0f
+
+/* The seat is settled once it stays within this band around the desired temperature for the hold time (simulated seconds) */
+#define PLANT_SETTLING_BAND             2.0f
+#define PLANT_SETTLING_HOLD_TIME        60.0f
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    /* Simulated seconds since the metrics restarted */
+    float32 time;
+
+    float32 seatTemperature;
+
+    /* Desired temperature of the seat, 0 if the seat is off */
+    uint8 desiredTemperature;
+
+    boolean isSettled;
+
+    /* Simulated seconds till the seat entered the settling band for the last time */
+    float32 settlingTime;
+
+    /* Highest temperature above the desired temperature */
+    float32 overshoot;
+
+    /* Number of heater power changes */
+    uint32 switches;
+
+    /* Heater energy in joule */
+    float32 energy;
+
+}PLANT_reportType;
+
+typedef struct{
+
+    float32 seatTemperature;
+    float32 sensorTemperature;
+
+    /* Heater power of the last step */
+    float32 power;
+
+    PLANT_reportType report;
+
+    /* Simulated time in which the seat was outside the settling band for the last time */
+    float32 lastOutsideTime;
+
+}PLANT_modelType;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Start the model with the seat and its sensor at the temperature and the heater at the power */
+void PLANT_modelStart(PLANT_modelType* model, float32 temperature, float32 power, uint8 desiredTemperature);
+
+/* Restart the metrics for a new desired temperature (0 if the seat is off) */
+void PLANT_modelRestartMetrics(PLANT_modelType* model, uint8 desiredTemperature);
+
+/* Advance the model by stepTime simulated seconds with the heater power and the cabin (ambient) temperature */
+void PLANT_modelStep(PLANT_modelType* model, float32 power, float32 ambientTemperature, float32 stepTime);
+
+/* Reading of the sensor by the calibration of its zone plus a uniform noise within plus or minus noise ADC counts,
+ * the seed is the state of the noise generator, one per model so the models don't depend on each other
+ */
+uint16 PLANT_modelReading(const PLANT_modelType* model, const TEMPSENSOR_calibrationType* calibration, uint8 noise, uint32* seed);
+
+/* Heater power of the mode, as the heater handler sets the LEDs */
+float32 PLANT_modePower(heatingMode_Type mode);
+
+
+#endif /* APP_PLANTMODEL_H_ */
@@ -0,0 +1,334 @@
+/**********************************************************************************************************
+ *
+ * Module: QueueStats
+ *
+ * File Name: QueueStats.c
+ *
+ * Description: Source file of the statistics of the application queues : throughput, peak depth, time full,
+ *              failed sends and the producers block time and consumers wait time of every registered queue
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"QueueStats.h"
+
+#include<string.h>
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+/* Statistics of one queue, cleared by QSTATS_reset, the times are in cycles */
+typedef struct{
+
+    uint32 sends;
+    uint32 receives;
+    uint32 failedSends;
+    uint32 peakDepth;
+    uint64 fullTime;
+    uint32 producerBlocks;
+    uint64 producerTime;
+    uint32 maxProducerTime;
+    uint32 consumerWaits;
+    uint64 consumerTime;
+    uint32 maxConsumerTime;
+
+}QSTATS_statsType;
+
+typedef struct{
+
+    const char* name;
+    uint32 length;
+    uint32 itemSize;
+    boolean isFull;
+    uint64 fullSince;
+    uint8 producersWaiting;     /* Tasks blocked on sending, their tags are looked up only when it's not 0 */
+    uint8 consumersWaiting;     /* Tasks blocked on receiving */
+    QSTATS_statsType stats;
+
+}QSTATS_queueType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static QSTATS_queueType g_queues[QSTATS_MAX_NUM];
+static uint8 g_queuesNum = 0;
+
+/* Start of the rates, the registration of the first queue or the last reset */
+static uint64 g_startTime = 0;
+
+/* The block of every task (tag) : the number of the queue it blocks on (0 if none), the direction and the first block time */
+static uint8 g_waitNumbers[RUNTIME_MEASUREMENTS_TASKS_NUM];
+static boolean g_isWaitingToSend[RUNTIME_MEASUREMENTS_TASKS_NUM];
+static uint64 g_waitStarts[RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* Snapshot printed by QSTATS_report, static so it isn't on the console stack */
+static QSTATS_statsType g_statsCopy;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static uint8 QSTATS_currentTag(void){
+
+    return (uint8)((uint32)xTaskGetApplicationTaskTag(NULL));
+}
+
+/* End the block of the calling task on the queue if it blocked on it in the same direction, returns the block time in cycles */
+static boolean QSTATS_endWait(uint32 number, boolean isSend, uint32* waitTime){
+
+    uint8 tag = QSTATS_currentTag();
+
+    if((g_waitNumbers[tag] != number) || (g_isWaitingToSend[tag] != isSend)){
+
+        return FALSE;
+    }
+
+    *waitTime = (uint32)(TIMEBASE_getCycles() - g_waitStarts[tag]);
+    g_waitNumbers[tag] = 0;
+
+    return TRUE;
+}
+
+static void QSTATS_endProducerWait(QSTATS_queueType* queue, uint32 number){
+
+    uint32 waitTime;
+
+    if((queue->producersWaiting != 0) && QSTATS_endWait(number, TRUE, &waitTime)){
+
+        queue->producersWaiting--;
+        queue->stats.producerTime += waitTime;
+
+        if(waitTime > queue->stats.maxProducerTime){
+
+            queue->stats.maxProducerTime = waitTime;
+        }
+    }
+}
+
+static void QSTATS_endConsumerWait(QSTATS_queueType* queue, uint32 number){
+
+    uint32 waitTime;
+
+    if((queue->consumersWaiting != 0) && QSTATS_endWait(number, FALSE, &waitTime)){
+
+        queue->consumersWaiting--;
+        queue->stats.consumerTime += waitTime;
+
+        if(waitTime > queue->stats.maxConsumerTime){
+
+            queue->stats.maxConsumerTime = waitTime;
+        }
+    }
+}
+
+/* Print the count per second since the start with one decimal */
+static void QSTATS_sendRate(uint32 count, uint64 elapsedMs){
+
+    uint64 rate = (elapsedMs != 0) ? (((uint64)count * 10000ull) / elapsedMs) : 0;
+
+    UART0_SendInteger(rate / 10u);
+    UART0_SendString(".");
+    UART0_SendInteger(rate % 10u);
+    UART0_SendString("/s");
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void QSTATS_register(QueueHandle_t queue, const char* name, uint32 itemSize){
+
+    QSTATS_queueType* entry;
+
+    if((queue == NULL) || (g_queuesNum == QSTATS_MAX_NUM)){
+
+        return;
+    }
+
+    entry = &g_queues[g_queuesNum];
+    entry->name = name;
+    entry->length = uxQueueSpacesAvailable(queue) + uxQueueMessagesWaiting(queue);
+    entry->itemSize = itemSize;
+
+    if(g_queuesNum == 0){
+
+        g_startTime = TIMEBASE_getCycles();
+    }
+
+    g_queuesNum++;
+
+    vQueueSetQueueNumber(queue, g_queuesNum);
+}
+
+
+void QSTATS_sent(uint32 number, uint32 waiting, uint32 length, boolean isTask){
+
+    QSTATS_queueType* queue = &g_queues[number - 1u];
+
+    queue->stats.sends++;
+
+    /* The message isn't copied yet */
+    waiting++;
+
+    if(waiting > queue->stats.peakDepth){
+
+        queue->stats.peakDepth = waiting;
+    }
+
+    if((waiting == length) && (queue->isFull == FALSE)){
+
+        queue->isFull = TRUE;
+        queue->fullSince = TIMEBASE_getCycles();
+    }
+
+    if(isTask == TRUE){
+
+        QSTATS_endProducerWait(queue, number);
+    }
+}
+
+
+void QSTATS_received(uint32 number, boolean isTask){
+
+    QSTATS_queueType* queue = &g_queues[number - 1u];
+
+    queue->stats.receives++;
+
+    if(queue->isFull == TRUE){
+
+        queue->isFull = FALSE;
+        queue->stats.fullTime += TIMEBASE_getCycles() - queue->fullSince;
+    }
+
+    if(isTask == TRUE){
+
+        QSTATS_endConsumerWait(queue, number);
+    }
+}
+
+
+void QSTATS_sendFailed(uint32 number, boolean isTask){
+
+    QSTATS_queueType* queue = &g_queues[number - 1u];
+
+    queue->stats.failedSends++;
+
+    if(isTask == TRUE){
+
+        QSTATS_endProducerWait(queue, number);
+    }
+}
+
+
+void QSTATS_receiveFailed(uint32 number){
+
+    QSTATS_endConsumerWait(&g_queues[number - 1u], number);
+}
+
+
+void QSTATS_blocking(uint32 number, boolean isSend){
+
+    QSTATS_queueType* queue = &g_queues[number - 1u];
+    uint8 tag = QSTATS_currentTag();
+
+    /* The wait loop of a send or receive blocks again if another task got the space or the message first */
+    if((g_waitNumbers[tag] == number) && (g_isWaitingToSend[tag] == isSend)){
+
+        return;
+    }
+
+    g_waitNumbers[tag] = (uint8)number;
+    g_isWaitingToSend[tag] = isSend;
+    g_waitStarts[tag] = TIMEBASE_getCycles();
+
+    if(isSend == TRUE){
+
+        queue->producersWaiting++;
+        queue->stats.producerBlocks++;
+    }
+    else{
+
+        queue->consumersWaiting++;
+        queue->stats.consumerWaits++;
+    }
+}
+
+
+void QSTATS_reset(void){
+
+    uint8 i;
+
+    taskENTER_CRITICAL();
+
+    for(i = 0; i < g_queuesNum; i++){
+
+        memset(&g_queues[i].stats, 0, sizeof(g_queues[i].stats));
+
+        /* A queue full now is full from the reset */
+        g_queues[i].fullSince = TIMEBASE_getCycles();
+    }
+
+    g_startTime = TIMEBASE_getCycles();
+
+    taskEXIT_CRITICAL();
+}
+
+
+void QSTATS_report(void){
+
+    QSTATS_queueType* queue;
+    uint64 elapsedMs;
+    uint64 fullTime;
+    uint8 i;
+
+    for(i = 0; i < g_queuesNum; i++){
+
+        queue = &g_queues[i];
+
+        taskENTER_CRITICAL();
+
+        g_statsCopy = queue->stats;
+        fullTime = queue->stats.fullTime + ((queue->isFull == TRUE) ? (TIMEBASE_getCycles() - queue->fullSince) : 0);
+        elapsedMs = TIMEBASE_cyclesToUs(TIMEBASE_getCycles() - g_startTime) / 1000u;
+
+        taskEXIT_CRITICAL();
+
+        UART0_SendString((const uint8*)queue->name);
+        UART0_SendString(" : length ");
+        UART0_SendInteger(queue->length);
+        UART0_SendString(" x ");
+        UART0_SendInteger(queue->itemSize);
+        UART0_SendString(" B, peak ");
+        UART0_SendInteger(g_statsCopy.peakDepth);
+        UART0_SendString(" (");
+        UART0_SendInteger((queue->length - g_statsCopy.peakDepth) * queue->itemSize);
+        UART0_SendString(" B unused), full ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(fullTime) / 1000u);
+        UART0_SendString(" ms\r\n  sent ");
+        UART0_SendInteger(g_statsCopy.sends);
+        UART0_SendString(" ");
+        QSTATS_sendRate(g_statsCopy.sends, elapsedMs);
+        UART0_SendString(" received ");
+        UART0_SendInteger(g_statsCopy.receives);
+        UART0_SendString(" ");
+        QSTATS_sendRate(g_statsCopy.receives, elapsedMs);
+        UART0_SendString(" failed ");
+        UART0_SendInteger(g_statsCopy.failedSends);
+        UART0_SendString("\r\n  producer blocks ");
+        UART0_SendInteger(g_statsCopy.producerBlocks);
+        UART0_SendString(" total ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_statsCopy.producerTime));
+        UART0_SendString(" max ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_statsCopy.maxProducerTime));
+        UART0_SendString(" us, consumer waits ");
+        UART0_SendInteger(g_statsCopy.consumerWaits);
+        UART0_SendString(" total ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_statsCopy.consumerTime));
+        UART0_SendString(" max ");
+        UART0_SendInteger(TIMEBASE_cyclesToUs(g_statsCopy.maxConsumerTime));
+        UART0_SendString(" us\r\n");
+    }
+}
@@ -0,0 +1,68 @@
+/**********************************************************************************************************
+ *
+ * Module: QueueStats
+ *
+ * File Name: QueueStats.h
+ *
+ * Description: Header file of the statistics of the application queues : throughput, peak depth, time full,
+ *              failed sends and the producers block time and consumers wait time of every registered queue
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_QUEUESTATS_H_
+#define APP_QUEUESTATS_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Maximum number of registered queues */
+#define QSTATS_MAX_NUM              8u
+
+/*
+ * NOTE:
+ *
+ * A registered queue gets its index + 1 as its trace facility queue number, the queue trace hooks (FreeRTOSConfig.h)
+ * skip every queue whose number is 0 (the mutexes, the timer queue and the unregistered queues) after one compare.
+ *
+ *  peak depth      : the most messages the queue held, (length - peak) * item size bytes could be reclaimed.
+ *  time full       : from the send that filled the queue till the next receive.
+ *  failed sends    : sends that found the queue full and didn't wait or timed out, the message is lost.
+ *  producer block  : a task blocked on sending to the full queue, from its first block till its send or timeout.
+ *  consumer wait   : a task blocked on receiving from the empty queue, from its first block till its receive or timeout.
+ *
+ * The rates are per second since the registration or the last QSTATS_reset.
+ *
+ *  */
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Profile the queue under the name, it must be called once right after creating the queue and before it's used */
+void QSTATS_register(QueueHandle_t queue, const char* name, uint32 itemSize);
+
+/* Called by the queue trace hooks (FreeRTOSConfig.h) with the queue number (and its state before the send),
+ * isTask is FALSE from an interrupt */
+void QSTATS_sent(uint32 number, uint32 waiting, uint32 length, boolean isTask);
+void QSTATS_received(uint32 number, boolean isTask);
+void QSTATS_sendFailed(uint32 number, boolean isTask);
+void QSTATS_receiveFailed(uint32 number);
+void QSTATS_blocking(uint32 number, boolean isSend);
+
+/* Clear the statistics of every queue */
+void QSTATS_reset(void);
+
+/* Print the statistics of every registered queue on UART0 (the caller must own the UART) */
+void QSTATS_report(void);
+
+
+#endif /* APP_QUEUESTATS_H_ */
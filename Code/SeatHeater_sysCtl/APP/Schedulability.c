@@ -0,0 +1,473 @@
+/**********************************************************************************************************
+ *
+ * Module: Schedulability
+ *
+ * File Name: Schedulability.c
+ *
+ * Description: Source file of the response time analysis of the tasks fed by their execution times,
+ *              inter-arrival times and mutex hold times measured on the target
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Schedulability.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+#define SCHED_MS_TO_CYCLES(ms)      ((uint64)(ms) * 1000u * TIMEBASE_CYCLES_PER_US)
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+/* Measurements of one task, written by the trace hooks */
+typedef struct{
+
+    const char* name;
+    uint32 priority;
+    boolean isDeleted;
+    boolean isJobDone;          /* The next switch in starts a new job */
+
+    /* Declared by SCHED_declarePeriod, 0 for an event driven task */
+    uint32 periodMs;
+    uint32 deadlineMs;
+    uint64 periodCycles;
+
+    uint32 jobs;
+    uint32 wakeUpCycles;        /* Execution since the task woke up */
+    uint32 jobCycles;           /* Execution of the wake-ups of the current job */
+    uint32 wcet;                /* Cycles */
+    uint64 jobStart;            /* 0 till the first job */
+    uint64 lastArrival;
+    uint64 minInterArrival;     /* Cycles between two wake-ups, 0 till two wake-ups */
+
+}SCHED_taskType;
+
+/* One task of the analysis, times in micro seconds */
+typedef struct{
+
+    uint8 tag;
+    uint32 priority;
+    uint32 c;
+    uint32 t;
+    uint32 d;
+    uint32 gap;
+    boolean isUsing[CONTENTION_MUTEXES_NUM];
+
+}SCHED_analysedType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static SCHED_taskType g_tasks[RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* Snapshot of the measurements analysed by SCHED_report, static so it isn't on the console stack */
+static SCHED_analysedType g_analysed[RUNTIME_MEASUREMENTS_TASKS_NUM];
+static uint32 g_holdsUs[CONTENTION_MUTEXES_NUM][RUNTIME_MEASUREMENTS_TASKS_NUM];
+static uint8 g_analysedNum;
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Blocking of the analysed task at index by the tasks marked lower, through every mutex used by it or a task marked higher */
+static uint32 SCHED_blocking(uint8 index, const boolean* isHigher, const boolean* isLower){
+
+    uint32 blocking = 0;
+    uint32 longest;
+    boolean isUsed;
+    uint8 m, j;
+
+    for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+        isUsed = g_analysed[index].isUsing[m];
+
+        for(j = 0; j < g_analysedNum; j++){
+
+            isUsed |= (boolean)(isHigher[j] && g_analysed[j].isUsing[m]);
+        }
+
+        if(isUsed == FALSE){
+
+            continue;
+        }
+
+        longest = 0;
+
+        for(j = 0; j < g_analysedNum; j++){
+
+            if(isLower[j] && (g_holdsUs[m][g_analysed[j].tag] > longest)){
+
+                longest = g_holdsUs[m][g_analysed[j].tag];
+            }
+        }
+
+        blocking += longest;
+    }
+
+    return blocking;
+}
+
+/* Worst response time of the analysed task at index with the tasks marked higher preempting it, it's only
+ * calculated till it exceeds the deadline (D) */
+static uint32 SCHED_responseTime(uint8 index, const boolean* isHigher, uint32 blocking){
+
+    uint64 response = (uint64)g_analysed[index].c + blocking;
+    uint64 next;
+    uint8 iteration, j;
+
+    for(iteration = 0; (iteration < SCHED_MAX_ITERATIONS) && (response <= g_analysed[index].d); iteration++){
+
+        next = (uint64)g_analysed[index].c + blocking;
+
+        for(j = 0; j < g_analysedNum; j++){
+
+            if(isHigher[j]){
+
+                next += ((response + g_analysed[j].t - 1u) / g_analysed[j].t) * g_analysed[j].c;
+            }
+        }
+
+        if(next == response){
+
+            break;
+        }
+
+        response = next;
+    }
+
+    return (response > 0xFFFFFFFFul) ? 0xFFFFFFFFul : (uint32)response;
+}
+
+static void SCHED_snapshot(void){
+
+    SCHED_taskType* task;
+    uint8 tag, m;
+
+    g_analysedNum = 0;
+
+    taskENTER_CRITICAL();
+
+    for(tag = 1; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+        task = &g_tasks[tag];
+
+        for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+            g_holdsUs[m][tag] = (uint32)TIMEBASE_cyclesToUs(CONTENTION_getMaxHold(m, tag));
+        }
+
+        /* A task is analysed once it completed a job */
+        if((task->isDeleted == TRUE) || (task->jobs == 0)){
+
+            continue;
+        }
+
+        g_analysed[g_analysedNum].tag = tag;
+        g_analysed[g_analysedNum].priority = task->priority;
+        g_analysed[g_analysedNum].c = (uint32)TIMEBASE_cyclesToUs(task->wcet);
+        g_analysed[g_analysedNum].t = ((task->periodMs != 0) ? task->periodMs : SCHED_SPORADIC_MIN_INTER_ARRIVAL) * 1000u;
+        g_analysed[g_analysedNum].d = ((task->deadlineMs != 0) ? task->deadlineMs * 1000u : g_analysed[g_analysedNum].t);
+        g_analysed[g_analysedNum].gap = (uint32)TIMEBASE_cyclesToUs(task->minInterArrival);
+
+        for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+            g_analysed[g_analysedNum].isUsing[m] = (boolean)(CONTENTION_getMaxHold(m, tag) != 0);
+        }
+
+        g_analysedNum++;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void SCHED_declarePeriod(uint32 periodMs, uint32 deadlineMs){
+
+    uint32 tag = (uint32)xTaskGetApplicationTaskTag(NULL);
+
+    if((tag == 0) || (tag >= RUNTIME_MEASUREMENTS_TASKS_NUM) || (periodMs == 0)){
+
+        return;
+    }
+
+    taskENTER_CRITICAL();
+
+    g_tasks[tag].periodMs = periodMs;
+    g_tasks[tag].deadlineMs = deadlineMs;
+    g_tasks[tag].periodCycles = SCHED_MS_TO_CYCLES(periodMs);
+
+    taskEXIT_CRITICAL();
+}
+
+
+void SCHED_switchedIn(uint32 tag, uint32 priority, const char* name){
+
+    SCHED_taskType* task = &g_tasks[tag];
+    uint64 period;
+    uint64 now;
+
+    if((tag == 0) || (task->isJobDone == FALSE)){
+
+        return;
+    }
+
+    now = TIMEBASE_getCycles();
+
+    if(task->lastArrival != 0){
+
+        if((task->minInterArrival == 0) || ((now - task->lastArrival) < task->minInterArrival)){
+
+            task->minInterArrival = now - task->lastArrival;
+        }
+    }
+
+    /* A wake-up within T of the start of the job is a burst of the same job */
+    period = (task->periodCycles != 0) ? task->periodCycles : SCHED_MS_TO_CYCLES(SCHED_SPORADIC_MIN_INTER_ARRIVAL);
+
+    if((task->jobStart == 0) || ((now - task->jobStart) >= period)){
+
+        task->jobStart = now;
+        task->jobCycles = 0;
+    }
+
+    task->lastArrival = now;
+    task->isJobDone = FALSE;
+    task->name = name;
+    task->priority = priority;
+}
+
+
+void SCHED_switchedOut(uint32 tag, uint32 cycles, boolean isBlocked){
+
+    SCHED_taskType* task = &g_tasks[tag];
+
+    if(tag == 0){
+
+        return;
+    }
+
+    task->wakeUpCycles += cycles;
+
+    /* A wait on a mutex doesn't end the wake-up */
+    if((isBlocked == TRUE) && (CONTENTION_isWaiting(tag) == FALSE)){
+
+        /* The job is complete only when the next wake-up is later than T, so its execution so far is checked every time */
+        task->jobCycles += task->wakeUpCycles;
+        task->wakeUpCycles = 0;
+
+        if(task->jobCycles > task->wcet){
+
+            task->wcet = task->jobCycles;
+        }
+
+        task->jobs++;
+        task->isJobDone = TRUE;
+    }
+}
+
+
+void SCHED_taskDeleted(uint32 tag){
+
+    if(tag < RUNTIME_MEASUREMENTS_TASKS_NUM){
+
+        g_tasks[tag].isDeleted = TRUE;
+    }
+}
+
+
+void SCHED_reset(void){
+
+    uint8 tag;
+
+    taskENTER_CRITICAL();
+
+    for(tag = 0; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+        g_tasks[tag].jobs = 0;
+        g_tasks[tag].wcet = 0;
+        g_tasks[tag].jobStart = 0;
+        g_tasks[tag].lastArrival = 0;
+        g_tasks[tag].minInterArrival = 0;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+
+boolean SCHED_report(void){
+
+    static boolean isHigher[RUNTIME_MEASUREMENTS_TASKS_NUM];
+    static boolean isLower[RUNTIME_MEASUREMENTS_TASKS_NUM];
+    static boolean isAssigned[RUNTIME_MEASUREMENTS_TASKS_NUM];
+    static boolean isPassing[RUNTIME_MEASUREMENTS_TASKS_NUM];
+    static uint8 levels[RUNTIME_MEASUREMENTS_TASKS_NUM];
+    uint32 blocking, response, margin;
+    uint32 minMargin = 100;
+    boolean isSchedulable = TRUE;
+    boolean isFound;
+    uint8 i, j, m, level, levelsNum;
+    uint8 assignedNum = 0;
+
+    SCHED_snapshot();
+
+    UART0_SendString("tag,task,priority,C_us,T_us,D_us,gap_us,B_us,R_us,margin_%,ADC_hold_us,UART_hold_us\r\n");
+
+    /* The current priorities */
+    for(i = 0; i < g_analysedNum; i++){
+
+        for(j = 0; j < g_analysedNum; j++){
+
+            isHigher[j] = (boolean)((j != i) && (g_analysed[j].priority >= g_analysed[i].priority));
+            isLower[j] = (boolean)(g_analysed[j].priority < g_analysed[i].priority);
+        }
+
+        blocking = SCHED_blocking(i, isHigher, isLower);
+        response = SCHED_responseTime(i, isHigher, blocking);
+        margin = (response < g_analysed[i].d) ? (((g_analysed[i].d - response) * 100ull) / g_analysed[i].d) : 0;
+
+        if(response > g_analysed[i].d){
+
+            isSchedulable = FALSE;
+        }
+
+        if(margin < minMargin){
+
+            minMargin = margin;
+        }
+
+        UART0_SendInteger(g_analysed[i].tag);
+        UART0_SendString(",");
+        UART0_SendString((const uint8*)g_tasks[g_analysed[i].tag].name);
+        UART0_SendString(",");
+        UART0_SendInteger(g_analysed[i].priority);
+        UART0_SendString(",");
+        UART0_SendInteger(g_analysed[i].c);
+        UART0_SendString(",");
+        UART0_SendInteger(g_analysed[i].t);
+        UART0_SendString(",");
+        UART0_SendInteger(g_analysed[i].d);
+        UART0_SendString(",");
+        UART0_SendInteger(g_analysed[i].gap);
+        UART0_SendString(",");
+        UART0_SendInteger(blocking);
+        UART0_SendString(",");
+        UART0_SendInteger(response);
+        UART0_SendString(",");
+        UART0_SendInteger(margin);
+
+        for(m = 0; m < CONTENTION_MUTEXES_NUM; m++){
+
+            UART0_SendString(",");
+            UART0_SendInteger(g_holdsUs[m][g_analysed[i].tag]);
+        }
+
+        UART0_SendString("\r\n");
+    }
+
+    UART0_SendString(isSchedulable ? "Schedulable" : "NOT schedulable");
+    UART0_SendString(", minimum margin ");
+    UART0_SendInteger(minMargin);
+    UART0_SendString("%");
+
+    if(isSchedulable && (minMargin < SCHED_MIN_MARGIN_PERCENT)){
+
+        UART0_SendString(" below ");
+        UART0_SendInteger(SCHED_MIN_MARGIN_PERCENT);
+        UART0_SendString("%");
+    }
+
+    UART0_SendString("\r\n");
+
+    /* Audsley's algorithm on shared levels : from the lowest level up, every unassigned task that meets its deadline
+     * with all unassigned tasks at the same or a higher level and all assigned tasks below it gets the level.
+     * The test of a task only depends on the tasks assigned below, so the passing tasks are found before any is assigned
+     */
+    for(i = 0; i < g_analysedNum; i++){
+
+        isAssigned[i] = FALSE;
+    }
+
+    for(level = 0; assignedNum < g_analysedNum; level++){
+
+        for(i = 0; i < g_analysedNum; i++){
+
+            isPassing[i] = FALSE;
+
+            if(isAssigned[i] == TRUE){
+
+                continue;
+            }
+
+            for(j = 0; j < g_analysedNum; j++){
+
+                isHigher[j] = (boolean)((j != i) && (isAssigned[j] == FALSE));
+                isLower[j] = isAssigned[j];
+            }
+
+            isPassing[i] = (boolean)(SCHED_responseTime(i, isHigher, SCHED_blocking(i, isHigher, isLower)) <= g_analysed[i].d);
+        }
+
+        isFound = FALSE;
+
+        for(i = 0; i < g_analysedNum; i++){
+
+            if(isPassing[i] == TRUE){
+
+                isAssigned[i] = TRUE;
+                levels[i] = level;
+                assignedNum++;
+                isFound = TRUE;
+            }
+        }
+
+        if(isFound == FALSE){
+
+            UART0_SendString("No priority assignment meets all deadlines\r\n");
+            return FALSE;
+        }
+    }
+
+    levelsNum = level;
+
+    /* The levels are mapped from SCHED_LOWEST_PRIORITY up, or printed as they are if there are more than the priorities */
+    if(levelsNum > SCHED_PRIORITY_LEVELS){
+
+        UART0_SendString("The deadlines need ");
+        UART0_SendInteger(levelsNum);
+        UART0_SendString(" priority levels, only ");
+        UART0_SendInteger(SCHED_PRIORITY_LEVELS);
+        UART0_SendString(" are available : the assignment can't be mapped\r\n");
+    }
+
+    UART0_SendString("Priority assignment (highest first) :\r\n");
+
+    for(level = levelsNum; level > 0; level--){
+
+        UART0_SendString((levelsNum > SCHED_PRIORITY_LEVELS) ? "  level " : "  priority ");
+        UART0_SendInteger((levelsNum > SCHED_PRIORITY_LEVELS) ? level : ((level - 1u) + SCHED_LOWEST_PRIORITY));
+        UART0_SendString(" :");
+
+        for(i = 0; i < g_analysedNum; i++){
+
+            if(levels[i] == (level - 1u)){
+
+                UART0_SendString(" ");
+                UART0_SendInteger(g_analysed[i].tag);
+                UART0_SendString(" ");
+                UART0_SendString((const uint8*)g_tasks[g_analysed[i].tag].name);
+            }
+        }
+
+        UART0_SendString("\r\n");
+    }
+
+    return (boolean)(isSchedulable && (minMargin >= SCHED_MIN_MARGIN_PERCENT));
+}
@@ -0,0 +1,97 @@
+/**********************************************************************************************************
+ *
+ * Module: Schedulability
+ *
+ * File Name: Schedulability.h
+ *
+ * Description: Header file of the response time analysis of the tasks fed by their execution times,
+ *              inter-arrival times and mutex hold times measured on the target
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_SCHEDULABILITY_H_
+#define APP_SCHEDULABILITY_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+#include"Contention.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* A task whose response time is closer than this percentage of its deadline is reported as low margin */
+#define SCHED_MIN_MARGIN_PERCENT    20u
+
+/* The iterations of one response time calculation are limited so the console never stalls */
+#define SCHED_MAX_ITERATIONS        100u
+
+/* Minimum inter-arrival time in ms of the event driven tasks that don't declare a period (SCHED_declarePeriod),
+ * the inputs arriving within it (ex: a sensor fault then the temperature, a control update of both seats) are one job */
+#define SCHED_SPORADIC_MIN_INTER_ARRIVAL    50u
+
+/* Priorities of the assignment : the idle task keeps priority 0, the tasks share the levels above it */
+#define SCHED_LOWEST_PRIORITY       1u
+#define SCHED_PRIORITY_LEVELS       (configMAX_PRIORITIES - SCHED_LOWEST_PRIORITY)
+
+/*
+ * NOTE:
+ *
+ * The task switch trace hooks measure every task (by its tag) :
+ *
+ *  T             : the declared period of the task (PERIODIC_start or SCHED_declarePeriod), or
+ *                  SCHED_SPORADIC_MIN_INTER_ARRIVAL for an event driven task.
+ *  D             : the declared deadline, or T.
+ *  job           : every wake-up more than T after the start of the previous job starts a job, the wake-ups within T
+ *                  (a burst of messages) belong to the same job. Its execution time doesn't include the preemption
+ *                  by other tasks but includes the interrupts, a wait on a mutex doesn't end a wake-up.
+ *  C (WCET)      : the longest job.
+ *  gap           : the shortest measured time between two wake-ups, for information only.
+ *  hold time     : the longest time a task held ADC_mutex or UART_mutex measured by the contention profiler (Contention.h),
+ *                  it includes the preemption of the holder so it's pessimistic.
+ *
+ * The analysis is the response time analysis of fixed priority preemptive scheduling with priority inheritance :
+ *
+ *  R = C + B + sum over the tasks of higher or same priority of ceil(R / Tj) * Cj, it must not exceed D
+ *
+ * where B is the sum, over every mutex used by the task or a higher priority task, of its longest hold by a lower priority task.
+ *
+ * A priority assignment is found by Audsley's algorithm (lowest priority first) with the same measurements. There are far
+ * fewer priorities (configMAX_PRIORITIES) than tasks, so every level takes all the remaining tasks that meet their
+ * deadlines there, the tasks of one level preempt each other in the analysis as they share it by time slicing. The levels
+ * are mapped on the priorities from SCHED_LOWEST_PRIORITY up, if more levels are needed than there are priorities the report
+ * says the assignment can't be mapped. The blocking by the tasks below isn't monotonic, so it isn't always the fewest levels.
+ *
+ * The rows and the assignment show the tag of every task with its name.
+ *
+ * The timer task and the idle task have no tag, so the timer callbacks (jobs, plant, replay) and the interrupts
+ * aren't separate terms of the analysis.
+ *
+ *  */
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Declare the period and the deadline of the calling task, PERIODIC_start calls it for the periodic tasks */
+void SCHED_declarePeriod(uint32 periodMs, uint32 deadlineMs);
+
+/* Called by the trace hooks (FreeRTOSConfig.h), they must stay short */
+void SCHED_switchedIn(uint32 tag, uint32 priority, const char* name);
+void SCHED_switchedOut(uint32 tag, uint32 cycles, boolean isBlocked);
+void SCHED_taskDeleted(uint32 tag);
+
+/* Clear the measurements of the jobs, the hold times are cleared by CONTENTION_reset */
+void SCHED_reset(void);
+
+/* Analyse the measured tasks and print the result on UART0 (the caller must own the UART),
+ * returns TRUE if all tasks meet their deadlines with the margin */
+boolean SCHED_report(void);
+
+
+#endif /* APP_SCHEDULABILITY_H_ */
@@ -0,0 +1,84 @@
+/**********************************************************************************************************
+ *
+ * Module: Status
+ *
+ * File Name: Status.c
+ *
+ * Description: Source file of the status table of the seats, published by the DataProcessing tasks and read
+ *              by any task or interrupt as a consistent snapshot without queues or mutexes (sequence lock)
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Status.h"
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    volatile uint32 sequence;           /* Odd while the seat is being written, 0 till the first publish */
+    volatile STATUS_seatType seat;
+
+}STATUS_entryType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static STATUS_entryType g_entries[TEMPERATURE_ZONES];
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void STATUS_publish(uint8 instance, const STATUS_seatType* status){
+
+    STATUS_entryType* entry = &g_entries[instance];
+
+    taskENTER_CRITICAL();
+
+    entry->sequence++;
+    entry->seat = *status;
+    entry->sequence++;
+
+    taskEXIT_CRITICAL();
+}
+
+
+boolean STATUS_read(uint8 instance, STATUS_seatType* snapshot){
+
+    const STATUS_entryType* entry = &g_entries[instance];
+    uint32 sequence;
+    uint8 retry;
+
+    for(retry = 0; retry < STATUS_READ_RETRIES; retry++){
+
+        sequence = entry->sequence;
+
+        if(sequence == 0){
+
+            return FALSE;
+        }
+
+        if((sequence & 1u) == 0){
+
+            *snapshot = entry->seat;
+
+            if(entry->sequence == sequence){
+
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+
+uint32 STATUS_getPublishes(uint8 instance){
+
+    return g_entries[instance].sequence / 2u;
+}
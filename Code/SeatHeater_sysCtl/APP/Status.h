@@ -0,0 +1,79 @@
+/**********************************************************************************************************
+ *
+ * Module: Status
+ *
+ * File Name: Status.h
+ *
+ * Description: Header file of the status table of the seats, published by the DataProcessing tasks and read
+ *              by any task or interrupt as a consistent snapshot without queues or mutexes (sequence lock)
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_STATUS_H_
+#define APP_STATUS_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* A read is retried this number of times if a publish of the same seat interrupts it */
+#define STATUS_READ_RETRIES         4u
+
+/*
+ * NOTE:
+ *
+ * Every seat has one entry and a sequence number, the sequence is odd while the entry is being written :
+ *
+ *  publish : sequence + 1, write the entry, sequence + 1, inside a critical section. The DataProcessing task of
+ *            the seat is its only writer, the critical section only keeps the entry whole for the interrupts
+ *            at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *  read    : read the sequence, copy the entry and read the sequence again, the copy is consistent if the sequence
+ *            is even and didn't change, otherwise the read is retried. A reader never blocks nor masks the interrupts,
+ *            it's retried only if a publish preempted it, so STATUS_read is bounded and safe from any task or interrupt.
+ *
+ * The Cortex-M4 is single core, so the volatile accesses of the sequence and the entry are enough to keep their order.
+ *
+ * tools/status_stress.c builds this module on the host and checks every snapshot of reader threads against writer threads.
+ *
+ *  */
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    uint8 currentTemperature;
+    desiredTemp_Type desiredTemperature;
+    heatingMode_Type desiredLevel;
+    heatingMode_Type mode;              /* Heater mode decided, TEMPERATURE_SENSOR_FAILURE if the sensor is faulty */
+    TickType_t tick;                    /* Tick of the decision */
+
+}STATUS_seatType;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Publish the status of the seat, only the DataProcessing task of the seat may call it */
+void STATUS_publish(uint8 instance, const STATUS_seatType* status);
+
+/* Copy a consistent snapshot of the seat, it can be called from any task or interrupt,
+ * returns FALSE if the seat is never published or every retry was interrupted by a publish (only possible in an interrupt
+ * above configMAX_SYSCALL_INTERRUPT_PRIORITY)
+ */
+boolean STATUS_read(uint8 instance, STATUS_seatType* snapshot);
+
+/* Number of publishes of the seat since the start-up */
+uint32 STATUS_getPublishes(uint8 instance);
+
+
+#endif /* APP_STATUS_H_ */
@@ -0,0 +1,113 @@
+/**********************************************************************************************************
+ *
+ * Module: Supervisor
+ *
+ * File Name: Supervisor.c
+ *
+ * Description: Source file of the tasks heartbeat supervisor that feeds the hardware watchdog
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Supervisor.h"
+#include"Periodic.h"
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+volatile uint32 SUPERVISOR_heartbeats[SUPERVISOR_TASKS_NUM];
+
+/* Longest time in ticks between two check-ins of every task, zero if the task isn't registered */
+static TickType_t g_periods[SUPERVISOR_TASKS_NUM];
+
+/* Heartbeat counter seen in the last check and the tick count in which it was changed */
+static uint32 g_lastHeartbeats[SUPERVISOR_TASKS_NUM];
+static TickType_t g_lastCheckIns[SUPERVISOR_TASKS_NUM];
+
+static const char* const g_names[SUPERVISOR_TASKS_NUM] = {
+
+    "Runtime measurements",
+    "Driver temperature monitoring", "Passenger temperature monitoring",
+    "Driver button monitoring", "Passenger button monitoring",
+    "Driver heating level monitoring", "Passenger heating level monitoring",
+    "Driver data processing", "Passenger data processing",
+    "Driver heater handler", "Passenger heater handler",
+    "Console", "NVM writer"
+};
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void SUPERVISOR_register(SUPERVISOR_idType id, uint32 periodMs){
+
+    if(id < SUPERVISOR_TASKS_NUM){
+
+        /* The supervisor must never see the new period with the check-in of an old registration */
+        taskENTER_CRITICAL();
+        g_lastHeartbeats[id] = SUPERVISOR_heartbeats[id];
+        g_lastCheckIns[id] = xTaskGetTickCount();
+        g_periods[id] = pdMS_TO_TICKS(periodMs);
+        taskEXIT_CRITICAL();
+    }
+}
+
+/****************************************************************************
+ *                               Tasks definition
+ * ************************************************************************/
+
+void vSupervisorTask( void * pvParameters ){
+
+    static PERIODIC_taskType periodic;
+    TickType_t now;
+    uint32 heartbeat;
+    uint8 id;
+
+    /* Once a task is found dead the watchdog is never fed again even if the task recovers */
+    boolean isAlive = TRUE;
+
+    PERIODIC_start(&periodic, "Supervisor", SUPERVISOR_PERIOD, SUPERVISOR_DEADLINE);
+
+    while(1){
+
+        PERIODIC_waitRelease(&periodic);
+
+        now = xTaskGetTickCount();
+
+        for(id = 0; (id < SUPERVISOR_TASKS_NUM) && (isAlive == TRUE); id++){
+
+            if(g_periods[id] == 0){
+
+                continue;
+            }
+
+            heartbeat = SUPERVISOR_heartbeats[id];
+
+            if(heartbeat != g_lastHeartbeats[id]){
+
+                g_lastHeartbeats[id] = heartbeat;
+                g_lastCheckIns[id] = now;
+            }
+            else if((now - g_lastCheckIns[id]) > g_periods[id]){
+
+                isAlive = FALSE;
+
+                /* The UART mutex may be held by the dead task, so the message is sent directly */
+                taskENTER_CRITICAL();
+                UART0_SendString("Supervisor : ");
+                UART0_SendString((const uint8*)g_names[id]);
+                UART0_SendString(" task stopped, the watchdog will reset the system\r\n");
+                taskEXIT_CRITICAL();
+            }
+        }
+
+        if(isAlive == TRUE){
+
+            WDT0_feed();
+        }
+
+        PERIODIC_complete(&periodic);
+    }
+}
@@ -0,0 +1,98 @@
+/**********************************************************************************************************
+ *
+ * Module: Supervisor
+ *
+ * File Name: Supervisor.h
+ *
+ * Description: Header file of the tasks heartbeat supervisor that feeds the hardware watchdog
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_SUPERVISOR_H_
+#define APP_SUPERVISOR_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+#include"MCAL/WDT.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Period of checking the heartbeats of all tasks and feeding the watchdog, and the deadline from every release */
+#define SUPERVISOR_PERIOD               100
+#define SUPERVISOR_DEADLINE             10
+
+/* The watchdog interrupts after this time without feeding (heaters to safe state) and resets the system after twice this time */
+#define SUPERVISOR_WATCHDOG_TIMEOUT     500
+
+/* Added to the longest wait of a task for the preemption by higher priority tasks and its own processing */
+#define SUPERVISOR_CHECK_IN_MARGIN      1000
+
+/*
+ * NOTE:
+ *
+ * Every supervised task registers the longest time between two of its check-ins once at its start,
+ * then checks in once every loop. The supervisor feeds the watchdog only while every registered task checked in
+ * within its period, once any task misses its period the watchdog is never fed again so the heaters are driven
+ * to the safe state by the watchdog interrupt and the system is reset.
+ *
+ * Event driven tasks must block for at most TASK_CHECK_IN_PERIOD so they check in even when there are no events.
+ *
+ *  */
+
+/* Check in of a task, one increment of its own counter so it's a few cycles and it's never shared with another writer */
+#define SUPERVISOR_CHECK_IN(id)         (SUPERVISOR_heartbeats[(id)]++)
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+/* Every shared task function adds its instance (0>driver, 1>passenger) to the driver identifier */
+typedef enum{
+
+    SUPERVISOR_RUNTIME_MEASUREMENTS,
+    SUPERVISOR_TEMPERATURE_MONITORING_DRIVER,
+    SUPERVISOR_TEMPERATURE_MONITORING_PASSENGER,
+    SUPERVISOR_BUTTON_MONITORING_DRIVER,
+    SUPERVISOR_BUTTON_MONITORING_PASSENGER,
+    SUPERVISOR_HEATING_LEVEL_MONITORING_DRIVER,
+    SUPERVISOR_HEATING_LEVEL_MONITORING_PASSENGER,
+    SUPERVISOR_DATA_PROCESSING_DRIVER,
+    SUPERVISOR_DATA_PROCESSING_PASSENGER,
+    SUPERVISOR_HEATER_HANDLER_DRIVER,
+    SUPERVISOR_HEATER_HANDLER_PASSENGER,
+    SUPERVISOR_CONSOLE,
+    SUPERVISOR_NVM_WRITER,
+    SUPERVISOR_TASKS_NUM
+
+}SUPERVISOR_idType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* Check-ins counter of every supervised task (indexed by its identifier) */
+extern volatile uint32 SUPERVISOR_heartbeats[SUPERVISOR_TASKS_NUM];
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Supervise the calling task from now, it must check in at least once every period (in ms) */
+void SUPERVISOR_register(SUPERVISOR_idType id, uint32 periodMs);
+
+/****************************************************************************
+ *                               Tasks prototype
+ * ************************************************************************/
+
+/* Check the heartbeats of the registered tasks periodically and feed the watchdog while all of them are alive */
+void vSupervisorTask( void * pvParameters );
+
+
+#endif /* APP_SUPERVISOR_H_ */
@@ -0,0 +1,373 @@
+/**********************************************************************************************************
+ *
+ * Module: Telemetry
+ *
+ * File Name: Telemetry.c
+ *
+ * Description: Source file of the binary telemetry, a snapshot of both seats, the CPU load and the queue depths
+ *              is sent periodically on UART0 as a COBS framed binary record with a CRC instead of the text logs
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Telemetry.h"
+#include"Status.h"
+#include"timers.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Bytes covered by the CRC */
+#define TELEMETRY_CRC_OFFSET        (TELEMETRY_PAYLOAD_SIZE - 2u)
+
+/* Longest text line of the snapshot */
+#define TELEMETRY_TEXT_LINE_SIZE    80u
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static TimerHandle_t g_snapshotTimer = NULL;
+static volatile boolean g_isRunning = FALSE;
+static uint32 g_periodMs = TELEMETRY_DEFAULT_PERIOD;
+
+/* Log level of the text mode, restored at the stop */
+static logLevel_Type g_textLogLevel = LOG_NORMAL;
+
+static uint16 g_sequence = 0;
+
+/* Busy time of the tasks and cycles at the previous snapshot, for the CPU load between two snapshots */
+static uint64 g_lastBusyCycles = 0;
+static uint64 g_lastCycles = 0;
+
+static uint32 g_frames = 0;
+static uint32 g_skipped = 0;
+static uint32 g_bytes = 0;
+static uint32 g_textBytes = 0;
+static uint32 g_encodeMaxCycles = 0;
+
+/* Used by the timer task only, they are static to keep its stack small */
+static uint8 g_frame[TELEMETRY_FRAME_SIZE];
+static uint8 g_textLine[TELEMETRY_TEXT_LINE_SIZE];
+
+static const char* const g_seatNames[TEMPERATURE_ZONES] = {"Driver", "Passenger"};
+static const char* const g_modeTexts[] = {"OFF", "on LOW intensity", "on MEDIUM intensity", "on HIGH intensity", "OFF (sensor failure)"};
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* CRC-16/CCITT-FALSE calculated bit by bit as the snapshot is small */
+static uint16 TELEMETRY_crc16(const uint8* pData, uint32 length){
+
+    uint16 crc = 0xFFFFu;
+    uint32 i;
+    uint8 bit;
+
+    for(i = 0; i < length; i++){
+
+        crc ^= (uint16)((uint16)pData[i] << 8);
+
+        for(bit = 0; bit < 8; bit++){
+
+            crc = (crc & 0x8000u) ? (uint16)((crc << 1) ^ 0x1021u) : (uint16)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/* Consistent overhead byte stuffing, every 0x00 is replaced by the distance to the next one, returns the encoded length */
+static uint8 TELEMETRY_cobs(const uint8* data, uint8 length, uint8* encoded){
+
+    uint8 codeIndex = 0;
+    uint8 index = 1;
+    uint8 code = 1;
+    uint8 i;
+
+    for(i = 0; i < length; i++){
+
+        if(data[i] == 0){
+
+            encoded[codeIndex] = code;
+            codeIndex = index++;
+            code = 1;
+        }
+        else{
+
+            encoded[index++] = data[i];
+            code++;
+
+            if(code == 0xFFu){
+
+                encoded[codeIndex] = code;
+                codeIndex = index++;
+                code = 1;
+            }
+        }
+    }
+
+    encoded[codeIndex] = code;
+
+    return index;
+}
+
+static void TELEMETRY_put16(uint8* buffer, uint16 value){
+
+    buffer[0] = (uint8)value;
+    buffer[1] = (uint8)(value >> 8);
+}
+
+static void TELEMETRY_put32(uint8* buffer, uint32 value){
+
+    buffer[0] = (uint8)value;
+    buffer[1] = (uint8)(value >> 8);
+    buffer[2] = (uint8)(value >> 16);
+    buffer[3] = (uint8)(value >> 24);
+}
+
+static uint8 TELEMETRY_queueDepth(QueueHandle_t queue){
+
+    return (queue != NULL) ? (uint8)uxQueueMessagesWaiting(queue) : 0;
+}
+
+/* CPU load since the previous snapshot in per mille */
+static uint16 TELEMETRY_cpuLoad(void){
+
+    uint64 busyCycles = 0;
+    uint64 cycles;
+    uint64 load = 0;
+    uint8 tag;
+
+    taskENTER_CRITICAL();
+
+    for(tag = 1; tag < RUNTIME_MEASUREMENTS_TASKS_NUM; tag++){
+
+        busyCycles += ullTasksTotalTime[tag];
+    }
+
+    taskEXIT_CRITICAL();
+
+    cycles = TIMEBASE_getCycles();
+
+    if((cycles > g_lastCycles) && (busyCycles >= g_lastBusyCycles)){
+
+        load = ((busyCycles - g_lastBusyCycles) * 1000u) / (cycles - g_lastCycles);
+    }
+
+    g_lastBusyCycles = busyCycles;
+    g_lastCycles = cycles;
+
+    return (uint16)((load > 1000u) ? 1000u : load);
+}
+
+static void TELEMETRY_snapshot(uint8* payload){
+
+    STATUS_seatType status;
+    uint8* seat;
+    uint8 zone;
+
+    payload[0] = TELEMETRY_RECORD_SNAPSHOT;
+    TELEMETRY_put16(&payload[1], g_sequence++);
+    TELEMETRY_put32(&payload[3], xTaskGetTickCount());
+    TELEMETRY_put16(&payload[7], TELEMETRY_cpuLoad());
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        seat = &payload[9u + (4u * zone)];
+
+        seat[3] = (uint8)(((uint8)TEMPSENSOR_getLastFault(zone) & 0x07u) << TELEMETRY_FLAG_LAST_FAULT_SHIFT);
+        seat[3] |= (TEMPSENSOR_isFaulty(zone) == TRUE) ? TELEMETRY_FLAG_FAULTY : 0u;
+        seat[3] |= (TEMPSENSOR_isFaultPending(zone) == TRUE) ? TELEMETRY_FLAG_FAULT_PENDING : 0u;
+
+        if(STATUS_read(zone, &status) == TRUE){
+
+            seat[0] = status.currentTemperature;
+            seat[1] = (uint8)status.desiredTemperature;
+            seat[2] = (uint8)status.mode;
+        }
+        else{
+
+            seat[0] = 0;
+            seat[1] = 0;
+            seat[2] = 0;
+            seat[3] |= TELEMETRY_FLAG_NO_STATUS;
+        }
+    }
+
+    payload[17] = TELEMETRY_queueDepth(Q_inputDriver);
+    payload[18] = TELEMETRY_queueDepth(Q_inputPassenger);
+    payload[19] = TELEMETRY_queueDepth(Q_heatingModeDriver);
+    payload[20] = TELEMETRY_queueDepth(Q_heatingModePassenger);
+
+    TELEMETRY_put16(&payload[TELEMETRY_CRC_OFFSET], TELEMETRY_crc16(payload, TELEMETRY_CRC_OFFSET));
+}
+
+/* Length of the text lines carrying the same snapshot in the text mode */
+static uint32 TELEMETRY_textLength(const uint8* payload){
+
+    const uint8* seat;
+    uint32 length = 0;
+    uint8 zone;
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        seat = &payload[9u + (4u * zone)];
+
+        length += FORMAT_print(g_textLine, sizeof(g_textLine), "Current temperature of %s seat is : %u degree celsius\r\n",
+                               g_seatNames[zone], seat[0]);
+
+        if(seat[1] == (uint8)LEVEL0){
+
+            length += FORMAT_print(g_textLine, sizeof(g_textLine), "Desired temperature of %s seat heater is : OFF\r\n", g_seatNames[zone]);
+        }
+        else{
+
+            length += FORMAT_print(g_textLine, sizeof(g_textLine), "Desired temperature of %s seat heater is : %u degree celsius\r\n",
+                                   g_seatNames[zone], seat[1]);
+        }
+
+        length += FORMAT_print(g_textLine, sizeof(g_textLine), "Heater of the %s seat is %s\r\n",
+                               g_seatNames[zone], g_modeTexts[(seat[2] <= TEMPERATURE_SENSOR_FAILURE) ? seat[2] : HEATER_OFF]);
+    }
+
+    length += FORMAT_print(g_textLine, sizeof(g_textLine), "CPU Load is %u%% \r\n", (payload[7] | (payload[8] << 8)) / 10u);
+
+    return length;
+}
+
+static void TELEMETRY_snapshotCallback(TimerHandle_t timer){
+
+    uint8 payload[TELEMETRY_PAYLOAD_SIZE];
+    uint32 cycles;
+    uint8 length;
+
+    (void)timer;
+
+    cycles = TIMEBASE_DWT_CYCCNT;
+
+    TELEMETRY_snapshot(payload);
+
+    g_frame[0] = 0;
+    length = 1u + TELEMETRY_cobs(payload, TELEMETRY_PAYLOAD_SIZE, &g_frame[1]);
+    g_frame[length++] = 0;
+
+    cycles = TIMEBASE_DWT_CYCCNT - cycles;
+
+    if(cycles > g_encodeMaxCycles){
+
+        g_encodeMaxCycles = cycles;
+    }
+
+    /* The timer task never waits, the sequence gap tells the host a frame is skipped */
+    if(xSemaphoreTake(UART_mutex, 0) != pdTRUE){
+
+        g_skipped++;
+        return;
+    }
+
+    UART0_SendData(g_frame, length);
+
+    xSemaphoreGive(UART_mutex);
+
+    g_frames++;
+    g_bytes += length;
+    g_textBytes += TELEMETRY_textLength(payload);
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void TELEMETRY_init(void){
+
+    g_snapshotTimer = xTimerCreate("Telemetry", pdMS_TO_TICKS(TELEMETRY_DEFAULT_PERIOD), pdTRUE, NULL, TELEMETRY_snapshotCallback);
+}
+
+
+boolean TELEMETRY_start(uint32 periodMs){
+
+    if((periodMs < TELEMETRY_MIN_PERIOD) || (periodMs > TELEMETRY_MAX_PERIOD) || (g_snapshotTimer == NULL)){
+
+        return FALSE;
+    }
+
+    if(g_isRunning == FALSE){
+
+        g_textLogLevel = g_logLevel;
+        g_logLevel = LOG_QUIET;
+
+        g_frames = 0;
+        g_skipped = 0;
+        g_bytes = 0;
+        g_textBytes = 0;
+        g_encodeMaxCycles = 0;
+    }
+
+    g_periodMs = periodMs;
+    g_isRunning = TRUE;
+
+    /* Changing the period starts the timer too */
+    xTimerChangePeriod(g_snapshotTimer, pdMS_TO_TICKS(periodMs), 0);
+
+    return TRUE;
+}
+
+
+void TELEMETRY_stop(void){
+
+    if(g_isRunning == TRUE){
+
+        xTimerStop(g_snapshotTimer, 0);
+        g_isRunning = FALSE;
+        g_logLevel = g_textLogLevel;
+    }
+}
+
+
+boolean TELEMETRY_isRunning(void){
+
+    return g_isRunning;
+}
+
+
+void TELEMETRY_report(void){
+
+    uint8 text[FORMAT_NUMBER_SIZE];
+
+    UART0_SendString("telemetry ");
+    UART0_SendString((g_isRunning == TRUE) ? "on" : "off");
+    UART0_SendString(" period_ms=");
+    UART0_SendInteger(g_periodMs);
+    UART0_SendString(" frames=");
+    UART0_SendInteger(g_frames);
+    UART0_SendString(" skipped=");
+    UART0_SendInteger(g_skipped);
+    UART0_SendString(" bytes=");
+    UART0_SendInteger(g_bytes);
+    UART0_SendString(" text_bytes=");
+    UART0_SendInteger(g_textBytes);
+    UART0_SendString(" reduction=");
+
+    if(g_bytes != 0){
+
+        FORMAT_decimal(text, (sint32)(((uint64)g_textBytes * 10u) / g_bytes), 1);
+        UART0_SendString(text);
+    }
+    else{
+
+        UART0_SendString("-");
+    }
+
+    UART0_SendString("\r\ntelemetry frame_bytes=");
+    UART0_SendInteger(TELEMETRY_FRAME_SIZE);
+    UART0_SendString(" bytes_per_s=");
+    UART0_SendInteger((TELEMETRY_FRAME_SIZE * 1000u) / g_periodMs);
+    UART0_SendString(" text_bytes_per_s=");
+    UART0_SendInteger((g_frames != 0) ? (((uint64)g_textBytes * 1000u) / ((uint64)g_frames * g_periodMs)) : 0);
+    UART0_SendString(" encode_max_cycles=");
+    UART0_SendInteger(g_encodeMaxCycles);
+    UART0_SendString("\r\n");
+}
@@ -0,0 +1,92 @@
+/**********************************************************************************************************
+ *
+ * Module: Telemetry
+ *
+ * File Name: Telemetry.h
+ *
+ * Description: Header file of the binary telemetry, a snapshot of both seats, the CPU load and the queue depths
+ *              is sent periodically on UART0 as a COBS framed binary record with a CRC instead of the text logs
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_TELEMETRY_H_
+#define APP_TELEMETRY_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Range and default of the period between two snapshots in ms */
+#define TELEMETRY_MIN_PERIOD        20u
+#define TELEMETRY_MAX_PERIOD        10000u
+#define TELEMETRY_DEFAULT_PERIOD    100u
+
+/* Kind of the record (first payload byte) */
+#define TELEMETRY_RECORD_SNAPSHOT   1u
+
+/* Snapshot payload including the CRC, and the frame on the wire (delimiters and COBS overhead byte) */
+#define TELEMETRY_PAYLOAD_SIZE      23u
+#define TELEMETRY_FRAME_SIZE        (TELEMETRY_PAYLOAD_SIZE + 3u)
+
+/* Fault flags of a seat */
+#define TELEMETRY_FLAG_FAULTY           (1u << 0)   /* Debounced sensor fault */
+#define TELEMETRY_FLAG_FAULT_PENDING    (1u << 1)   /* Fault or recovery being confirmed */
+#define TELEMETRY_FLAG_LAST_FAULT_SHIFT 2u          /* Bits 2 to 4 : last confirmed TEMPSENSOR_faultType */
+#define TELEMETRY_FLAG_NO_STATUS        (1u << 7)   /* The seat has no decision yet, its temperatures and mode are 0 */
+
+/*
+ * NOTE:
+ *
+ * Snapshot payload, multi-byte fields are little endian :
+ *
+ *   0      kind (TELEMETRY_RECORD_SNAPSHOT)
+ *   1-2    sequence, incremented for every snapshot so a gap is a lost frame
+ *   3-6    tick
+ *   7-8    CPU load since the previous snapshot in per mille (all tasks except the idle and timer tasks)
+ *   9-12   driver : current temperature, desired temperature, heater mode (heatingMode_Type), fault flags
+ *   13-16  passenger : same as the driver
+ *   17-20  waiting messages of Q_inputDriver, Q_inputPassenger, Q_heatingModeDriver and Q_heatingModePassenger
+ *   21-22  CRC-16/CCITT-FALSE (polynomial 0x1021, initial 0xFFFF) of bytes 0 to 20
+ *
+ * The payload is COBS encoded (no 0x00 byte inside) and sent between two 0x00 delimiters, so the receiver resyncs
+ * at any 0x00, and a console reply between two frames is a chunk that fails the CRC and is dropped.
+ *
+ * The text logs are turned off (log 0) while the telemetry runs and restored when it stops. The bandwidth reduction
+ * compares every frame with the text lines of the same snapshot (temperature, desired temperature and heater lines
+ * of both seats and the CPU load line).
+ *
+ * The snapshot is sent from the timer task, it's skipped if the UART is in use as the timer task never blocks.
+ *
+ * tools/telemetry_decode.py converts a raw capture of UART0 into CSV with the statistics of the capture.
+ *
+ *  */
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Create the snapshot timer, it must be called before the scheduler starts */
+void TELEMETRY_init(void);
+
+/* Start (or change the period of) the binary telemetry, returns FALSE if the period is out of range */
+boolean TELEMETRY_start(uint32 periodMs);
+
+/* Stop the binary telemetry and restore the text logs */
+void TELEMETRY_stop(void);
+
+/* TRUE while the binary frames are sent */
+boolean TELEMETRY_isRunning(void);
+
+/* Print the state, frames, skipped frames, bytes, text equivalent bytes and encode cycles on UART0 (the caller must own the UART) */
+void TELEMETRY_report(void);
+
+
+#endif /* APP_TELEMETRY_H_ */
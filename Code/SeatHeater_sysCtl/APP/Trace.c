@@ -0,0 +1,210 @@
+/**********************************************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: Trace.c
+ *
+ * Description: Source file of the record and replay of the sensors readings, button presses and heater changes
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#include"Trace.h"
+#include"timers.h"
+#include"QueueStats.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Split so it doesn't overflow before the tick count itself */
+#define TRACE_TICKS_TO_MS(ticks)    ((((ticks) / configTICK_RATE_HZ) * 1000ul) + ((((ticks) % configTICK_RATE_HZ) * 1000ul) / configTICK_RATE_HZ))
+
+#define TRACE_BUTTON_BITS           (EVENTGROUP_DRIVER_SEAT_BIT | EVENTGROUP_DRIVER_WHEEL_BIT | EVENTGROUP_PASSENGER_SEAT_BIT)
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+volatile TRACE_modeType TRACE_mode = TRACE_OFF;
+
+/* Ring of the last events, g_head is where the next event is written */
+static TRACE_eventType g_events[TRACE_EVENTS_SIZE];
+static uint8 g_head = 0;
+static uint8 g_eventsNum = 0;
+
+/* Tick count in which the recording or replay started */
+static TickType_t g_startTime;
+
+static QueueHandle_t g_replayQueue;
+static TimerHandle_t g_replayTimer;
+
+/* Last replayed reading of every zone, the real reading is used till the first one is replayed */
+static uint16 g_replayedADC[TEMPERATURE_ZONES];
+static boolean g_isADCReplayed[TEMPERATURE_ZONES];
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static uint32 TRACE_now(void){
+
+    return TRACE_TICKS_TO_MS(xTaskGetTickCount() - g_startTime);
+}
+
+/* Feed the event through the same path as the real input */
+static void TRACE_apply(const TRACE_eventType* event){
+
+    switch(event->type){
+
+    case TRACE_EVENT_ADC:
+
+        g_replayedADC[event->id] = event->value;
+        g_isADCReplayed[event->id] = TRUE;
+
+#if (APP_PERIODIC_JOBS == 0)
+        /* Same as the comparator interrupt, the monitoring task reads the zone (the job reads it at its next release) */
+        xTaskNotifyGive((event->id == TEMPERATURE_DRIVER_WINDOW) ? task2handle : task3handle);
+#endif
+        break;
+
+    case TRACE_EVENT_BUTTON:
+
+        xEventGroupSetBits(PB_group, event->value & TRACE_BUTTON_BITS);
+        break;
+    }
+}
+
+/* Runs in the timer task every TRACE_REPLAY_RESOLUTION while replaying, so it must never block */
+static void TRACE_replayCallback(TimerHandle_t xTimer){
+
+    TRACE_eventType event;
+    uint32 now = TRACE_now();
+
+    while((xQueuePeek(g_replayQueue, &event, 0) == pdTRUE) && (event.time <= now)){
+
+        xQueueReceive(g_replayQueue, &event, 0);
+        TRACE_apply(&event);
+    }
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+void TRACE_init(void){
+
+    g_replayQueue = xQueueCreate(TRACE_REPLAY_QUEUE_SIZE, sizeof(TRACE_eventType));
+    QSTATS_register(g_replayQueue, "traceReplay", sizeof(TRACE_eventType));
+    g_replayTimer = xTimerCreate("Trace replay", pdMS_TO_TICKS(TRACE_REPLAY_RESOLUTION), pdTRUE, NULL, TRACE_replayCallback);
+}
+
+void TRACE_setMode(TRACE_modeType mode){
+
+    uint8 zone;
+
+    xTimerStop(g_replayTimer, 0);
+    xQueueReset(g_replayQueue);
+
+    taskENTER_CRITICAL();
+
+    if(mode != TRACE_OFF){
+
+        g_head = 0;
+        g_eventsNum = 0;
+        g_startTime = xTaskGetTickCount();
+    }
+
+    for(zone = 0; zone < TEMPERATURE_ZONES; zone++){
+
+        g_isADCReplayed[zone] = FALSE;
+    }
+
+    TRACE_mode = mode;
+
+    taskEXIT_CRITICAL();
+
+    if(mode == TRACE_REPLAY){
+
+        xTimerStart(g_replayTimer, 0);
+    }
+}
+
+void TRACE_record(TRACE_eventIdType type, uint8 id, uint16 value){
+
+    TRACE_eventType* event;
+
+    if(TRACE_mode == TRACE_OFF){
+
+        return;
+    }
+
+    taskENTER_CRITICAL();
+
+    event = &g_events[g_head];
+    event->time = TRACE_now();
+    event->type = type;
+    event->id = id;
+    event->value = value;
+
+    /* The oldest event is overwritten when the ring is full */
+    g_head = (g_head + 1u) % TRACE_EVENTS_SIZE;
+
+    if(g_eventsNum < TRACE_EVENTS_SIZE){
+
+        g_eventsNum++;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+uint16 TRACE_adcSample(uint8 zone, uint16 adc){
+
+    if((TRACE_mode == TRACE_REPLAY) && (zone < TEMPERATURE_ZONES) && (g_isADCReplayed[zone] == TRUE)){
+
+        adc = g_replayedADC[zone];
+    }
+
+    TRACE_record(TRACE_EVENT_ADC, zone, adc);
+
+    return adc;
+}
+
+boolean TRACE_play(const TRACE_eventType* event){
+
+    if((TRACE_mode != TRACE_REPLAY) || (event->type >= TRACE_EVENT_TYPES) || (event->id >= TEMPERATURE_ZONES)){
+
+        return FALSE;
+    }
+
+    /* The outputs are accepted so a whole dump can be played, they are produced again by the replay */
+    if(event->type == TRACE_EVENT_HEATER){
+
+        return TRUE;
+    }
+
+    return (boolean)(xQueueSend(g_replayQueue, event, 0) == pdTRUE);
+}
+
+uint8 TRACE_getEventsNum(void){
+
+    return g_eventsNum;
+}
+
+boolean TRACE_getEvent(uint8 index, TRACE_eventType* event){
+
+    boolean isFound = FALSE;
+
+    taskENTER_CRITICAL();
+
+    if(index < g_eventsNum){
+
+        *event = g_events[(g_head + TRACE_EVENTS_SIZE - g_eventsNum + index) % TRACE_EVENTS_SIZE];
+        isFound = TRUE;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return isFound;
+}
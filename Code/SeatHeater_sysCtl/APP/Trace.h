@@ -0,0 +1,114 @@
+/**********************************************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: Trace.h
+ *
+ * Description: Header file of the record and replay of the sensors readings, button presses and heater changes
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+#ifndef APP_TRACE_H_
+#define APP_TRACE_H_
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include"APP.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/*
+ * NOTE:
+ *
+ * Record : every ADC reading used by the monitoring tasks, every button press received by the button tasks
+ * and every change of a heater are kept with their time in ms since the recording started
+ * (the last TRACE_EVENTS_SIZE events), the console dumps them as "<ms> <adc|button|heater> <id> <value>".
+ *
+ * Replay : the real sensors readings and button presses are ignored, the console queues the events
+ * ("play" followed by a dumped line) and they are applied at their time (TRACE_REPLAY_RESOLUTION) since the replay started
+ * through the same paths as the real inputs, meanwhile the events are recorded again so the dump of the replay
+ * can be compared with the dump of the recording. The heater events of a played dump are ignored.
+ *
+ *  */
+
+/* Number of the last events kept */
+#define TRACE_EVENTS_SIZE           64u
+
+/* Number of events queued for replay, the console refuses the events while it's full */
+#define TRACE_REPLAY_QUEUE_SIZE     16u
+
+/* Period of applying the due replay events */
+#define TRACE_REPLAY_RESOLUTION     10
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef enum{
+
+    TRACE_OFF,
+    TRACE_RECORD,
+    TRACE_REPLAY
+
+}TRACE_modeType;
+
+typedef enum{
+
+    TRACE_EVENT_ADC,        /* id is the zone and value is the ADC reading */
+    TRACE_EVENT_BUTTON,     /* id is the seat and value is the push buttons event group bits */
+    TRACE_EVENT_HEATER,     /* id is the seat and value is the new heating mode */
+    TRACE_EVENT_TYPES
+
+}TRACE_eventIdType;
+
+typedef struct{
+
+    /* ms since the recording or the replay started */
+    uint32 time;
+
+    uint8 type;
+    uint8 id;
+    uint16 value;
+
+}TRACE_eventType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+/* Read by the push buttons ISRs so the real presses are ignored while replaying */
+extern volatile TRACE_modeType TRACE_mode;
+
+/****************************************************************************
+ *                             Functions prototype
+ * ************************************************************************/
+
+/* Create the replay queue and timer, must be called before the scheduler starts */
+void TRACE_init(void);
+
+/* Recording and replaying clear the recorded events and restart the time, stopping keeps them for the dump */
+void TRACE_setMode(TRACE_modeType mode);
+
+/* Keep the event if recording or replaying */
+void TRACE_record(TRACE_eventIdType type, uint8 id, uint16 value);
+
+/* Record the ADC reading of the zone, while replaying the last replayed reading of the zone replaces it */
+uint16 TRACE_adcSample(uint8 zone, uint16 adc);
+
+/* Queue the event to be replayed at its time, returns FALSE if not replaying, the event is invalid or the queue is full */
+boolean TRACE_play(const TRACE_eventType* event);
+
+/* Number of the recorded events */
+uint8 TRACE_getEventsNum(void);
+
+/* Recorded event by its order from the oldest, returns FALSE if there is no such event */
+boolean TRACE_getEvent(uint8 index, TRACE_eventType* event);
+
+
+#endif /* APP_TRACE_H_ */
@@ -18,7 +18,8 @@
 #ifndef FREERTOS_CONFIG_H
 #define FREERTOS_CONFIG_H
 
-#include "MCAL/GPTM.h"
+#include "MCAL/Timebase.h"
+#include "MCAL/SysCtl.h"
 #include "MCAL/std_types.h"
 
 /******************************************************************************/
@@ -28,8 +29,8 @@
 /* configCPU_CLOCK_HZ must be set to the frequency of the clock that drives 
  * the peripheral used to generate the kernels periodic tick interrupt.
  * This is very often, but not always, equal to the main system clock frequency.
- * Default frequency in Tiva-C Micro-controllers is 16Mhz */
-#define configCPU_CLOCK_HZ                    (( unsigned long )16000000)
+ * The system clock is configured in MCAL/SysCtl.h */
+#define configCPU_CLOCK_HZ                    (( unsigned long )SYSCTL_SYSTEM_CLOCK_HZ)
 
 /* configTICK_RATE_HZ sets frequency of the tick interrupt in Hz, so
  * in our case Tick time will be 1ms */
@@ -77,20 +78,34 @@
 #define INCLUDE_uxTaskPriorityGet              1
 #define INCLUDE_vTaskDelayUntil                1
 #define INCLUDE_vTaskDelete                    1
+#define INCLUDE_uxTaskGetStackHighWaterMark    1
+#define INCLUDE_xTaskGetSchedulerState         1
 
 #define configUSE_MUTEXES                      1
 #define configUSE_RECURSIVE_MUTEXES            1
 #define configUSE_COUNTING_SEMAPHORES          1
-#define configUSE_QUEUE_SETS                   1
+#define configUSE_QUEUE_SETS                   0
 #define configUSE_TIMERS                       1
 
 #define configTIMER_TASK_PRIORITY              (configMAX_PRIORITIES - 1)
+/* 1 runs the periodic runtime measurements and temperature monitoring as software timer jobs (APP/Jobs.h)
+ * instead of their own tasks, the timer task stack then holds the deepest job (the temperature log on UART0)
+ */
+#define APP_PERIODIC_JOBS                      0
+
+#if (APP_PERIODIC_JOBS == 1)
+#define configTIMER_TASK_STACK_DEPTH           (configMINIMAL_STACK_SIZE * 2)
+#else
 #define configTIMER_TASK_STACK_DEPTH           (configMINIMAL_STACK_SIZE)
+#endif
 #define configTIMER_QUEUE_LENGTH               10
 #define INCLUDE_xTimerPendFunctionCall         1
 
 #define configUSE_APPLICATION_TASK_TAG         1
 
+/* The trace facility gives every queue a number, the registered application queues are profiled by it (APP/QueueStats.h) */
+#define configUSE_TRACE_FACILITY               1
+
 
 
 /******************************************************************************/
@@ -143,21 +158,95 @@ PRIORITY THAN THIS! (higher priorities are lower numeric values. */
 /* RTOS Runtime Measurements. *************************************************/
 /******************************************************************************/
 
-extern uint32 ullTasksOutTime[13];
-extern uint32 ullTasksInTime[13];
-extern uint32 ullTasksTotalTime[13];
+/* Every time is in core cycles of the timebase, TIMEBASE_cyclesToUs converts it to micro seconds */
+
+/* Number of task tags, every application task has a unique tag from 1 and tag 0 is for the idle and timer tasks */
+#define RUNTIME_MEASUREMENTS_TASKS_NUM         16
+
+extern uint64 ullTasksOutTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+extern uint64 ullTasksInTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+extern uint64 ullTasksTotalTime[RUNTIME_MEASUREMENTS_TASKS_NUM];
+
+/* The last task switches are also kept for the crash record */
+extern void CRASH_recordSwitch(uint32 tag);
+
+/* The jobs and mutex hold times of every task are measured for the schedulability analysis (Schedulability.h) */
+extern void SCHED_switchedIn(uint32 tag, uint32 priority, const char* name);
+extern void SCHED_switchedOut(uint32 tag, uint32 cycles, boolean isBlocked);
+extern void SCHED_taskDeleted(uint32 tag);
+
+/* Every take and give of ADC_mutex and UART_mutex is profiled (Contention.h) */
+extern void CONTENTION_taken(void* queue);
+extern void CONTENTION_given(void* queue);
+extern void CONTENTION_waiting(void* queue);
+extern void CONTENTION_timedOut(void* queue);
+extern void CONTENTION_priorityInherited(void);
+
+/* The registered queues have a queue number from 1 (QueueStats.h) */
+extern void QSTATS_sent(uint32 number, uint32 waiting, uint32 length, boolean isTask);
+extern void QSTATS_received(uint32 number, boolean isTask);
+extern void QSTATS_sendFailed(uint32 number, boolean isTask);
+extern void QSTATS_receiveFailed(uint32 number);
+extern void QSTATS_blocking(uint32 number, boolean isSend);
+
+#define QSTATS_IS_REGISTERED(pxQueue)               ((pxQueue)->uxQueueNumber != 0)
 
-#define traceTASK_SWITCHED_IN()                                    \
-do{                                                                \
-    uint32 taskInTag = (uint32)(pxCurrentTCB->pxTaskTag);          \
-    ullTasksInTime[taskInTag] = GPTM_WTimer0Read();                \
+#define traceTASK_SWITCHED_IN()                                                                  \
+do{                                                                                              \
+    uint32 taskInTag = (uint32)(pxCurrentTCB->pxTaskTag);                                        \
+    ullTasksInTime[taskInTag] = TIMEBASE_getCycles();                                            \
+    CRASH_recordSwitch(taskInTag);                                                               \
+    SCHED_switchedIn(taskInTag, pxCurrentTCB->uxBasePriority, pxCurrentTCB->pcTaskName);         \
 }while(0);
 
+/* A task switched out while it's still in its ready list is preempted or yielded, otherwise it's blocked */
 #define traceTASK_SWITCHED_OUT()                                                                 \
 do{                                                                                              \
     uint32 taskOutTag = (uint32)(pxCurrentTCB->pxTaskTag);                                       \
-    ullTasksOutTime[taskOutTag] = GPTM_WTimer0Read();                                            \
+    ullTasksOutTime[taskOutTag] = TIMEBASE_getCycles();                                          \
     ullTasksTotalTime[taskOutTag] += ullTasksOutTime[taskOutTag] - ullTasksInTime[taskOutTag];   \
+    SCHED_switchedOut(taskOutTag, (uint32)(ullTasksOutTime[taskOutTag] - ullTasksInTime[taskOutTag]),      \
+                      (boolean)!listIS_CONTAINED_WITHIN(&pxReadyTasksLists[pxCurrentTCB->uxPriority],   \
+                                                        &(pxCurrentTCB->xStateListItem)));              \
 }while(0);
 
+#define traceTASK_DELETE(pxTCB)                     SCHED_taskDeleted((uint32)((pxTCB)->pxTaskTag))
+#define traceQUEUE_RECEIVE(pxQueue)                                                              \
+do{                                                                                              \
+    CONTENTION_taken((void*)(pxQueue));                                                          \
+    if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_received((pxQueue)->uxQueueNumber, TRUE); }       \
+}while(0)
+
+#define traceQUEUE_SEND(pxQueue)                                                                 \
+do{                                                                                              \
+    CONTENTION_given((void*)(pxQueue));                                                          \
+    if(QSTATS_IS_REGISTERED(pxQueue)){                                                           \
+        QSTATS_sent((pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting, (pxQueue)->uxLength, TRUE); \
+    }                                                                                            \
+}while(0)
+
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)                                                  \
+do{                                                                                              \
+    CONTENTION_waiting((void*)(pxQueue));                                                        \
+    if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_blocking((pxQueue)->uxQueueNumber, FALSE); }      \
+}while(0)
+
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)                                                       \
+do{                                                                                              \
+    CONTENTION_timedOut((void*)(pxQueue));                                                       \
+    if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_receiveFailed((pxQueue)->uxQueueNumber); }        \
+}while(0)
+
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)                                                        \
+    do{ if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_sent((pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting, (pxQueue)->uxLength, FALSE); } }while(0)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)                                                     \
+    do{ if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_received((pxQueue)->uxQueueNumber, FALSE); } }while(0)
+#define traceQUEUE_SEND_FAILED(pxQueue)                                                          \
+    do{ if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_sendFailed((pxQueue)->uxQueueNumber, TRUE); } }while(0)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue)                                                 \
+    do{ if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_sendFailed((pxQueue)->uxQueueNumber, FALSE); } }while(0)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)                                                     \
+    do{ if(QSTATS_IS_REGISTERED(pxQueue)){ QSTATS_blocking((pxQueue)->uxQueueNumber, TRUE); } }while(0)
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority)    CONTENTION_priorityInherited()
+
 #endif /* FREERTOS_CONFIG_H */
@@ -7,32 +7,48 @@
 
 #include"LED.h"
 
+/***************************************************************************
+ *                          Compile-time checks
+ *************************************************************************** */
+
+/* The build fails here if any LED is defined on a pin that doesn't exist */
+GPIO_PIN_STATIC_CHECK(LED_DRIVER_RED, LED_PORT_OF(LED_DRIVER_RED), LED_PIN_OF(LED_DRIVER_RED));
+GPIO_PIN_STATIC_CHECK(LED_DRIVER_BLUE, LED_PORT_OF(LED_DRIVER_BLUE), LED_PIN_OF(LED_DRIVER_BLUE));
+GPIO_PIN_STATIC_CHECK(LED_DRIVER_GREEN, LED_PORT_OF(LED_DRIVER_GREEN), LED_PIN_OF(LED_DRIVER_GREEN));
+GPIO_PIN_STATIC_CHECK(LED_PASSENGER_RED, LED_PORT_OF(LED_PASSENGER_RED), LED_PIN_OF(LED_PASSENGER_RED));
+GPIO_PIN_STATIC_CHECK(LED_PASSENGER_BLUE, LED_PORT_OF(LED_PASSENGER_BLUE), LED_PIN_OF(LED_PASSENGER_BLUE));
+GPIO_PIN_STATIC_CHECK(LED_PASSENGER_GREEN, LED_PORT_OF(LED_PASSENGER_GREEN), LED_PIN_OF(LED_PASSENGER_GREEN));
+
+/***************************************************************************
+ *                              Global variables
+ *************************************************************************** */
+
+/* Masked data register of every LED number, resolved at compile time so LED_set is one load and one store */
+static volatile uint32* const LED_dataRegister[LED_MAX_NUM] = {
+
+    &LED_DATA_R(0),  &LED_DATA_R(1),  &LED_DATA_R(2),  &LED_DATA_R(3),
+    &LED_DATA_R(4),  &LED_DATA_R(5),  &LED_DATA_R(6),  &LED_DATA_R(7),
+    &LED_DATA_R(8),  &LED_DATA_R(9),  &LED_DATA_R(10), &LED_DATA_R(11),
+    &LED_DATA_R(12), &LED_DATA_R(13), &LED_DATA_R(14)
+};
+
 /***************************************************************************
  *                          Functions definition
  *************************************************************************** */
 
 void LED_init(uint8 led_num){
 
-    if(led_num <= (NUM_OF_PINS_PER_PORT-1)){
-
-        GPIO_setupPinDirection(LED_PORT, led_num, PIN_OUTPUT);
-    }
-    else{
+    if(led_num < LED_MAX_NUM){
 
-        GPIO_setupPinDirection(LED_PORT_ADD, led_num % (NUM_OF_PINS_PER_PORT-1), PIN_OUTPUT);
+        GPIO_setupPinDirection(LED_PORT_OF(led_num), LED_PIN_OF(led_num), PIN_OUTPUT);
     }
-
 }
 
 
 void LED_set(uint8 led_num, LED_configType value){
 
-    if(led_num <= (NUM_OF_PINS_PER_PORT-1)){
-
-        GPIO_writePin(LED_PORT, led_num, value);
-    }
-    else{
+    if(led_num < LED_MAX_NUM){
 
-        GPIO_writePin(LED_PORT_ADD, led_num % (NUM_OF_PINS_PER_PORT-1), value);
+        *LED_dataRegister[led_num] = (value == HIGH) ? 0xFFu : 0u;
     }
 }
@@ -38,6 +38,22 @@
 #define LED_PASSENGER_BLUE     9    /* PB2 */
 #define LED_PASSENGER_GREEN    10   /* PB3 */
 
+/* Maximum number of LEDs this driver supports (LED numbers 0 to 14) */
+#define LED_MAX_NUM            15
+
+/* Port and pin of any LED number, resolved by the compiler when the LED number is constant */
+#define LED_PORT_OF(led_num)   (((led_num) <= (NUM_OF_PINS_PER_PORT-1)) ? LED_PORT : LED_PORT_ADD)
+#define LED_PIN_OF(led_num)    (((led_num) <= (NUM_OF_PINS_PER_PORT-1)) ? (led_num) : ((led_num) % (NUM_OF_PINS_PER_PORT-1)))
+
+/* Masked data register of the required LED */
+#define LED_DATA_R(led_num)    GPIO_PIN_DATA_R(LED_PORT_OF(led_num), LED_PIN_OF(led_num))
+
+/* Same as LED_set but for a constant LED number, it compiles to a single store */
+#define LED_SET(led_num,value) GPIO_PIN_WRITE(LED_PORT_OF(led_num), LED_PIN_OF(led_num), (value) == HIGH)
+
+/* Current state of a constant LED number, the pin level is the same as the LED_configType value in both logics */
+#define LED_GET(led_num)       ((LED_configType)(LED_DATA_R(led_num) != 0u))
+
 /***************************************************************************
  *                              User-defined types
  *************************************************************************** */
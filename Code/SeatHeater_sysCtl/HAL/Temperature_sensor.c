@@ -11,6 +11,68 @@
  *******************************************************************************/
 
 #include"Temperature_sensor.h"
+#include"MCAL/GPTM.h"
+
+/****************************************************************************
+ *                               Configurations
+ * ************************************************************************/
+
+TEMPSENSOR_faultConfigType TEMPSENSOR_faultConfigs = {
+
+    5,      /* Minimum valid temperature */
+    40,     /* Maximum valid temperature */
+    20,     /* Rail margin (ADC counts) */
+    455,    /* Maximum change per sample (ADC counts, 5 degree celsius) */
+    900000, /* Stuck time (15 minutes in ms) */
+    3,      /* Fault confirmation samples */
+    5       /* Recovery confirmation samples */
+};
+
+TEMPSENSOR_calibrationType TEMPSENSOR_calibration[TEMPERATURE_ZONES] = {
+
+    {TEMPERATURE_MIN, TEMPERATURE_MAX, TEMPERATURE_MAX_MILLI_VOLT},    /* Driver */
+    {TEMPERATURE_MIN, TEMPERATURE_MAX, TEMPERATURE_MAX_MILLI_VOLT}     /* Passenger */
+};
+
+/****************************************************************************
+ *                              Types declaration
+ * ************************************************************************/
+
+typedef struct{
+
+    boolean isFaulty;
+    TEMPSENSOR_faultType lastFault;
+
+    /* Consecutive samples against the current state (faulty samples while good or good samples while faulty) */
+    uint8 confirmCount;
+
+    /* Previous reading and the time in ms since the reading is exactly the same */
+    boolean hasPrevious;
+    uint16 previousReading;
+    uint32 sameReadingMs;
+
+    uint32 faultCounters[TEMPSENSOR_FAULT_TYPES];
+
+}TEMPSENSOR_zoneStateType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static volatile TEMPSENSOR_zoneStateType g_zones[TEMPERATURE_ZONES];
+
+/* Sensor channel of every zone, zone number is also the number of its comparator window */
+static const uint8 g_zoneChannels[TEMPERATURE_ZONES] = {TEMPERATURE_DRIVER, TEMPERATURE_PASSENGER};
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Maximum value from ADC that the sensor of the zone inputs */
+static uint32 TEMPSENSOR_maxADC(uint8 zone){
+
+    return ((uint32)ADC_MAX_VALUE * TEMPSENSOR_calibration[zone].maxMilliVolt) / TEMPERATURE_V_REF_MILLI_VOLT;
+}
 
 /****************************************************************************
  *                             Functions definition
@@ -23,6 +85,31 @@ void TEMPSENSOR_init(void){
 
 uint8 TEMPSENSOR_getTemperature(uint8 channel){
 
+    uint8 zone;
+
+    for(zone = 0; (zone < (TEMPERATURE_ZONES - 1)) && (g_zoneChannels[zone] != channel); zone++);
+
+    return TEMPSENSOR_rawToTemperature(zone, TEMPSENSOR_readRaw(channel));
+}
+
+uint16 TEMPSENSOR_readRaw(uint8 channel){
+
+    uint16 adc_value;
+
+#ifdef POLLING
+    adc_value = ADC_readChannel(channel);
+#endif
+
+#ifdef INTERRUPT
+    ADC_readChannel(channel);
+    adc_value = g_channelReading;
+#endif
+
+    return adc_value;
+}
+
+uint8 TEMPSENSOR_rawToTemperature(uint8 zone, uint16 adc_value){
+
     /*
      * The following mathematical equation represents the conversion from any range to any range
      *
@@ -39,27 +126,186 @@ uint8 TEMPSENSOR_getTemperature(uint8 channel){
 
 
     uint8 Temperature;
-    uint32 adc_value;
 
     /* This variable represents the max value from ADC that sensor inputs */
     uint32 maxADC_sensor;
 
+    const TEMPSENSOR_calibrationType* calibration = &TEMPSENSOR_calibration[zone];
 
-#ifdef POLLING
-    adc_value = ADC_readChannel(channel);
-#endif
-
-#ifdef INTERRUPT
-    ADC_readChannel(channel);
-    adc_value = g_channelReading;
-#endif
-
-    maxADC_sensor = (uint32)(((float32)ADC_MAX_VALUE * TEMPERATURE_MAX_VOLT)/ADC_V_REF) ;
+    maxADC_sensor = TEMPSENSOR_maxADC(zone);
 
     Temperature =
-            (uint8)( ( ((float32)(adc_value - ADC_MIN_VALUE) * (TEMPERATURE_MAX - TEMPERATURE_MIN))
-                    / (maxADC_sensor - ADC_MIN_VALUE) ) + TEMPERATURE_MIN ) ;
+            (uint8)( ( ((float32)(adc_value - ADC_MIN_VALUE) * (calibration->maxTemperature - calibration->minTemperature))
+                    / (maxADC_sensor - ADC_MIN_VALUE) ) + calibration->minTemperature ) ;
 
     return Temperature;
 }
 
+uint16 TEMPSENSOR_temperatureToADC(uint8 zone, uint8 temperature){
+
+    uint32 adc_value;
+    const TEMPSENSOR_calibrationType* calibration = &TEMPSENSOR_calibration[zone];
+    uint32 range = calibration->maxTemperature - calibration->minTemperature;
+
+    if(temperature <= calibration->minTemperature){
+
+        return ADC_MIN_VALUE;
+    }
+
+    /* Inverse of the conversion in TEMPSENSOR_rawToTemperature rounded up, so the reading converts back to the same temperature */
+    adc_value = ((((uint32)(temperature - calibration->minTemperature) * (TEMPSENSOR_maxADC(zone) - ADC_MIN_VALUE)) + (range - 1))
+                / range) + ADC_MIN_VALUE;
+
+    if(adc_value > ADC_MAX_VALUE){
+
+        adc_value = ADC_MAX_VALUE;
+    }
+
+    return (uint16)adc_value;
+}
+
+void TEMPSENSOR_initChangeDetection(uint8 priority){
+
+    ADC_comparatorInit(g_zoneChannels, TEMPERATURE_ZONES, priority);
+    GPTM_Timer0ADCTriggerInit(TEMPERATURE_SAMPLE_PERIOD_MS);
+}
+
+void TEMPSENSOR_armChangeDetection(uint8 window, uint8 temperature, uint8 change){
+
+    uint16 low;
+
+    /* Readings below the ADC value of (temperature - change + 1) are converted to (temperature - change) or less */
+    if(temperature >= change){
+
+        low = TEMPSENSOR_temperatureToADC(window, temperature - change + 1);
+    }
+    else{
+
+        /* No reading is below zero so the low side never interrupts */
+        low = ADC_MIN_VALUE;
+    }
+
+    ADC_comparatorSetWindow(window, low, TEMPSENSOR_temperatureToADC(window, temperature + change));
+}
+
+/* Fault of one sample without debouncing, the checks have constant cost */
+static TEMPSENSOR_faultType TEMPSENSOR_classifySample(uint8 zoneNum, volatile TEMPSENSOR_zoneStateType* zone, uint16 adc_value, uint32 elapsedMs){
+
+    const TEMPSENSOR_faultConfigType* config = &TEMPSENSOR_faultConfigs;
+    uint8 temperature = TEMPSENSOR_rawToTemperature(zoneNum, adc_value);
+    uint16 change;
+
+    /* Time of the same reading, whatever the sample period is */
+    if((zone->hasPrevious == TRUE) && (adc_value == zone->previousReading)){
+
+        zone->sameReadingMs = (elapsedMs < (0xFFFFFFFFu - zone->sameReadingMs)) ? (zone->sameReadingMs + elapsedMs) : 0xFFFFFFFFu;
+    }
+    else{
+
+        zone->sameReadingMs = 0;
+    }
+
+    change = (zone->previousReading > adc_value) ? (zone->previousReading - adc_value) : (adc_value - zone->previousReading);
+
+    if((adc_value <= (ADC_MIN_VALUE + config->railMargin)) || (adc_value >= (ADC_MAX_VALUE - config->railMargin))){
+
+        return TEMPSENSOR_FAULT_RAIL;
+    }
+
+    if((temperature < config->minValidTemperature) || (temperature > config->maxValidTemperature)){
+
+        return TEMPSENSOR_FAULT_RANGE;
+    }
+
+    if((zone->hasPrevious == TRUE) && (change > config->maxChangePerSample)){
+
+        return TEMPSENSOR_FAULT_RATE;
+    }
+
+    if((config->stuckTimeMs != 0) && (zone->sameReadingMs >= config->stuckTimeMs)){
+
+        return TEMPSENSOR_FAULT_STUCK;
+    }
+
+    return TEMPSENSOR_FAULT_NONE;
+}
+
+boolean TEMPSENSOR_checkSample(uint8 zone, uint16 adc_value, uint32 elapsedMs){
+
+    volatile TEMPSENSOR_zoneStateType* state;
+    TEMPSENSOR_faultType fault;
+    boolean isChanged = FALSE;
+
+    if(zone >= TEMPERATURE_ZONES){
+
+        return FALSE;
+    }
+
+    state = &g_zones[zone];
+    fault = TEMPSENSOR_classifySample(zone, state, adc_value, elapsedMs);
+
+    state->previousReading = adc_value;
+    state->hasPrevious = TRUE;
+
+    /* Debouncing : only consecutive samples against the current state change it */
+    if(((fault != TEMPSENSOR_FAULT_NONE) && (state->isFaulty == FALSE)) ||
+       ((fault == TEMPSENSOR_FAULT_NONE) && (state->isFaulty == TRUE))){
+
+        state->confirmCount++;
+    }
+    else{
+
+        state->confirmCount = 0;
+    }
+
+    if((state->isFaulty == FALSE) && (state->confirmCount >= TEMPSENSOR_faultConfigs.faultConfirmSamples)){
+
+        state->isFaulty = TRUE;
+        state->lastFault = fault;
+        state->faultCounters[fault]++;
+        state->confirmCount = 0;
+        isChanged = TRUE;
+    }
+    else if((state->isFaulty == TRUE) && (state->confirmCount >= TEMPSENSOR_faultConfigs.recoveryConfirmSamples)){
+
+        state->isFaulty = FALSE;
+        state->confirmCount = 0;
+        isChanged = TRUE;
+    }
+
+    return isChanged;
+}
+
+boolean TEMPSENSOR_isFaulty(uint8 zone){
+
+    return (zone < TEMPERATURE_ZONES) ? g_zones[zone].isFaulty : FALSE;
+}
+
+boolean TEMPSENSOR_isFaultPending(uint8 zone){
+
+    return (zone < TEMPERATURE_ZONES) ? (boolean)(g_zones[zone].confirmCount != 0) : FALSE;
+}
+
+TEMPSENSOR_faultType TEMPSENSOR_getLastFault(uint8 zone){
+
+    return (zone < TEMPERATURE_ZONES) ? g_zones[zone].lastFault : TEMPSENSOR_FAULT_NONE;
+}
+
+uint32 TEMPSENSOR_getFaultCounter(uint8 zone, TEMPSENSOR_faultType fault){
+
+    return ((zone < TEMPERATURE_ZONES) && (fault < TEMPSENSOR_FAULT_TYPES)) ? g_zones[zone].faultCounters[fault] : 0;
+}
+
+boolean TEMPSENSOR_setCalibration(uint8 zone, const TEMPSENSOR_calibrationType* calibration){
+
+    if((zone >= TEMPERATURE_ZONES) ||
+       (calibration->minTemperature >= calibration->maxTemperature) ||
+       (calibration->maxMilliVolt == 0) || (calibration->maxMilliVolt > TEMPERATURE_V_REF_MILLI_VOLT)){
+
+        return FALSE;
+    }
+
+    TEMPSENSOR_calibration[zone] = *calibration;
+
+    return TRUE;
+}
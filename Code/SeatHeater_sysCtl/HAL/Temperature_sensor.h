@@ -19,16 +19,88 @@
 /*****************************************************************************
  *                                 Definitions
  * *************************************************************************/
+/* Default calibration of every sensor, the calibration can be changed at runtime by TEMPSENSOR_setCalibration */
 #define TEMPERATURE_MIN             0
 #define TEMPERATURE_MAX             45
 
 #define TEMPERATURE_MAX_VOLT        3.3
 
+/* Voltages in milli volt rounded to the nearest integer */
+#define TEMPERATURE_MAX_MILLI_VOLT  ((uint16)((TEMPERATURE_MAX_VOLT * 1000) + 0.5))
+#define TEMPERATURE_V_REF_MILLI_VOLT ((uint16)((ADC_V_REF * 1000) + 0.5))
+
 /* Make sure that channels are configured from ADC driver */
 
 #define TEMPERATURE_DRIVER    AIN0  /* channel AIN0  PE3  */
 #define TEMPERATURE_PASSENGER AIN1  /* channel AIN1  PE2  */
 
+/* Change detection : the hardware samples both sensors every period and interrupts only when a temperature leaves its window */
+#define TEMPERATURE_SAMPLE_PERIOD_MS    100u
+
+#define TEMPERATURE_DRIVER_WINDOW       0u
+#define TEMPERATURE_PASSENGER_WINDOW    1u
+
+/* Fault detection : every zone (seat) has its own state, zone number is the same as the window number */
+#define TEMPERATURE_ZONES               2u
+
+/*****************************************************************************
+ *                              Types declaration
+ * *************************************************************************/
+
+typedef struct{
+
+    /* Temperature at 0 volt and at the maximum output voltage of the sensor */
+    uint8 minTemperature;
+    uint8 maxTemperature;
+
+    /* Maximum output voltage of the sensor in milli volt, it can't exceed the ADC reference voltage */
+    uint16 maxMilliVolt;
+
+}TEMPSENSOR_calibrationType;
+
+/* Fault found in one sample, in order of priority if the sample has more than one fault */
+typedef enum{
+
+    TEMPSENSOR_FAULT_NONE,
+    TEMPSENSOR_FAULT_RAIL,      /* Reading near 0 or the maximum ADC value (open or short circuit) */
+    TEMPSENSOR_FAULT_RANGE,     /* Temperature out of the valid range */
+    TEMPSENSOR_FAULT_RATE,      /* Reading changed more than possible since the previous sample (noise burst) */
+    TEMPSENSOR_FAULT_STUCK,     /* Reading didn't change at all for too long */
+    TEMPSENSOR_FAULT_TYPES
+
+}TEMPSENSOR_faultType;
+
+typedef struct{
+
+    /* Valid temperature range in degree celsius */
+    uint8 minValidTemperature;
+    uint8 maxValidTemperature;
+
+    /* Readings within this number of ADC counts from 0 or from the maximum ADC value are rail readings */
+    uint16 railMargin;
+
+    /* Maximum change of the reading in ADC counts between two samples */
+    uint16 maxChangePerSample;
+
+    /* Time in ms with the exact same reading that means a stuck sensor, 0 disables the check,
+     * it's a time as the samples aren't periodic (backstop, fault confirmation or change detection) */
+    uint32 stuckTimeMs;
+
+    /* Number of consecutive faulty samples to declare the fault and of consecutive good samples to recover (at least 1) */
+    uint8 faultConfirmSamples;
+    uint8 recoveryConfirmSamples;
+
+}TEMPSENSOR_faultConfigType;
+
+/*****************************************************************************
+ *                              Global variables
+ * *************************************************************************/
+
+extern TEMPSENSOR_faultConfigType TEMPSENSOR_faultConfigs;
+
+/* Calibration of every zone, read only, use TEMPSENSOR_setCalibration to change it */
+extern TEMPSENSOR_calibrationType TEMPSENSOR_calibration[TEMPERATURE_ZONES];
+
 /****************************************************************************
  *                             Functions prototypes
  * ************************************************************************/
@@ -39,5 +111,40 @@ void TEMPSENSOR_init(void);
 /* Pass the channel that connected to the required sensor */
 uint8 TEMPSENSOR_getTemperature(uint8 channel);
 
+/* Same as TEMPSENSOR_getTemperature but returns the ADC reading, it's converted later by TEMPSENSOR_rawToTemperature */
+uint16 TEMPSENSOR_readRaw(uint8 channel);
+
+/* Convert the ADC reading of the zone sensor by the zone calibration */
+uint8 TEMPSENSOR_rawToTemperature(uint8 zone, uint16 adc_value);
+
+/* Smallest ADC reading of the zone sensor that is converted to this temperature or more */
+uint16 TEMPSENSOR_temperatureToADC(uint8 zone, uint8 temperature);
+
+/* Returns FALSE and keeps the old calibration if the new one isn't valid,
+ * the caller must prevent conversions of the zone meanwhile (ADC mutex in the application) */
+boolean TEMPSENSOR_setCalibration(uint8 zone, const TEMPSENSOR_calibrationType* calibration);
+
+/* Start sampling both sensors by the ADC digital comparators, the windows are disarmed till they are armed */
+void TEMPSENSOR_initChangeDetection(uint8 priority);
+
+/* Interrupt once the temperature of the window becomes (temperature - change) or less or (temperature + change) or more */
+void TEMPSENSOR_armChangeDetection(uint8 window, uint8 temperature, uint8 change);
+
+/* Check one sample of the zone and update its debounced fault state, elapsedMs is the time since the previous sample of the zone,
+ * returns TRUE if the zone state (faulty or not) changed, it must be called by one task only for every zone */
+boolean TEMPSENSOR_checkSample(uint8 zone, uint16 adc_value, uint32 elapsedMs);
+
+/* Debounced state of the zone, the sensor is faulty till enough good samples confirm the recovery */
+boolean TEMPSENSOR_isFaulty(uint8 zone);
+
+/* TRUE while faulty or good samples are being confirmed, the caller should sample faster till it's FALSE */
+boolean TEMPSENSOR_isFaultPending(uint8 zone);
+
+/* Last confirmed fault of the zone */
+TEMPSENSOR_faultType TEMPSENSOR_getLastFault(uint8 zone);
+
+/* Number of confirmed faults of this type since reset */
+uint32 TEMPSENSOR_getFaultCounter(uint8 zone, TEMPSENSOR_faultType fault);
+
 
 #endif /* HAL_TEMPERATURE_SENSOR_H_ */
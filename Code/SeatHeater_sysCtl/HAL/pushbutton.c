@@ -6,58 +6,61 @@
  */
 #include"pushbutton.h"
 
-#include "MCAL/gpio.h"
+/***************************************************************************
+ *                          Compile-time checks
+ *************************************************************************** */
+
+/* The build fails here if any push button is defined on a pin that doesn't exist */
+GPIO_PIN_STATIC_CHECK(PB_DRIVER_CONTROL, PB_PORT_OF(PB_DRIVER_CONTROL), PB_PIN_OF(PB_DRIVER_CONTROL));
+GPIO_PIN_STATIC_CHECK(PB_DRIVER_MULTI_FN, PB_PORT_OF(PB_DRIVER_MULTI_FN), PB_PIN_OF(PB_DRIVER_MULTI_FN));
+GPIO_PIN_STATIC_CHECK(PB_PASSENGER_CONTROL, PB_PORT_OF(PB_PASSENGER_CONTROL), PB_PIN_OF(PB_PASSENGER_CONTROL));
+
+/***************************************************************************
+ *                              Global variables
+ *************************************************************************** */
+
+/* Masked data register of every push button number, resolved at compile time so PB_getReading is two loads */
+static volatile uint32* const PB_dataRegister[PB_MAX_NUM] = {
+
+    &PB_DATA_R(0),  &PB_DATA_R(1),  &PB_DATA_R(2),  &PB_DATA_R(3),
+    &PB_DATA_R(4),  &PB_DATA_R(5),  &PB_DATA_R(6),  &PB_DATA_R(7),
+    &PB_DATA_R(8),  &PB_DATA_R(9),  &PB_DATA_R(10), &PB_DATA_R(11),
+    &PB_DATA_R(12), &PB_DATA_R(13), &PB_DATA_R(14)
+};
 
 /***************************************************************************
  *                          Functions definition
  *************************************************************************** */
 void PB_init(uint8 PB_num){
 
-    if(PB_num <= (NUM_OF_PINS_PER_PORT-1)){
+    if(PB_num < PB_MAX_NUM){
 
-        GPIO_setupPinDirection(PB_PORT, PB_num, PIN_INPUT);
+        GPIO_setupPinDirection(PB_PORT_OF(PB_num), PB_PIN_OF(PB_num), PIN_INPUT);
     }
-    else{
-
-        GPIO_setupPinDirection(PB_PORT_ADD, PB_num % (NUM_OF_PINS_PER_PORT-1), PIN_INPUT);
-    }}
+}
 
 
 uint8 PB_getReading(uint8 PB_num){
 
+    if(PB_num < PB_MAX_NUM){
 
-    if(PB_num <= (NUM_OF_PINS_PER_PORT-1)){
-
-        return GPIO_readPin(PB_PORT,PB_num);
+        return (uint8)(*PB_dataRegister[PB_num] != 0u);
     }
-    else{
 
-        return GPIO_readPin(PB_PORT_ADD,PB_num % (NUM_OF_PINS_PER_PORT-1));
-    }
+    return PB_RELEASED;
 }
 
 
 void PB_initEdgeTriggered(uint8 PB_num,uint8 priority){
 
-    if(PB_num <= (NUM_OF_PINS_PER_PORT-1)){
-
-#ifdef PULLUP
-        GPIO_edgeTriggeredInterruptInit(PB_PORT, PB_num, FALLING_EDGE,priority);
-#endif
-
-#ifdef PULLDOWN
-        GPIO_edgeTriggeredInterruptInit(PB_PORT, PB_num, RISING_EDGE,priority);
-#endif
-
-    }
-    else{
+    if(PB_num < PB_MAX_NUM){
 
 #ifdef PULLUP
-        GPIO_edgeTriggeredInterruptInit(PB_PORT_ADD, PB_num % (NUM_OF_PINS_PER_PORT-1), FALLING_EDGE,priority);
+        GPIO_edgeTriggeredInterruptInit(PB_PORT_OF(PB_num), PB_PIN_OF(PB_num), FALLING_EDGE,priority);
 #endif
 
 #ifdef PULLDOWN
-        GPIO_edgeTriggeredInterruptInit(PB_PORT_ADD, PB_num % (NUM_OF_PINS_PER_PORT-1), RISING_EDGE,priority);
+        GPIO_edgeTriggeredInterruptInit(PB_PORT_OF(PB_num), PB_PIN_OF(PB_num), RISING_EDGE,priority);
 #endif
 
     }
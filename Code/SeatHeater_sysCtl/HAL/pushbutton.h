@@ -9,6 +9,7 @@
 #define PUSHBUTTON_H_
 
 #include "MCAL/std_types.h"
+#include "MCAL/GPIO.h"
 
 /***************************************************************************
  *                                Definitions
@@ -47,6 +48,19 @@
 
 #define PB_PASSENGER_CONTROL    4  /* PF4 */
 
+/* Maximum number of push buttons this driver supports (push button numbers 0 to 14) */
+#define PB_MAX_NUM              15
+
+/* Port and pin of any push button number, resolved by the compiler when the push button number is constant */
+#define PB_PORT_OF(PB_num)      (((PB_num) <= (NUM_OF_PINS_PER_PORT-1)) ? PB_PORT : PB_PORT_ADD)
+#define PB_PIN_OF(PB_num)       (((PB_num) <= (NUM_OF_PINS_PER_PORT-1)) ? (PB_num) : ((PB_num) % (NUM_OF_PINS_PER_PORT-1)))
+
+/* Masked data register of the required push button */
+#define PB_DATA_R(PB_num)       GPIO_PIN_DATA_R(PB_PORT_OF(PB_num), PB_PIN_OF(PB_num))
+
+/* Same as PB_getReading but for a constant push button number, it compiles to a single load */
+#define PB_GET_READING(PB_num)  GPIO_PIN_READ(PB_PORT_OF(PB_num), PB_PIN_OF(PB_num))
+
 /***************************************************************************
  *                           Functions declaration
  *************************************************************************** */
@@ -176,3 +176,106 @@ void ADC_readChannel(uint8 ch_num){
 
 }
 #endif
+
+void ADC_comparatorInit(const uint8* channels, uint8 numOfWindows, uint8 priority){
+
+    uint8 window;
+    uint8 step;
+
+    if((numOfWindows == 0) || (numOfWindows > ADC_COMPARATOR_MAX_WINDOWS)){
+
+        return;
+    }
+
+    /* Disable sample sequencer 1 during configuration */
+    ADC0_ADCACTSS &= ~(1<<1);
+
+    /* Trigger source of SS1 is the timer */
+    ADC0_ADCEMUX = (ADC0_ADCEMUX & 0xFFFFFF0F) | (0x5<<4);
+
+    ADC0_ADCSSMUX1 = 0;
+    ADC0_ADCSSCTL1 = 0;
+    ADC0_ADCSSOP1 = 0;
+    ADC0_ADCSSDC1 = 0;
+
+    for(window=0; window<numOfWindows; window++){
+
+        for(step=(2*window); step<((2*window)+2); step++){
+
+            /* Sample the channel of the window */
+            ADC0_ADCSSMUX1 |= ((uint32)channels[window] << (4*step));
+
+            /* Send the step to the digital comparator which has the same number of the step instead of the FIFO */
+            ADC0_ADCSSOP1 |= (1ul << (4*step));
+            ADC0_ADCSSDC1 |= ((uint32)step << (4*step));
+
+            /* Disarmed till the window is set */
+            ADC0_ADCDCCTL_BASE[step] = 0;
+        }
+    }
+
+    /* End of sequence at the last step (END bit is bit 1 of the step control bits) */
+    ADC0_ADCSSCTL1 |= (1ul << ((4*((2*numOfWindows)-1)) + 1));
+
+    /* Route the digital comparators interrupt to SS1 interrupt */
+    ADC0_ADCIM |= (1ul<<17);
+
+    NVIC_SetPriorityIRQ(ADC0_SS1_IRQ,priority);
+    NVIC_EnableIRQ(ADC0_SS1_IRQ);
+
+    /* Enable SS1 */
+    ADC0_ADCACTSS |= (1<<1);
+}
+
+void ADC_comparatorSetWindow(uint8 window, uint16 low, uint16 high){
+
+    uint8 lowComparator = 2*window;
+    uint8 highComparator = (2*window) + 1;
+
+    if(window >= ADC_COMPARATOR_MAX_WINDOWS){
+
+        return;
+    }
+
+    /* COMP0 in bits 11:0 and COMP1 in bits 27:16, the low band is below COMP0 and the high band is at or above COMP1 */
+    ADC0_ADCDCCMP_BASE[lowComparator] = ((uint32)high << 16) | low;
+    ADC0_ADCDCCMP_BASE[highComparator] = ((uint32)high << 16) | low;
+
+    /* Control bits of the comparators :
+     *
+     * bit4 (CIE)      = 1 >>> interrupt enable
+     * bit3:2 (CIC)    = 0 >>> low band, 3 >>> high band
+     * bit1:0 (CIM)    = 3 >>> hysteresis once, interrupt when the reading enters the band and not again till it crosses
+     *                             to the opposite band, so noise at the edge of the window doesn't repeat the interrupt
+     *
+     *  */
+    ADC0_ADCDCCTL_BASE[lowComparator] = (1<<4) | (0<<2) | (3<<0);
+    ADC0_ADCDCCTL_BASE[highComparator] = (1<<4) | (3<<2) | (3<<0);
+
+    /* Reset the previous state of both comparators, so a reading already outside the new window interrupts */
+    ADC0_ADCDCRIC = (1ul << lowComparator) | (1ul << highComparator);
+
+    /* Clear any old interrupt of both comparators */
+    ADC0_ADCDCISC = (1ul << lowComparator) | (1ul << highComparator);
+}
+
+uint8 ADC_comparatorISR(void){
+
+    uint32 status = ADC0_ADCDCISC;
+    uint8 windows = 0;
+    uint8 window;
+
+    /* Clear the comparators interrupts then the SS1 digital comparator interrupt */
+    ADC0_ADCDCISC = status;
+    ADC0_ADCISC = (1ul<<17);
+
+    for(window=0; window<ADC_COMPARATOR_MAX_WINDOWS; window++){
+
+        if(status & (3ul << (2*window))){
+
+            windows |= (1 << window);
+        }
+    }
+
+    return windows;
+}
@@ -55,6 +55,14 @@
 #define ADC0_ADCISC                       (*((volatile uint32*)0x4003800C))
 #define ADC0_ADCCC                        (*((volatile uint32*)0x40038FC8))
 
+/* Digital comparator registers */
+#define ADC0_ADCSSOP1                     (*((volatile uint32*)0x40038070))
+#define ADC0_ADCSSDC1                     (*((volatile uint32*)0x40038074))
+#define ADC0_ADCDCISC                     (*((volatile uint32*)0x40038034))
+#define ADC0_ADCDCRIC                     (*((volatile uint32*)0x40038D00))
+#define ADC0_ADCDCCTL_BASE                (((volatile uint32*)0x40038E00))
+#define ADC0_ADCDCCMP_BASE                (((volatile uint32*)0x40038E40))
+
 
 
 /* GPIO Registers base addresses */
@@ -88,6 +96,21 @@
 
 #define POLLING
 #define ADC0_SS3_IRQ            17
+#define ADC0_SS1_IRQ            15
+
+/*
+ * NOTE:
+ *
+ * Digital comparator windows : sample sequencer 1 is triggered by Timer0A and every window uses two of its steps on
+ * the same channel, one step goes to a comparator that interrupts when the reading falls below the window
+ * and the other to a comparator that interrupts when the reading reaches the top of the window,
+ * the readings never go to the FIFO so the CPU isn't interrupted while the reading is inside the window.
+ *
+ * Every comparator interrupts once, it interrupts again only after the reading crosses to the other side of the window
+ * or the window is set again by ADC_comparatorSetWindow.
+ *
+ *  */
+#define ADC_COMPARATOR_MAX_WINDOWS  2
 
 /**************************************************************************
                                    Types declaration
@@ -148,4 +171,14 @@ uint16 ADC_readChannel(uint8 ch_num);
 void ADC_readChannel(uint8 ch_num);
 #endif
 
+/* Configure one window for every channel (window i samples channels[i]), windows are disarmed till their first ADC_comparatorSetWindow,
+ * Timer0A must be configured to trigger the ADC (GPTM_Timer0ADCTriggerInit) */
+void ADC_comparatorInit(const uint8* channels, uint8 numOfWindows, uint8 priority);
+
+/* Arm the window, the interrupt fires once the reading is below low or at/above high, also if it's already outside */
+void ADC_comparatorSetWindow(uint8 window, uint16 low, uint16 high);
+
+/* Must be called from the ADC sequence 1 interrupt handler, returns the fired windows (bit i for window i) */
+uint8 ADC_comparatorISR(void);
+
 #endif /* ADC_H_ */
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: EEPROM.c
+ *
+ * Description: Source file for the TM4C123GH6PM on-chip EEPROM driver
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#include "EEPROM.h"
+
+/*******************************************************************************
+ *                         Private functions definition                        *
+ *******************************************************************************/
+
+/* Wait till the current operation finishes (WORKING flag is bit 0) */
+static void EEPROM_waitDone(void)
+{
+    while(EEPROM_EEDONE & (1<<0));
+}
+
+/* TRUE if a previous program or erase cycle failed and needs retry (PRETRY is bit 3 and ERETRY is bit 2) */
+static boolean EEPROM_hasError(void)
+{
+    return (boolean)((EEPROM_EESUPP & ((1<<3) | (1<<2))) != 0);
+}
+
+/* Point to the word of the byte address */
+static boolean EEPROM_setAddress(uint32 address, uint32 numOfWords)
+{
+    if((address & 0x3u) || ((address + (numOfWords * 4u)) > EEPROM_SIZE))
+    {
+        return FALSE;
+    }
+
+    EEPROM_EEBLOCK = address / EEPROM_BYTES_PER_BLOCK;
+    EEPROM_EEOFFSET = (address % EEPROM_BYTES_PER_BLOCK) / 4u;
+
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                            Functions definition                             *
+ *******************************************************************************/
+
+boolean EEPROM_init(void)
+{
+    /* Open clock for the EEPROM */
+    SYSCTL_RCGCEEPROM |= (1<<0);
+
+    /* Make sure clock open successfully and registers are accessible */
+    while(!(SYSCTL_PREEPROM & 1));
+
+    /* The EEPROM finishes any cycle interrupted by a reset or power loss before it's ready */
+    EEPROM_waitDone();
+
+    if(EEPROM_hasError() == TRUE)
+    {
+        return FALSE;
+    }
+
+    /* Reset the module so the recovered state is loaded again */
+    SYSCTL_SREEPROM |= (1<<0);
+    SYSCTL_SREEPROM &= ~(1<<0);
+    while(!(SYSCTL_PREEPROM & 1));
+
+    EEPROM_waitDone();
+
+    return (boolean)(EEPROM_hasError() == FALSE);
+}
+
+boolean EEPROM_read(uint32 address, uint32* pData, uint32 numOfWords)
+{
+    uint32 i;
+
+    if(EEPROM_setAddress(address, numOfWords) == FALSE)
+    {
+        return FALSE;
+    }
+
+    for(i=0; i<numOfWords; i++)
+    {
+        /* The offset wraps inside the block so move to the next block manually */
+        if((i != 0) && (EEPROM_EEOFFSET == 0))
+        {
+            EEPROM_EEBLOCK = EEPROM_EEBLOCK + 1;
+        }
+
+        pData[i] = EEPROM_EERDWRINC;
+    }
+
+    return TRUE;
+}
+
+boolean EEPROM_write(uint32 address, const uint32* pData, uint32 numOfWords)
+{
+    uint32 i;
+
+    if(EEPROM_setAddress(address, numOfWords) == FALSE)
+    {
+        return FALSE;
+    }
+
+    for(i=0; i<numOfWords; i++)
+    {
+        if((i != 0) && (EEPROM_EEOFFSET == 0))
+        {
+            EEPROM_EEBLOCK = EEPROM_EEBLOCK + 1;
+        }
+
+        EEPROM_EERDWRINC = pData[i];
+        EEPROM_waitDone();
+
+        /* NOPERM (bit 4) or WRBUSY (bit 5) means the word isn't written */
+        if(EEPROM_EEDONE & ((1<<4) | (1<<5)))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
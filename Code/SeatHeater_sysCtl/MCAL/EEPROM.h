@@ -0,0 +1,59 @@
+/******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: EEPROM.h
+ *
+ * Description: Header file for the TM4C123GH6PM on-chip EEPROM driver
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                              Mapped registers                               *
+ *******************************************************************************/
+
+#define SYSCTL_RCGCEEPROM   (*((volatile uint32*)0x400FE658))
+#define SYSCTL_SREEPROM     (*((volatile uint32*)0x400FE558))
+#define SYSCTL_PREEPROM     (*((volatile uint32*)0x400FEA58))
+
+#define EEPROM_EESIZE       (*((volatile uint32*)0x400AF000))
+#define EEPROM_EEBLOCK      (*((volatile uint32*)0x400AF004))
+#define EEPROM_EEOFFSET     (*((volatile uint32*)0x400AF008))
+#define EEPROM_EERDWR       (*((volatile uint32*)0x400AF010))
+#define EEPROM_EERDWRINC    (*((volatile uint32*)0x400AF014))
+#define EEPROM_EEDONE       (*((volatile uint32*)0x400AF018))
+#define EEPROM_EESUPP       (*((volatile uint32*)0x400AF01C))
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* 2 KB organized as 32 blocks of 16 words, every word endures 500,000 program cycles */
+#define EEPROM_BLOCKS               32u
+#define EEPROM_WORDS_PER_BLOCK      16u
+#define EEPROM_BYTES_PER_BLOCK      (EEPROM_WORDS_PER_BLOCK * 4u)
+#define EEPROM_SIZE                 (EEPROM_BLOCKS * EEPROM_BYTES_PER_BLOCK)
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Power the EEPROM and recover it from any interrupted program cycle, returns FALSE if the EEPROM can't be used */
+boolean EEPROM_init(void);
+
+/* Address is in bytes and must be word aligned, returns FALSE if the words are out of the EEPROM */
+boolean EEPROM_read(uint32 address, uint32* pData, uint32 numOfWords);
+
+/* Blocks till every word is programmed (a few milliseconds if the EEPROM needs to copy or erase a sector),
+ * so it must be called only from a task that is allowed to wait, returns FALSE if any word failed */
+boolean EEPROM_write(uint32 address, const uint32* pData, uint32 numOfWords);
+
+
+#endif /* EEPROM_H_ */
@@ -0,0 +1,381 @@
+/******************************************************************************
+ *
+ * Module: Format
+ *
+ * File Name: Format.c
+ *
+ * Description: Source file for the integer, fixed-point and printf-like formatting into caller buffers
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#include"Format.h"
+
+#include<stdarg.h>
+
+/*******************************************************************************
+ *                              Global variables                               *
+ *******************************************************************************/
+
+/* "00" to "99", the pair of n starts at 2 * n */
+static const char g_digitPairs[200] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static const char g_hexDigits[2][16] = {"0123456789abcdef", "0123456789ABCDEF"};
+
+static const uint32 g_powersOf10[FORMAT_MAX_DECIMALS + 1u] = {
+
+    1ul, 10ul, 100ul, 1000ul, 10000ul, 100000ul, 1000000ul, 10000000ul, 100000000ul, 1000000000ul
+};
+
+/*******************************************************************************
+ *                         Private functions definition                        *
+ *******************************************************************************/
+
+/* Write the digits of the value backwards so the last digit is right before end, returns the first digit */
+static uint8* FORMAT_backwards32(uint8* end, uint32 value){
+
+    uint32 pair;
+
+    while(value >= 100u){
+
+        pair = (value % 100u) * 2u;
+        value /= 100u;
+
+        end -= 2;
+        end[0] = g_digitPairs[pair];
+        end[1] = g_digitPairs[pair + 1u];
+    }
+
+    if(value >= 10u){
+
+        end -= 2;
+        end[0] = g_digitPairs[value * 2u];
+        end[1] = g_digitPairs[(value * 2u) + 1u];
+    }
+    else{
+
+        *(--end) = (uint8)('0' + value);
+    }
+
+    return end;
+}
+
+static uint8* FORMAT_backwards64(uint8* end, uint64 value){
+
+    uint8* start;
+    uint32 block;
+
+    while(value > 0xFFFFFFFFull){
+
+        block = (uint32)(value % 1000000000ull);
+        value /= 1000000000ull;
+
+        /* Every block but the first one is 9 digits with its leading zeros */
+        start = FORMAT_backwards32(end, block);
+
+        while(start > (end - 9)){
+
+            *(--start) = '0';
+        }
+
+        end = start;
+    }
+
+    return FORMAT_backwards32(end, (uint32)value);
+}
+
+static uint8* FORMAT_backwardsHex(uint8* end, uint64 value, boolean isUpper){
+
+    do{
+
+        *(--end) = (uint8)g_hexDigits[isUpper][value & 0xFu];
+        value >>= 4;
+
+    }while(value != 0);
+
+    return end;
+}
+
+/* Copy the digits from start till end after the sign, returns the length */
+static uint8 FORMAT_finish(uint8* buffer, boolean isNegative, const uint8* start, const uint8* end){
+
+    uint8 length = 0;
+
+    if(isNegative == TRUE){
+
+        buffer[length++] = '-';
+    }
+
+    while(start < end){
+
+        buffer[length++] = *(start++);
+    }
+
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/* Write the integer digits, the point then the fraction with its leading zeros */
+static uint8 FORMAT_withPoint(uint8* buffer, boolean isNegative, uint32 integer, uint32 fraction, uint8 decimals){
+
+    uint8 digits[FORMAT_NUMBER_SIZE];
+    uint8* end = &digits[FORMAT_NUMBER_SIZE];
+    uint8* start = end;
+
+    if(decimals > 0){
+
+        start = FORMAT_backwards32(end, fraction);
+
+        while(start > (end - decimals)){
+
+            *(--start) = '0';
+        }
+
+        *(--start) = '.';
+    }
+
+    start = FORMAT_backwards32(start, integer);
+
+    /* No "-0.0" */
+    return FORMAT_finish(buffer, (boolean)(isNegative && ((integer != 0) || (fraction != 0))), start, end);
+}
+
+/*******************************************************************************
+ *                            Functions definition                             *
+ *******************************************************************************/
+
+uint8 FORMAT_uint32(uint8* buffer, uint32 value){
+
+    uint8 digits[FORMAT_NUMBER_SIZE];
+
+    return FORMAT_finish(buffer, FALSE, FORMAT_backwards32(&digits[FORMAT_NUMBER_SIZE], value), &digits[FORMAT_NUMBER_SIZE]);
+}
+
+uint8 FORMAT_sint32(uint8* buffer, sint32 value){
+
+    uint8 digits[FORMAT_NUMBER_SIZE];
+
+    /* The magnitude is negated as unsigned so the most negative value is right */
+    uint32 magnitude = (value < 0) ? (0ul - (uint32)value) : (uint32)value;
+
+    return FORMAT_finish(buffer, (boolean)(value < 0), FORMAT_backwards32(&digits[FORMAT_NUMBER_SIZE], magnitude), &digits[FORMAT_NUMBER_SIZE]);
+}
+
+uint8 FORMAT_uint64(uint8* buffer, uint64 value){
+
+    uint8 digits[FORMAT_NUMBER_SIZE];
+
+    return FORMAT_finish(buffer, FALSE, FORMAT_backwards64(&digits[FORMAT_NUMBER_SIZE], value), &digits[FORMAT_NUMBER_SIZE]);
+}
+
+uint8 FORMAT_sint64(uint8* buffer, sint64 value){
+
+    uint8 digits[FORMAT_NUMBER_SIZE];
+    uint64 magnitude = (value < 0) ? (0ull - (uint64)value) : (uint64)value;
+
+    return FORMAT_finish(buffer, (boolean)(value < 0), FORMAT_backwards64(&digits[FORMAT_NUMBER_SIZE], magnitude), &digits[FORMAT_NUMBER_SIZE]);
+}
+
+uint8 FORMAT_decimal(uint8* buffer, sint32 value, uint8 decimals){
+
+    uint32 magnitude = (value < 0) ? (0ul - (uint32)value) : (uint32)value;
+
+    if(decimals > FORMAT_MAX_DECIMALS){
+
+        decimals = FORMAT_MAX_DECIMALS;
+    }
+
+    return FORMAT_withPoint(buffer, (boolean)(value < 0), magnitude / g_powersOf10[decimals], magnitude % g_powersOf10[decimals], decimals);
+}
+
+uint8 FORMAT_fixed(uint8* buffer, sint32 value, uint8 fractionBits, uint8 decimals){
+
+    uint32 magnitude = (value < 0) ? (0ul - (uint32)value) : (uint32)value;
+    uint32 integer;
+    uint64 fraction;
+
+    if(fractionBits > 31u){
+
+        fractionBits = 31u;
+    }
+
+    if(decimals > FORMAT_MAX_DECIMALS){
+
+        decimals = FORMAT_MAX_DECIMALS;
+    }
+
+    integer = magnitude >> fractionBits;
+    fraction = magnitude & ((1ul << fractionBits) - 1ul);
+
+    /* fraction / 2^bits * 10^decimals rounded to the nearest, a multiplication and a shift */
+    fraction *= g_powersOf10[decimals];
+
+    if(fractionBits > 0){
+
+        fraction = (fraction + (1ull << (fractionBits - 1u))) >> fractionBits;
+    }
+
+    if(fraction == g_powersOf10[decimals]){
+
+        integer++;
+        fraction = 0;
+    }
+
+    return FORMAT_withPoint(buffer, (boolean)(value < 0), integer, (uint32)fraction, decimals);
+}
+
+uint32 FORMAT_print(uint8* buffer, uint32 size, const char* format, ...){
+
+    va_list args;
+    uint8 digits[FORMAT_NUMBER_SIZE];
+    uint8* end = &digits[FORMAT_NUMBER_SIZE];
+    const uint8* start;
+    uint32 length = 0;
+    uint32 width;
+    uint32 fieldLength;
+    uint8 longs;
+    uint8 conversion;
+    boolean isZeroPadded;
+    boolean isNegative;
+    uint64 value;
+    sint64 signedValue;
+    uint8 character;
+
+    if(size == 0){
+
+        return 0;
+    }
+
+    va_start(args, format);
+
+    while((*format != '\0') && (length < (size - 1u))){
+
+        if(*format != '%'){
+
+            buffer[length++] = (uint8)*(format++);
+            continue;
+        }
+
+        format++;
+
+        isZeroPadded = (boolean)(*format == '0');
+        width = 0;
+        longs = 0;
+        isNegative = FALSE;
+
+        while((*format >= '0') && (*format <= '9')){
+
+            width = (width * 10u) + (uint32)(*(format++) - '0');
+        }
+
+        while(*format == 'l'){
+
+            longs++;
+            format++;
+        }
+
+        conversion = (uint8)*format;
+
+        switch(conversion){
+
+        case 'd':
+        case 'i':
+
+            signedValue = (longs >= 2u) ? va_arg(args, sint64) : ((longs == 1u) ? (sint64)va_arg(args, long) : (sint64)va_arg(args, int));
+            isNegative = (boolean)(signedValue < 0);
+            value = isNegative ? (0ull - (uint64)signedValue) : (uint64)signedValue;
+            start = FORMAT_backwards64(end, value);
+            break;
+
+        case 'u':
+        case 'x':
+        case 'X':
+
+            value = (longs >= 2u) ? va_arg(args, uint64) : ((longs == 1u) ? (uint64)va_arg(args, unsigned long) : (uint64)va_arg(args, unsigned int));
+            start = (conversion == 'u') ? FORMAT_backwards64(end, value) : FORMAT_backwardsHex(end, value, (boolean)(conversion == 'X'));
+            break;
+
+        case 's':
+
+            start = (const uint8*)va_arg(args, const char*);
+            isZeroPadded = FALSE;
+            break;
+
+        case 'c':
+
+            character = (uint8)va_arg(args, int);
+            start = &character;
+            isZeroPadded = FALSE;
+            break;
+
+        case '%':
+
+            character = '%';
+            start = &character;
+            break;
+
+        default:
+
+            /* Unsupported conversion, stop at it */
+            va_end(args);
+            buffer[length] = '\0';
+            return length;
+        }
+
+        format++;
+
+        /* Length of the field without the sign */
+        if(conversion == 's'){
+
+            for(fieldLength = 0; start[fieldLength] != '\0'; fieldLength++);
+        }
+        else if((conversion == 'c') || (conversion == '%')){
+
+            fieldLength = 1;
+        }
+        else{
+
+            fieldLength = (uint32)(end - start);
+        }
+
+        if(isNegative == TRUE){
+
+            /* The sign is part of the width and it goes before the zeros of the padding */
+            if(width > 0){
+
+                width--;
+            }
+
+            if((isZeroPadded == TRUE) && (length < (size - 1u))){
+
+                buffer[length++] = '-';
+                isNegative = FALSE;
+            }
+        }
+
+        while((width > fieldLength) && (length < (size - 1u))){
+
+            buffer[length++] = isZeroPadded ? '0' : ' ';
+            width--;
+        }
+
+        if((isNegative == TRUE) && (length < (size - 1u))){
+
+            buffer[length++] = '-';
+        }
+
+        while((fieldLength > 0) && (length < (size - 1u))){
+
+            buffer[length++] = *(start++);
+            fieldLength--;
+        }
+    }
+
+    va_end(args);
+
+    buffer[length] = '\0';
+
+    return length;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *
+ * Module: Format
+ *
+ * File Name: Format.h
+ *
+ * Description: Header file for the integer, fixed-point and printf-like formatting into caller buffers
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include"std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* NOTE:
+ *
+ * The integers are converted two digits at a time by a table of the 100 digit pairs, a division by the constant 100
+ * is a multiplication on the Cortex-M4 so a value that fits 32 bits never calls the 64-bit division of the run-time library,
+ * a larger value is split into 9 digits blocks by one 64-bit division per block.
+ *
+ * Every function writes the null terminator and returns the length without it.
+ *
+ *  */
+
+/* Buffer size that fits any 64-bit integer with its sign and the null terminator */
+#define FORMAT_NUMBER_SIZE      21u
+
+/* Maximum decimal digits after the point of FORMAT_decimal and FORMAT_fixed */
+#define FORMAT_MAX_DECIMALS     9u
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* The buffers must be at least FORMAT_NUMBER_SIZE bytes */
+uint8 FORMAT_uint32(uint8* buffer, uint32 value);
+uint8 FORMAT_sint32(uint8* buffer, sint32 value);
+uint8 FORMAT_uint64(uint8* buffer, uint64 value);
+uint8 FORMAT_sint64(uint8* buffer, sint64 value);
+
+/* Value scaled by 10^decimals with the point inserted, ex: 235 with 1 decimal is "23.5" */
+uint8 FORMAT_decimal(uint8* buffer, sint32 value, uint8 decimals);
+
+/* Q-format value with fractionBits fraction bits (0 to 31) rounded to the decimals, ex: 0x1780 in Q8 with 1 decimal is "23.5" */
+uint8 FORMAT_fixed(uint8* buffer, sint32 value, uint8 fractionBits, uint8 decimals);
+
+/*
+ * Subset of snprintf, the output is cut to size - 1 characters and the length written is returned :
+ *
+ *  %d %i %u %x %X  : int, with the l modifier long (uint32 and sint32) and with ll long long (uint64 and sint64)
+ *  %s %c %%        : string, character and percent sign
+ *  width           : minimum width padded by spaces, or by zeros if it starts with 0 (ex: %08lX)
+ */
+uint32 FORMAT_print(uint8* buffer, uint32 size, const char* format, ...);
+
+
+#endif /* FORMAT_H_ */
@@ -182,6 +182,50 @@ typedef enum{
     RISING_EDGE,FALLING_EDGE
 }GPIO_EdgeTriggerType;
 
+/****************************************************************************************************************************
+ *                                              Compile-time pin access
+ ****************************************************************************************************************************/
+
+/*
+ * NOTE:
+ *
+ * The following macros resolve the port and pin at compile time when both are constants,
+ * so there is no switch on the port and no shift at runtime.
+ * The data register is accessed through its masked address (address bits [9:2] are the pin mask),
+ * so writing one pin is a single store without read-modify-write and reading it is a single load.
+ *
+ *  */
+
+/* Base of the masked data addresses of the required port */
+#define GPIO_PORT_DATA_BITS(port_num)                                 \
+        (((port_num) == PORTA_ID) ? GPIO_PORTA_DATA_BITS_R :          \
+         ((port_num) == PORTB_ID) ? GPIO_PORTB_DATA_BITS_R :          \
+         ((port_num) == PORTC_ID) ? GPIO_PORTC_DATA_BITS_R :          \
+         ((port_num) == PORTD_ID) ? GPIO_PORTD_DATA_BITS_R :          \
+         ((port_num) == PORTE_ID) ? GPIO_PORTE_DATA_BITS_R :          \
+                                    GPIO_PORTF_DATA_BITS_R)
+
+/* Data register that only sees the required pin */
+#define GPIO_PIN_DATA_R(port_num,pin_num)       (GPIO_PORT_DATA_BITS(port_num)[1u<<(pin_num)])
+
+/* Write Logic High (any non zero value) or Logic Low on the required pin */
+#define GPIO_PIN_WRITE(port_num,pin_num,value)  (GPIO_PIN_DATA_R(port_num,pin_num) = ((value) ? 0xFFu : 0u))
+
+/* Read the required pin, it should be Logic High or Logic Low */
+#define GPIO_PIN_READ(port_num,pin_num)         ((uint8)(GPIO_PIN_DATA_R(port_num,pin_num) != 0u))
+
+/* Toggle the required pin */
+#define GPIO_PIN_TOGGLE(port_num,pin_num)       (GPIO_PIN_DATA_R(port_num,pin_num) ^= 0xFFu)
+
+/*
+ * Fail the build if the required pin doesn't exist or it is one of the JTAG pins (PC0 to PC3),
+ * name is any unique identifier for the checked pin.
+ */
+#define GPIO_PIN_STATIC_CHECK(name,port_num,pin_num)                                   \
+        typedef char name##_pin_check[(((port_num) < NUM_OF_PORTS)                     \
+                                    && ((pin_num) < NUM_OF_PINS_PER_PORT)              \
+                                    && !(((port_num) == PORTC_ID) && ((pin_num) <= 3))) ? 1 : -1]
+
 /****************************************************************************************************************************
  *                                                    Functions prototype
  ****************************************************************************************************************************/
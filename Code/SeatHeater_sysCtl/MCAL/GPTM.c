@@ -19,7 +19,7 @@ void GPTM_WTimer0Init(void)
     WTIMER0_CTL_REG = 0;              /* Disable WTimer0 output */
     WTIMER0_CFG_REG = 0x04;           /* Select 32-bit configuration option */
     WTIMER0_TAMR_REG = 0x01;          /* Select one-shot down counter mode of WTimer0A */
-    WTIMER0_TAPR_REG = 1600 -1;       /* Set the prescaler for WTimer0A */
+    WTIMER0_TAPR_REG = (SYSCTL_SYSTEM_CLOCK_HZ / GPTM_WTIMER0_TICKS_PER_SECOND) - 1; /* Set the prescaler for WTimer0A */
     WTIMER0_CTL_REG |= (0x01);        /* Enable WTimer0A module */
 }
 
@@ -28,3 +28,14 @@ uint32 GPTM_WTimer0Read(void)
     return (uint32) (0xFFFFFFFFUL - WTIMER0_TAR_REG);
 }
 
+void GPTM_Timer0ADCTriggerInit(uint32 periodMs)
+{
+    SYSCTL_RCGCTIMER_REG |= (1<<0);   /* Enable clock Timer0 in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1<<0)));
+    TIMER0_CTL_REG = 0;               /* Disable Timer0 during configuration */
+    TIMER0_CFG_REG = 0x00;            /* Select 32-bit timer configuration */
+    TIMER0_TAMR_REG = 0x02;           /* Select periodic down counter mode of Timer0A */
+    TIMER0_TAILR_REG = ((SYSCTL_SYSTEM_CLOCK_HZ / 1000ul) * periodMs) - 1; /* Timeout every periodMs */
+    TIMER0_CTL_REG |= (1<<5);         /* Timer0A output trigger to the ADC on every timeout */
+    TIMER0_CTL_REG |= (0x01);         /* Enable Timer0A module */
+}
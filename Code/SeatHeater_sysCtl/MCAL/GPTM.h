@@ -14,9 +14,16 @@
 #define GPTM_H_
 
 #include "std_types.h"
+#include "SysCtl.h"
+
+/* WTimer0 counts every 0.1 msec */
+#define GPTM_WTIMER0_TICKS_PER_SECOND    10000ul
 
 void GPTM_WTimer0Init(void);
 uint32 GPTM_WTimer0Read(void);
 
+/* Periodic Timer0A that triggers the ADC every periodMs without any interrupt to the CPU */
+void GPTM_Timer0ADCTriggerInit(uint32 periodMs);
+
 
 #endif /* GPTM_H_ */
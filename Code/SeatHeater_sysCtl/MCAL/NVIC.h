@@ -25,6 +25,9 @@
 
 #define NVIC_SYSHNDCTRL_R   (*((volatile uint32*) 0xE000ED24))
 
+/* Interrupt control and state, VECTACTIVE (bits 8:0) is the number of the active exception or 0 in thread mode */
+#define NVIC_INT_CTRL_R     (*((volatile uint32*) 0xE000ED04))
+
 #define NVIC_SYSPRI1_R      (*((volatile uint32*) 0xE000ED18))
 #define NVIC_SYSPRI2_R      (*((volatile uint32*) 0xE000ED1C))
 #define NVIC_SYSPRI3_R      (*((volatile uint32*) 0xE000ED20))
@@ -0,0 +1,55 @@
+ /******************************************************************************
+ *
+ * Module: SysCtl
+ *
+ * File Name: SysCtl.c
+ *
+ * Description: Source file for the TM4C123GH6PM system clock configuration
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#include "SysCtl.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                            Functions definition                             *
+ *******************************************************************************/
+
+void SYSCTL_init(void)
+{
+#if (SYSCTL_SYSTEM_CLOCK_HZ != SYSCTL_PIOSC_CLOCK_HZ)
+
+    /* Use RCC2 register as it supports the 400 MHz PLL output */
+    SYSCTL_RCC2_REG |= (1ul<<31);
+
+    /* Bypass the PLL while it is configured */
+    SYSCTL_RCC2_REG |= (1ul<<11);
+
+    /* Crystal value is 16 MHz and the main oscillator is enabled */
+    SYSCTL_RCC_REG = (SYSCTL_RCC_REG & ~(0x1Ful<<6) & ~(1ul<<0)) | (SYSCTL_XTAL_16MHZ<<6);
+
+    /* Main oscillator is the oscillator source */
+    SYSCTL_RCC2_REG &= ~(0x7ul<<4);
+
+    /* Power up the PLL */
+    SYSCTL_RCC2_REG &= ~(1ul<<13);
+
+    /* Use the 400 MHz PLL output and divide it by (SYSDIV2 + 1) */
+    SYSCTL_RCC_REG |= (1ul<<22);
+    SYSCTL_RCC2_REG = (SYSCTL_RCC2_REG & ~(0x7Ful<<22)) | (1ul<<30) | (SYSCTL_SYSDIV2<<22);
+
+    /* Wait for the PLL to lock */
+    while((SYSCTL_RIS_REG & (1ul<<6)) == 0){};
+
+    /* Use the PLL output as system clock */
+    SYSCTL_RCC2_REG &= ~(1ul<<11);
+
+#endif
+}
+
+uint32 SYSCTL_getSystemClock(void)
+{
+    return SYSCTL_SYSTEM_CLOCK_HZ;
+}
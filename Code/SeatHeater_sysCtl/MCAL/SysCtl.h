@@ -0,0 +1,67 @@
+ /******************************************************************************
+ *
+ * Module: SysCtl
+ *
+ * File Name: SysCtl.h
+ *
+ * Description: Header file for the TM4C123GH6PM system clock configuration
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#ifndef SYSCTL_H_
+#define SYSCTL_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                              Configurations                                 *
+ *******************************************************************************/
+
+/*
+ * NOTE:
+ *
+ * This is the only place to choose the system clock, every driver computes its timing from it.
+ *
+ * - 16 MHz runs directly from the precision internal oscillator (PLL bypassed).
+ * - Any other value runs from the PLL driven by the 16 MHz crystal of the board,
+ *   it must be 400 MHz divided by an integer and 80 MHz at maximum (ex. 80, 66.67 (not integer Hz so not allowed), 50, 40, 20 MHz).
+ *
+ *  */
+#define SYSCTL_SYSTEM_CLOCK_HZ          80000000ul
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SYSCTL_PIOSC_CLOCK_HZ           16000000ul
+#define SYSCTL_PLL_CLOCK_HZ             400000000ul
+#define SYSCTL_MAX_SYSTEM_CLOCK_HZ      80000000ul
+
+/* XTAL field value of RCC register for 16 MHz crystal */
+#define SYSCTL_XTAL_16MHZ               0x15ul
+
+#if (SYSCTL_SYSTEM_CLOCK_HZ != SYSCTL_PIOSC_CLOCK_HZ)
+
+#if (SYSCTL_SYSTEM_CLOCK_HZ > SYSCTL_MAX_SYSTEM_CLOCK_HZ) || ((SYSCTL_PLL_CLOCK_HZ % SYSCTL_SYSTEM_CLOCK_HZ) != 0)
+#error "SYSCTL_SYSTEM_CLOCK_HZ must be 16 MHz or 400 MHz divided by an integer with 80 MHz at maximum"
+#endif
+
+/* Divisor of the 400 MHz PLL output (SYSDIV2 with SYSDIV2LSB in RCC2 register) */
+#define SYSCTL_SYSDIV2                  ((SYSCTL_PLL_CLOCK_HZ / SYSCTL_SYSTEM_CLOCK_HZ) - 1ul)
+
+#endif
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Configure the system clock to SYSCTL_SYSTEM_CLOCK_HZ, must be called before initializing any other driver */
+void SYSCTL_init(void);
+
+/* Return the system clock frequency in Hz */
+uint32 SYSCTL_getSystemClock(void);
+
+
+#endif /* SYSCTL_H_ */
@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ * Module: Timebase
+ *
+ * File Name: Timebase.c
+ *
+ * Description: Source file for the 64-bit monotonic cycle clock built on the Cortex-M4 DWT cycle counter
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#include "Timebase.h"
+
+/*******************************************************************************
+ *                              Global variables                               *
+ *******************************************************************************/
+
+/* Last value read from the hardware counter and the number of times it wrapped */
+static uint32 g_lastCycles = 0;
+static uint32 g_wraps = 0;
+
+/*******************************************************************************
+ *                            Functions definition                             *
+ *******************************************************************************/
+
+void TIMEBASE_init(void)
+{
+    /* Power the DWT unit */
+    TIMEBASE_DEMCR |= (1ul<<24);
+
+    TIMEBASE_DWT_CYCCNT = 0;
+    g_lastCycles = 0;
+    g_wraps = 0;
+
+    /* Enable the cycle counter */
+    TIMEBASE_DWT_CTRL |= (1ul<<0);
+}
+
+uint64 TIMEBASE_getCycles(void)
+{
+    uint32 cycles;
+    uint64 result;
+
+    /* Read and extend as one step, an interrupt reading in between would see the wrap twice or never */
+    uint32 key = _disable_interrupts();
+
+    cycles = TIMEBASE_DWT_CYCCNT;
+
+    if(cycles < g_lastCycles)
+    {
+        g_wraps++;
+    }
+
+    g_lastCycles = cycles;
+    result = ((uint64)g_wraps << 32) | cycles;
+
+    _restore_interrupts(key);
+
+    return result;
+}
+
+uint64 TIMEBASE_cyclesToUs(uint64 cycles)
+{
+    return cycles / TIMEBASE_CYCLES_PER_US;
+}
+
+uint64 TIMEBASE_usToCycles(uint64 us)
+{
+    return us * TIMEBASE_CYCLES_PER_US;
+}
+
+uint64 TIMEBASE_cyclesToTicks(uint64 cycles, uint32 tickRateHz)
+{
+    return cycles / (SYSCTL_SYSTEM_CLOCK_HZ / tickRateHz);
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *
+ * Module: Timebase
+ *
+ * File Name: Timebase.h
+ *
+ * Description: Header file for the 64-bit monotonic cycle clock built on the Cortex-M4 DWT cycle counter
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include "std_types.h"
+#include "SysCtl.h"
+
+/*******************************************************************************
+ *                              Mapped registers                               *
+ *******************************************************************************/
+
+/* Debug exception and monitor control register, TRCENA (bit 24) powers the DWT unit */
+#define TIMEBASE_DEMCR          (*((volatile uint32*)0xE000EDFC))
+
+#define TIMEBASE_DWT_CTRL       (*((volatile uint32*)0xE0001000))
+#define TIMEBASE_DWT_CYCCNT     (*((volatile uint32*)0xE0001004))
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * NOTE:
+ *
+ * The cycle counter is 32 bits so it wraps every 2^32 cycles (53.6 sec at 80 MHz), the wrap is detected
+ * in software on every read, so TIMEBASE_getCycles must be called at least once per wrap period.
+ * The task switch trace hooks read it on every context switch which is much more frequent than that.
+ *
+ * The counter stops while the core is halted by the debugger or sleeping.
+ *
+ *  */
+
+#define TIMEBASE_CYCLES_PER_US      (SYSCTL_SYSTEM_CLOCK_HZ / 1000000ul)
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Enable the DWT cycle counter and start the clock from zero */
+void TIMEBASE_init(void);
+
+/* Number of core cycles since TIMEBASE_init, it can be called from tasks, interrupts and trace hooks */
+uint64 TIMEBASE_getCycles(void);
+
+uint64 TIMEBASE_cyclesToUs(uint64 cycles);
+
+uint64 TIMEBASE_usToCycles(uint64 us);
+
+/* Convert cycles into RTOS ticks of the given tick rate (configTICK_RATE_HZ), the fraction of a tick is truncated */
+uint64 TIMEBASE_cyclesToTicks(uint64 cycles, uint32 tickRateHz);
+
+
+#endif /* TIMEBASE_H_ */
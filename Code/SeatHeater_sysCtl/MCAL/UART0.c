@@ -12,6 +12,37 @@
 
 #include"UART0.h"
 #include"GPIO.h"
+#include"NVIC.h"
+#include"Format.h"
+
+/*******************************************************************************
+ *                               Configurations                                *
+ *******************************************************************************/
+
+UART0_configType UART0_configs = {
+
+    115200ul,           /* Baud rate */
+    TRUE,               /* FIFO enable */
+    UART0_FIFO_1_8,     /* Transmit FIFO level */
+    UART0_FIFO_1_2,     /* Receive FIFO level */
+    FALSE,              /* High speed (sample every bit 8 times) */
+    TRUE                /* Receive time-out interrupt */
+};
+
+/*******************************************************************************
+ *                              Global variables                               *
+ *******************************************************************************/
+
+/* Number of received bytes dropped because the receive ring buffer was full */
+volatile uint32 UART0_rxDroppedBytes = 0;
+
+/* Receive ring buffer, the interrupt handler is the only writer of the head and the reader is the only writer of the tail */
+static volatile uint8  g_rxBuffer[UART0_RX_BUFFER_SIZE];
+static volatile uint32 g_rxHead = 0;
+static volatile uint32 g_rxTail = 0;
+
+/* Receive time-out interrupt is required by the configurations */
+static boolean g_rxTimeoutInterrupt = TRUE;
 
 
 /*******************************************************************************
@@ -43,7 +74,24 @@ void GPIO_SetupUART0Pins(void){
     GPIO_PORTA_DEN_R |= 0x3;
 }
 
-void UART0_Init(void){
+void UART0_Init(const UART0_configType* ptr){
+
+    uint32 clockDivider = (ptr->highSpeed == TRUE) ? 8ul : 16ul;
+    uint32 brdX64;
+
+    if((ptr->baudRate == 0) || (ptr->baudRate > UART0_MAX_BAUD_RATE)){
+
+        return;
+    }
+
+    /* Baud rate divisor multiplied by 64 and rounded : (system clock / (clock divider * baud rate)) * 64 + 0.5 */
+    brdX64 = (uint32)(((((uint64)SYSCTL_getSystemClock() * 128ull) / ((uint64)clockDivider * ptr->baudRate)) + 1ull) / 2ull);
+
+    /* Integer part of the divisor must be from 1 to 65535 */
+    if((brdX64 < 64ul) || ((brdX64 >> 6) > 0xFFFFul)){
+
+        return;
+    }
 
     GPIO_SetupUART0Pins();
 
@@ -56,14 +104,14 @@ void UART0_Init(void){
     /* Disable the UART */
     UART0_CTL &= ~(1<<0);
 
-    /* Use internal oscillator as clock source */
-    UART0_CC = 0x5;
+    /* Use system clock as clock source */
+    UART0_CC = 0x0;
 
-    /* Integer part of the equation : 16MHZ / (16 * 9600) */
-    UART0_IBRD = 104;
+    /* Integer part of the divisor */
+    UART0_IBRD = brdX64 >> 6;
 
-    /* Fractional part of the equation * 64 + 0.5 */
-    UART0_FBRD = 11;
+    /* Fractional part of the divisor * 64 + 0.5 */
+    UART0_FBRD = brdX64 & 0x3F;
 
     /* No stick parity */
     UART0_LCRH &= ~(1<<7);
@@ -71,8 +119,15 @@ void UART0_Init(void){
     /* UART word length is 8 bits */
     UART0_LCRH |= (3<<5);
 
-    /* FIFO is disabled */
-    UART0_LCRH &= ~(1<<4);
+    /* FIFO enable */
+    if(ptr->fifoEnable == TRUE){
+
+        UART0_LCRH |= (1<<4);
+    }
+    else{
+
+        UART0_LCRH &= ~(1<<4);
+    }
 
     /* Use one stop bit */
     UART0_LCRH &= ~(1<<3);
@@ -83,11 +138,23 @@ void UART0_Init(void){
     /* Normal use of break */
     UART0_LCRH &= ~(1<<0);
 
+    /* Receive FIFO level in bits 5:3 and transmit FIFO level in bits 2:0 */
+    UART0_IFLS = ((uint32)ptr->rxFifoLevel << 3) | (uint32)ptr->txFifoLevel;
+
+    g_rxTimeoutInterrupt = ptr->rxTimeoutInterrupt;
+
     /* UART transmit and receive enable */
     UART0_CTL = UART0_CTL | (1<<8) | (1<<9);
 
-    /* High speed enable (system clock is divided by 16 ) */
-    UART0_CTL &= ~(1<<5);
+    /* High speed enable (system clock is divided by 8 instead of 16) */
+    if(ptr->highSpeed == TRUE){
+
+        UART0_CTL |= (1<<5);
+    }
+    else{
+
+        UART0_CTL &= ~(1<<5);
+    }
 
     /* Enable the UART */
     UART0_CTL |= (1<<0);
@@ -96,8 +163,9 @@ void UART0_Init(void){
 
 void UART0_SendByte(uint8 data){
 
+    /* Wait only while the transmit FIFO is full (TXFF flag is bit 5), the FIFO sends the bytes in background */
+    while(UART0_FLAG & (1<<5));
     UART0_DATA = data;
-    while(!(UART0_FLAG & (1<<7)));
 }
 
 uint8 UART0_ReceiveByte(void){
@@ -154,28 +222,71 @@ void UART0_ReceiveData(uint8 *pData, uint32 uSize){
 
 void UART0_SendInteger(sint64 sNumber)
 {
+    uint8 uDigits[FORMAT_NUMBER_SIZE];
+
+    /* Any value that fits 32 bits is converted without 64-bit divisions */
+    UART0_SendData(uDigits, FORMAT_sint64(uDigits, sNumber));
+}
+
+void UART0_EnableRxInterrupt(uint8 priority){
+
+    /* Clear any pending receive and receive time-out interrupt */
+    UART0_ICR = (1<<4) | (1<<6);
 
-    uint8 uDigits[20];
-    sint8 uCounter = 0;
+    /* Unmask receive interrupt and receive time-out interrupt if it's required */
+    UART0_IM |= (1<<4);
 
-    /* Send the negative sign in case of negative numbers */
-    if (sNumber < 0)
-    {
-        UART0_SendByte('-');
-        sNumber *= -1;
+    if(g_rxTimeoutInterrupt == TRUE){
+
+        UART0_IM |= (1<<6);
     }
 
-    /* Convert the number to an array of characters */
-    do
-    {
-        uDigits[uCounter++] = sNumber % 10 + '0'; /* Convert each digit to its corresponding ASCI character */
-        sNumber /= 10; /* Remove the already converted digit */
+    NVIC_SetPriorityIRQ(UART0_IRQ,priority);
+    NVIC_EnableIRQ(UART0_IRQ);
+}
+
+boolean UART0_RxISR(void){
+
+    boolean endOfLine = FALSE;
+    uint8 data;
+
+    /* Clear receive and receive time-out interrupts before draining, so a byte received while draining raises it again */
+    UART0_ICR = (1<<4) | (1<<6);
+
+    /* Drain everything received till now (RXFE flag is bit 4) */
+    while(!(UART0_FLAG & (1<<4))){
+
+        data = (uint8)UART0_DATA;
+
+        if((g_rxHead - g_rxTail) >= UART0_RX_BUFFER_SIZE){
+
+            /* Buffer is full */
+            UART0_rxDroppedBytes++;
+        }
+        else{
+
+            g_rxBuffer[g_rxHead & (UART0_RX_BUFFER_SIZE - 1u)] = data;
+            g_rxHead++;
+        }
+
+        if((data == '\r') || (data == '\n')){
+
+            endOfLine = TRUE;
+        }
     }
-    while (sNumber != 0);
 
-    /* Send the array of characters in a reverse order as the digits were converted from right to left */
-    for( uCounter--; uCounter>= 0; uCounter--)
-    {
-        UART0_SendByte(uDigits[uCounter]);
+    return endOfLine;
+}
+
+boolean UART0_ReadRxBuffer(uint8 *pData){
+
+    if(g_rxTail == g_rxHead){
+
+        return FALSE;
     }
+
+    *pData = g_rxBuffer[g_rxTail & (UART0_RX_BUFFER_SIZE - 1u)];
+    g_rxTail++;
+
+    return TRUE;
 }
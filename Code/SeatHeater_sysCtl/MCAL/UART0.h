@@ -21,6 +21,7 @@
 #define UART0_H_
 
 #include"std_types.h"
+#include"SysCtl.h"
 
 /*******************************************************************************
  *                              Mapped registers                               *
@@ -36,6 +37,63 @@
 #define UART0_CTL       (*((volatile uint32*)0x4000C030))
 #define UART0_CC        (*((volatile uint32*)0x4000CFC8))
 #define UART0_FLAG      (*((volatile uint32*)0x4000C018))
+#define UART0_IFLS      (*((volatile uint32*)0x4000C034))
+#define UART0_IM        (*((volatile uint32*)0x4000C038))
+#define UART0_RIS       (*((volatile uint32*)0x4000C03C))
+#define UART0_MIS       (*((volatile uint32*)0x4000C040))
+#define UART0_ICR       (*((volatile uint32*)0x4000C044))
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define UART0_IRQ               5
+
+/* Maximum baud rate supported by the console cable (USB virtual COM port of the launchpad) */
+#define UART0_MAX_BAUD_RATE     1000000ul
+
+/* Size of the receive ring buffer filled by the receive interrupt, it must be a power of 2 */
+#define UART0_RX_BUFFER_SIZE    64u
+
+/*******************************************************************************
+ *                              Types declaration                              *
+ *******************************************************************************/
+
+/* FIFO level that raises the interrupt, the transmit interrupt is raised when the FIFO is at or below the level
+ * and the receive interrupt is raised when the FIFO is at or above the level */
+typedef enum{
+
+    UART0_FIFO_1_8, UART0_FIFO_1_4, UART0_FIFO_1_2, UART0_FIFO_3_4, UART0_FIFO_7_8
+
+}UART0_fifoLevelType;
+
+typedef struct{
+
+    uint32 baudRate;
+
+    /* The 16 bytes transmit and receive FIFOs are used, otherwise they are one byte holding registers */
+    boolean fifoEnable;
+
+    UART0_fifoLevelType txFifoLevel;
+    UART0_fifoLevelType rxFifoLevel;
+
+    /* Sample every bit 8 times instead of 16 (HSE), it doubles the maximum baud rate */
+    boolean highSpeed;
+
+    /* Raise the receive interrupt also when the receive FIFO isn't empty and the line is idle for 32 bits,
+     * without it the last bytes below the receive FIFO level wait for the next bytes */
+    boolean rxTimeoutInterrupt;
+
+}UART0_configType;
+
+/*******************************************************************************
+ *                              Global variables                               *
+ *******************************************************************************/
+
+extern UART0_configType UART0_configs;
+
+/* Number of received bytes dropped because the receive ring buffer was full */
+extern volatile uint32 UART0_rxDroppedBytes;
 
 
 
@@ -43,7 +101,8 @@
  *                            Functions Prototypes                             *
  *******************************************************************************/
 
-extern void UART0_Init(void);
+/* The UART isn't enabled if the baud rate can't be generated from the system clock */
+extern void UART0_Init(const UART0_configType* ptr);
 
 extern void UART0_SendByte(uint8 data);
 
@@ -59,6 +118,15 @@ extern void UART0_ReceiveString(uint8 *pData);
 
 extern void UART0_SendInteger(sint64 sNumber);
 
+/* Enable the receive interrupt, received bytes are then stored in the receive ring buffer */
+extern void UART0_EnableRxInterrupt(uint8 priority);
+
+/* Must be called from the UART0 interrupt handler, returns TRUE if an end of line ('\r' or '\n') is received */
+extern boolean UART0_RxISR(void);
+
+/* Take one byte from the receive ring buffer without waiting, returns FALSE if the buffer is empty */
+extern boolean UART0_ReadRxBuffer(uint8 *pData);
+
 
 
 #endif /* UART0_H_ */
@@ -0,0 +1,61 @@
+/******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: WDT.c
+ *
+ * Description: Source file for the TM4C123GH6PM watchdog timer 0 driver
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#include "WDT.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                            Functions definition                             *
+ *******************************************************************************/
+
+void WDT0_init(uint32 timeoutMs, uint8 priority)
+{
+    if(timeoutMs > WDT0_MAX_TIMEOUT_MS)
+    {
+        timeoutMs = WDT0_MAX_TIMEOUT_MS;
+    }
+
+    /* Open clock for the watchdog 0 */
+    SYSCTL_RCGCWD_REG |= (1<<0);
+
+    /* Make sure clock open successfully and registers are accessible */
+    while(!(SYSCTL_PRWD_REG & (1<<0)));
+
+    WDT0_LOCK_R = WDT0_UNLOCK_KEY;
+
+    WDT0_LOAD_R = timeoutMs * (SYSCTL_SYSTEM_CLOCK_HZ / 1000ul);
+
+    /* Stall the counter while the debugger halts the processor (STALL is bit 8) */
+    WDT0_TEST_R |= (1<<8);
+
+    NVIC_SetPriorityIRQ(WDT0_IRQ,priority);
+    NVIC_EnableIRQ(WDT0_IRQ);
+
+    /* Standard interrupt (INTTYPE is bit 2) and reset (RESEN is bit 1) on the second time-out,
+     * setting INTEN (bit 0) starts the counter and only a reset clears it
+     */
+    WDT0_CTL_R = (1<<1) | (1<<0);
+
+    /* Lock the registers so a runaway code can't feed or reconfigure the watchdog by chance */
+    WDT0_LOCK_R = 0;
+}
+
+void WDT0_feed(void)
+{
+    WDT0_LOCK_R = WDT0_UNLOCK_KEY;
+
+    /* Writing any value reloads the counter from the load register */
+    WDT0_ICR_R = 0;
+
+    WDT0_LOCK_R = 0;
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: WDT.h
+ *
+ * Description: Header file for the TM4C123GH6PM watchdog timer 0 driver
+ *
+ * Author: Mario kaldas
+ *
+ *******************************************************************************/
+
+#ifndef WDT_H_
+#define WDT_H_
+
+#include "std_types.h"
+#include "SysCtl.h"
+
+/*******************************************************************************
+ *                              Mapped registers                               *
+ *******************************************************************************/
+
+#define WDT0_LOAD_R         (*((volatile uint32*)0x40000000))
+#define WDT0_VALUE_R        (*((volatile uint32*)0x40000004))
+#define WDT0_CTL_R          (*((volatile uint32*)0x40000008))
+#define WDT0_ICR_R          (*((volatile uint32*)0x4000000C))
+#define WDT0_RIS_R          (*((volatile uint32*)0x40000010))
+#define WDT0_TEST_R         (*((volatile uint32*)0x40000418))
+#define WDT0_LOCK_R         (*((volatile uint32*)0x40000C00))
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define WDT0_IRQ                18
+
+/* Writing this key to the lock register enables the writes to the other registers, any other value locks them */
+#define WDT0_UNLOCK_KEY         0x1ACCE551ul
+
+/* The 32-bit counter runs from the system clock */
+#define WDT0_MAX_TIMEOUT_MS     (0xFFFFFFFFul / (SYSCTL_SYSTEM_CLOCK_HZ / 1000ul))
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*
+ * Start the watchdog with the given time-out (clamped to WDT0_MAX_TIMEOUT_MS), it can't be stopped except by a reset.
+ * If it's not fed within the time-out it interrupts, if it's still not fed by the end of the next time-out it resets the system.
+ * The counter stalls while the debugger halts the processor.
+ */
+void WDT0_init(uint32 timeoutMs, uint8 priority);
+
+/* Reload the counter and clear a pending time-out interrupt */
+void WDT0_feed(void);
+
+
+#endif /* WDT_H_ */
@@ -6,14 +6,41 @@
  */
 
 #include "delay.h"
+#include "Timebase.h"
+#include "NVIC.h"
 
-#define NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND 364
+#include "FreeRTOS.h"
+#include "task.h"
 
+#define CYCLES_PER_ONE_MILI_SECOND      (SYSCTL_SYSTEM_CLOCK_HZ / 1000ul)
+#define MILI_SECONDS_PER_TICK           (1000ul / configTICK_RATE_HZ)
 
-void _delay_ms(unsigned long long n)
+/* Busy-wait till the cycle clock reaches the end time */
+static void delay_waitCycles(uint64 endTime)
 {
-    volatile unsigned long long count = 0;
-    while(count++ < (NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND * n) );
+    while(TIMEBASE_getCycles() < endTime);
 }
 
 
+void _delay_us(uint32 n)
+{
+    delay_waitCycles(TIMEBASE_getCycles() + TIMEBASE_usToCycles(n));
+}
+
+
+void _delay_ms(uint32 n)
+{
+    uint64 endTime = TIMEBASE_getCycles() + ((uint64)n * CYCLES_PER_ONE_MILI_SECOND);
+
+    /* Yield only from a task (no active exception) while the scheduler is running */
+    if((n >= MILI_SECONDS_PER_TICK) &&
+       ((NVIC_INT_CTRL_R & 0x1FF) == 0) &&
+       (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        /* The current tick is partially elapsed so the task wakes after (ticks - 1) to (ticks) periods,
+         * so it wakes before the end time (unless higher priority tasks are ready) and busy-waits the rest */
+        vTaskDelay((TickType_t)(n / MILI_SECONDS_PER_TICK));
+    }
+
+    delay_waitCycles(endTime);
+}
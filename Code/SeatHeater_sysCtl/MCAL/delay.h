@@ -8,7 +8,26 @@
 #ifndef DELAY_H_
 #define DELAY_H_
 
-void _delay_ms(unsigned long long n);
+#include "std_types.h"
+
+/*
+ * NOTE:
+ *
+ * Both delays are measured by the timebase cycle counter, so TIMEBASE_init must be called before using them
+ * and they are accurate at any system clock and optimization level.
+ *
+ * _delay_us always busy-waits, use it only for short waits (hardware settling times) or from interrupts.
+ *
+ * _delay_ms blocks the calling task for the whole ticks of the wait if it's called from a task while the
+ * scheduler is running, so the lower priority tasks run meanwhile, and busy-waits only the remaining part of a tick.
+ * Before the scheduler starts or from an interrupt it busy-waits the whole time.
+ * Don't call it with a wait of one tick or more inside a critical section.
+ *
+ *  */
+
+void _delay_us(uint32 n);
+
+void _delay_ms(uint32 n);
 
 
 
@@ -438,6 +438,16 @@ Flash Registers
 #define FLASH_FMPPE2_REG          (*((volatile uint32 *)0x400FE408))
 #define FLASH_FMPPE3_REG          (*((volatile uint32 *)0x400FE40C))
 
+/*****************************************************************************
+Timer Registers (TIMER0)
+*****************************************************************************/
+#define TIMER0_CFG_REG            (*((volatile uint32 *)0x40030000))
+#define TIMER0_TAMR_REG           (*((volatile uint32 *)0x40030004))
+#define TIMER0_CTL_REG            (*((volatile uint32 *)0x4003000C))
+#define TIMER0_TAILR_REG          (*((volatile uint32 *)0x40030028))
+#define TIMER0_TAPR_REG           (*((volatile uint32 *)0x40030038))
+#define TIMER0_TAR_REG            (*((volatile uint32 *)0x40030048))
+
 /*****************************************************************************
 Timer Registers (WTIMER0)
 *****************************************************************************/
@@ -11,14 +11,33 @@
 /* Application file include */
 
 #include"APP/APP.h"
+#include"APP/Console.h"
+#include"APP/NVM.h"
+#include"APP/Supervisor.h"
+#include"APP/Trace.h"
+#include"APP/Plant.h"
+#include"APP/Crash.h"
+#include"APP/Jobs.h"
+#include"APP/QueueStats.h"
+#include"APP/History.h"
+#include"APP/Telemetry.h"
 
 
 int main(void)
 {
-
     /* Initialize all components */
     vSetupHardware();
 
+    /* Dump the crash from before the reset if there is one */
+    CRASH_init();
+
+    /* Restore the last desired levels and sensors calibration */
+    NVM_init();
+
+    /* The reports (console, sched, mutex contention, crash record) show the task names, so the names of the two instances
+     * of a task end with D (driver) or P (passenger) and every name is unique within configMAX_TASK_NAME_LEN (15 characters)
+     */
+#if (APP_PERIODIC_JOBS == 0)
     while(xTaskCreate( vRunTimeMeasurementsTask,   /* Task function implementation */
                  "Runtime measurements",           /* Task name (Debugging purposes) */
                  256,                              /* Stack size of the task : 256 words >> 1024 bytes */
@@ -26,6 +45,7 @@ int main(void)
                  4,                                /* Priority */
                  &task0handle                      /* Task handle to refer the Task */
     ) == pdFAIL);
+#endif
 
     while(xTaskCreate( vInitialValuesTask,   /* Task function implementation */
                  "Initial values",           /* Task name (Debugging purposes) */
@@ -35,8 +55,9 @@ int main(void)
                  &task1handle                        /* Task handle to refer the Task */
     ) == pdFAIL);
 
+#if (APP_PERIODIC_JOBS == 0)
     while(xTaskCreate( vTemperatureMonitoringTask, /* Task function implementation */
-                 "Temperature monitoring",   /* Task name (Debugging purposes) */
+                 "Temperature D",            /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&driver),           /* Passed parameter to refer driver instance */
                  1,                          /* Priority */
@@ -44,16 +65,27 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vTemperatureMonitoringTask, /* Task function implementation */
-                 "Temperature monitoring",   /* Task name (Debugging purposes) */
+                 "Temperature P",            /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&passenger),        /* Passed parameter to refer passenger instance */
                  1,                          /* Priority */
                  &task3handle                       /* Task handle to refer the Task */
     ) == pdFAIL);
+#else
+    /* The periodic activities share the stack of the timer task, the passenger sensor is read half a period after the driver one */
+    while(JOB_create("Runtime measurements", vRunTimeMeasurementsJob, NULL,
+                     RUNTIME_MEASUREMENTS_TASK_PERIODICITY, 0, RUNTIME_MEASUREMENTS_DEADLINE) == FALSE);
+
+    while(JOB_create("Temperature driver", vTemperatureMonitoringJob, (void*)(&driver),
+                     TEMPERATURE_SAMPLE_PERIOD_MS, TEMPERATURE_SAMPLE_PERIOD_MS, TEMPERATURE_MONITORING_JOB_DEADLINE) == FALSE);
+
+    while(JOB_create("Temperature passenger", vTemperatureMonitoringJob, (void*)(&passenger),
+                     TEMPERATURE_SAMPLE_PERIOD_MS, TEMPERATURE_SAMPLE_PERIOD_MS + (TEMPERATURE_SAMPLE_PERIOD_MS / 2u), TEMPERATURE_MONITORING_JOB_DEADLINE) == FALSE);
+#endif
 
 
     while(xTaskCreate( vButtonMonitoringTask,/* Task function implementation */
-                 "Button monitoring",        /* Task name (Debugging purposes) */
+                 "Button D",                 /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&driver),           /* Passed parameter to refer driver instance */
                  1,                          /* Priority */
@@ -61,7 +93,7 @@ int main(void)
     )== pdFAIL);
 
     while(xTaskCreate( vButtonMonitoringTask,/* Task function implementation */
-                 "Button monitoring",        /* Task name (Debugging purposes) */
+                 "Button P",                 /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&passenger),        /* Passed parameter to refer passenger instance */
                  1,                          /* Priority */
@@ -69,7 +101,7 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vHeatingLevelMonitoringTask,/* Task function implementation */
-                 "Heating level monitoring", /* Task name (Debugging purposes) */
+                 "Heating level D",          /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&driver),           /* Passed parameter to refer Driver instance */
                  1,                          /* Priority */
@@ -77,7 +109,7 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vHeatingLevelMonitoringTask,/* Task function implementation */
-                 "Heating level monitoring", /* Task name (Debugging purposes) */
+                 "Heating level P",          /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&passenger),        /* Passed parameter to refer Passenger instance */
                  1,                          /* Priority */
@@ -85,7 +117,7 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vDataProcessingTask,  /* Task function implementation */
-                 "Data processing",          /* Task name (Debugging purposes) */
+                 "Processing D",             /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&driver),           /* Passed parameter to refer Driver instance */
                  3,                          /* Priority */
@@ -93,7 +125,7 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vDataProcessingTask,  /* Task function implementation */
-                 "Data processing",          /* Task name (Debugging purposes) */
+                 "Processing P",             /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&passenger),        /* Passed parameter to refer Passenger instance */
                  3,                          /* Priority */
@@ -101,7 +133,7 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vHeaterHandlerTask,   /* Task function implementation */
-                 "Heating handler",          /* Task name (Debugging purposes) */
+                 "Heater D",                 /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&driver),           /* Passed parameter to refer Driver instance */
                  2,                          /* Priority */
@@ -109,18 +141,44 @@ int main(void)
     ) == pdFAIL);
 
     while(xTaskCreate( vHeaterHandlerTask,   /* Task function implementation */
-                 "Heating handler",          /* Task name (Debugging purposes) */
+                 "Heater P",                 /* Task name (Debugging purposes) */
                  256,                        /* Stack size of the task : 256 words >> 1024 bytes */
                  (void*)(&passenger),        /* Passed parameter to refer Passenger instance */
                  2,                          /* Priority */
                  &task9handle                        /* Task handle to refer the Task */
     ) == pdFAIL);
 
+    while(xTaskCreate( vConsoleTask,         /* Task function implementation */
+                 "Console",                  /* Task name (Debugging purposes) */
+                 256,                        /* Stack size of the task : 256 words >> 1024 bytes */
+                 NULL,                       /* Passed parameter to refer instance */
+                 1,                          /* Priority */
+                 &task12handle               /* Task handle to refer the Task */
+    ) == pdFAIL);
+
+    while(xTaskCreate( vNvmWriterTask,       /* Task function implementation */
+                 "NVM writer",               /* Task name (Debugging purposes) */
+                 256,                        /* Stack size of the task : 256 words >> 1024 bytes */
+                 NULL,                       /* Passed parameter to refer instance */
+                 1,                          /* Priority */
+                 &task13handle               /* Task handle to refer the Task */
+    ) == pdFAIL);
 
+    while(xTaskCreate( vSupervisorTask,      /* Task function implementation */
+                 "Supervisor",               /* Task name (Debugging purposes) */
+                 256,                        /* Stack size of the task : 256 words >> 1024 bytes */
+                 NULL,                       /* Passed parameter to refer instance */
+                 4,                          /* Priority */
+                 &task14handle               /* Task handle to refer the Task */
+    ) == pdFAIL);
+
+
+#if (APP_PERIODIC_JOBS == 0)
     vTaskSetApplicationTaskTag( task0handle, ( TaskHookFunction_t ) 1 );
-    vTaskSetApplicationTaskTag( task1handle, ( TaskHookFunction_t ) 2 );
     vTaskSetApplicationTaskTag( task2handle, ( TaskHookFunction_t ) 3 );
     vTaskSetApplicationTaskTag( task3handle, ( TaskHookFunction_t ) 4 );
+#endif
+    vTaskSetApplicationTaskTag( task1handle, ( TaskHookFunction_t ) 2 );
     vTaskSetApplicationTaskTag( task4handle, ( TaskHookFunction_t ) 5 );
     vTaskSetApplicationTaskTag( task5handle, ( TaskHookFunction_t ) 6 );
     vTaskSetApplicationTaskTag( task6handle, ( TaskHookFunction_t ) 7 );
@@ -129,6 +187,9 @@ int main(void)
     vTaskSetApplicationTaskTag( task9handle, ( TaskHookFunction_t ) 10 );
     vTaskSetApplicationTaskTag( task10handle, ( TaskHookFunction_t ) 11 );
     vTaskSetApplicationTaskTag( task11handle, ( TaskHookFunction_t ) 12 );
+    vTaskSetApplicationTaskTag( task12handle, ( TaskHookFunction_t ) 13 );
+    vTaskSetApplicationTaskTag( task13handle, ( TaskHookFunction_t ) 14 );
+    vTaskSetApplicationTaskTag( task14handle, ( TaskHookFunction_t ) 15 );
 
 
     /* This mutex for the mutual exclusion between Driver and passenger of ADC in any monitoring task */
@@ -137,39 +198,44 @@ int main(void)
     /* This mutex for the mutual exclusion between Driver and passenger of UART in any monitoring task */
     UART_mutex = xSemaphoreCreateMutex();
 
-    /* The following two queues refer to the temperature measured by temperature sensor in both seats */
-    Q_currentTempDriver = xQueueCreate(QUEUE_CURRENT_TEMP_SIZE,sizeof(uint8));
-    Q_currentTempPassenger = xQueueCreate(QUEUE_CURRENT_TEMP_SIZE,sizeof(uint8));
-
-    /* The following two queues refer to the temperature set by both driver and passenger by the push buttons */
-    Q_desiredTempDriver = xQueueCreate(QUEUE_DESIRED_TEMP_SIZE,sizeof(uint8));
-    Q_desiredTempPassenger = xQueueCreate(QUEUE_DESIRED_TEMP_SIZE,sizeof(uint8));
-
-    /* Each of the following queue sets combine both the current and desired temperature (queue set for driver and other for passenger) */
-    QS_DriverTemp = xQueueCreateSet(QUEUE_CURRENT_TEMP_SIZE+QUEUE_DESIRED_TEMP_SIZE);
-    QS_PassengerTemp = xQueueCreateSet(QUEUE_CURRENT_TEMP_SIZE+QUEUE_DESIRED_TEMP_SIZE);
-
-    /* Adding every previous queue into it's related queue set */
-    xQueueAddToSet(Q_currentTempDriver, QS_DriverTemp);
-    xQueueAddToSet(Q_desiredTempDriver, QS_DriverTemp);
-    xQueueAddToSet(Q_currentTempPassenger, QS_PassengerTemp);
-    xQueueAddToSet(Q_desiredTempPassenger, QS_PassengerTemp);
+    /* Every input of the DataProcessing task of each seat (current temperature, desired level, fault and control updates) */
+    Q_inputDriver = xQueueCreate(QUEUE_INPUT_SIZE,sizeof(inputMessage_Type));
+    Q_inputPassenger = xQueueCreate(QUEUE_INPUT_SIZE,sizeof(inputMessage_Type));
+    QSTATS_register(Q_inputDriver, "inputDriver", sizeof(inputMessage_Type));
+    QSTATS_register(Q_inputPassenger, "inputPassenger", sizeof(inputMessage_Type));
 
-    /* Heater handler pass heating level of driver seat through this queue to be monitored */
-    Q_heatingLevelDriver = xQueueCreate(QUEUE_HEATING_LEVEL_SIZE,sizeof(uint8));
-
-    /* Heater handler pass heating level of passenger seat through this queue to be monitored */
-    Q_heatingLevelPassenger = xQueueCreate(QUEUE_HEATING_LEVEL_SIZE,sizeof(uint8));
+    /* The desired levels restored from the NVM are the first desired temperature of both seats */
+    APP_sendInput(DRIVER, INPUT_DESIRED_LEVEL, g_desiredLevel[DRIVER], 0);
+    APP_sendInput(PASSENGER, INPUT_DESIRED_LEVEL, g_desiredLevel[PASSENGER], 0);
 
     /* Data processing task pass heating level of driver seat through this queue to be handled */
     Q_heatingModeDriver = xQueueCreate(QUEUE_HEATING_MODE_SIZE,sizeof(uint8));
+    QSTATS_register(Q_heatingModeDriver, "heatingModeDriver", sizeof(uint8));
 
     /* Data processing task pass heating level of passenger seat through this queue to be handled */
     Q_heatingModePassenger = xQueueCreate(QUEUE_HEATING_MODE_SIZE,sizeof(uint8));
+    QSTATS_register(Q_heatingModePassenger, "heatingModePassenger", sizeof(uint8));
 
     /* This event group has 3 used bits for the 3 push buttons, the ISR set them and button monitoring task wait for them to be set */
     PB_group = xEventGroupCreate();
 
+    /* Replay queue and timer of the traces */
+    TRACE_init();
+
+    /* Step timer of the seats thermal model */
+    PLANT_init();
+
+    /* Sampling timer of the temperature history */
+    HISTORY_init();
+
+    /* Snapshot timer of the binary telemetry, it's started by the console */
+    TELEMETRY_init();
+
+    /* Last as the supervisor starts feeding it only when the scheduler starts, so the crash dump and the EEPROM scan
+     * above don't count against the time-out
+     */
+    WDT0_init(SUPERVISOR_WATCHDOG_TIMEOUT, WATCHDOG_INTERRUPT_PRIORITY);
+
     vTaskStartScheduler();
 
     /* Should never reach here!  If you do then there was not enough heap
@@ -40,6 +40,9 @@ SECTIONS
     .bss    :   > SRAM
     .sysmem :   > SRAM
     .stack  :   > SRAM
+
+    /* Not initialized at start-up, it keeps the crash record across the reset */
+    .noinit :   > SRAM, type = NOINIT
 }
 
 __STACK_TOP = __stack + 512;
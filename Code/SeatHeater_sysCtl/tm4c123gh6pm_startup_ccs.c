@@ -40,6 +40,11 @@ extern void xPortPendSVHandler(void);
 
 void ISR_PORTBhandler(void);
 void ISR_PORTFhandler(void);
+void ISR_UART0handler(void);
+void ISR_ADC0Seq1handler(void);
+void ISR_WDT0handler(void);
+
+extern void CRASH_faultHandler(uint32_t* frame, uint32_t excReturn);
 
 //void ADC0_handler(void);
 
@@ -97,7 +102,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // GPIO Port C
     IntDefaultHandler,                      // GPIO Port D
     IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx
+    ISR_UART0handler,                      // UART0 Rx and Tx
     IntDefaultHandler,                      // UART1 Rx and Tx
     IntDefaultHandler,                      // SSI0 Rx and Tx
     IntDefaultHandler,                      // I2C0 Master and Slave
@@ -107,10 +112,10 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM Generator 2
     IntDefaultHandler,                      // Quadrature Encoder 0
     IntDefaultHandler,                      // ADC Sequence 0
-    IntDefaultHandler,                      // ADC Sequence 1
+    ISR_ADC0Seq1handler,                    // ADC Sequence 1
     IntDefaultHandler,                      // ADC Sequence 2
     IntDefaultHandler,                        // ADC Sequence 3
-    IntDefaultHandler,                      // Watchdog timer
+    ISR_WDT0handler,                        // Watchdog timer
     IntDefaultHandler,                      // Timer 0 subtimer A
     IntDefaultHandler,                      // Timer 0 subtimer B
     IntDefaultHandler,                      // Timer 1 subtimer A
@@ -275,35 +280,38 @@ NmiSR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  It passes the stacked frame (from the process stack in a task,
+// otherwise from the main stack) and EXC_RETURN to the crash capture, which
+// drives the heaters to the safe state, saves the crash record and resets.
 //
 //*****************************************************************************
 static void
 FaultISR(void)
 {
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
+    __asm("    .global CRASH_faultHandler\n"
+          "    tst     lr, #4\n"
+          "    ite     eq\n"
+          "    mrseq   r0, msp\n"
+          "    mrsne   r0, psp\n"
+          "    mov     r1, lr\n"
+          "    b.w     CRASH_faultHandler");
 }
 
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  It's captured the same as a fault, the vector number is saved
+// in the crash record.
 //
 //*****************************************************************************
 static void
 IntDefaultHandler(void)
 {
-    //
-    // Go into an infinite loop.
-    //
-    while(1)
-    {
-    }
+    __asm("    .global CRASH_faultHandler\n"
+          "    tst     lr, #4\n"
+          "    ite     eq\n"
+          "    mrseq   r0, msp\n"
+          "    mrsne   r0, psp\n"
+          "    mov     r1, lr\n"
+          "    b.w     CRASH_faultHandler");
 }
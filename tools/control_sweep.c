@@ -0,0 +1,910 @@
+/**********************************************************************************************************
+ *
+ * Module: Control sweep
+ *
+ * File Name: control_sweep.c
+ *
+ * Description: Host batch runner of the heating control (Code/SeatHeater_sysCtl/APP/Control.h) against the seat
+ *              model (Code/SeatHeater_sysCtl/APP/PlantModel.h), it sweeps the control parameters over a grid or by
+ *              Monte Carlo on a work stealing thread pool and ranks them by settling time, overshoot and switching
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+/*
+ * Usage (Linux, gcc or clang) :
+ *
+ *   cc -O2 -pthread -ICode/SeatHeater_sysCtl -o control_sweep tools/control_sweep.c
+ *   ./control_sweep [options] > ranking.csv
+ *
+ *   --high min:max[:step]       high band in degrees (default 6:14:2)
+ *   --medium min:max[:step]     medium band in degrees (default 3:8)
+ *   --low min:max[:step]        low band in degrees (default 1:4)
+ *   --threshold min:max[:step]  change threshold in degrees (default 1:3)
+ *   --period min:max[:step]     sample period in ms (default 100:1000:300)
+ *   --ambient min:max[:step]    cabin temperature in degrees (default 5:15:10)
+ *   --noise min:max[:step]      sensor noise in ADC counts (default 1:10:9)
+ *   --duration seconds          simulated seconds of every run (default 1800)
+ *   --samples n                 Monte Carlo : n random parameter sets out of the ranges instead of the whole grid
+ *   --runs n                    Monte Carlo : n random scenarios within the ambient and noise ranges (default 32)
+ *   --seed n                    seed of the Monte Carlo draws (default 1)
+ *   --threads n                 worker threads (default every online core)
+ *   --w-overshoot s             seconds of cost per degree of mean overshoot (default 60)
+ *   --w-switch s                seconds of cost per mean heater switch (default 2)
+ *   --scaling                   run the sweep again on 1, 2, 4 ... threads and report the speedup on stderr
+ *
+ * Control.c, PlantModel.c and HAL/Temperature_sensor.c are built as they are, the hardware functions the sensor
+ * module calls are stubs that are never called. Every run is one seat : it starts at the cabin temperature with the
+ * heater off, then every sample period the model advances, the sensor is read with noise and converted by the default
+ * calibration, and like the monitoring and DataProcessing tasks the heater mode is decided again whenever the
+ * temperature moved by the change threshold. The fault detection isn't replayed, its state is global and the
+ * scenarios stay in the valid range anyway, so the sensor is never faulty.
+ *
+ * A scenario is a cabin profile (constant, warming up by 15 degrees or dropping by 15 degrees at half of the run),
+ * a cabin temperature, a sensor noise and a desired level (LOW, MEDIUM, HIGH). Every parameter set runs the same
+ * scenarios with the same noise seeds, so the sets are compared on the same conditions. On 64 bit hosts uint32 is
+ * 64 bits so the noise sequence isn't the one of the target, only its distribution is the same.
+ *
+ * The ranking (CSV on stdout) is sorted by cost : mean settling time (a run that never settled counts the whole
+ * duration) + overshoot weight * mean overshoot + switch weight * mean switches. The results only depend on the
+ * options, not on the number of threads nor on the order in which the runs end.
+ *
+ * Work stealing : the runs are split in equal ranges, one per worker. A worker takes the runs of its own range from
+ * the front one by one, once it's empty it steals the back half of the range of another worker. A range is one
+ * 64 bit word (begin, end) changed only by compare and swap, so the owner and the thieves never lock.
+ */
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#define _GNU_SOURCE
+#include<pthread.h>
+#include<sched.h>
+#include<stdatomic.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<time.h>
+#include<unistd.h>
+
+#include"APP/Control.c"
+#include"APP/PlantModel.c"
+#include"HAL/Temperature_sensor.c"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+#define SWEEP_MAX_THREADS       256u
+#define SWEEP_MAX_VALUES        256u
+
+/* Cabin temperature change of the ramp and drop profiles */
+#define SWEEP_PROFILE_CHANGE    15.0f
+
+/* Every run is read by the calibration of the driver zone (both zones have the same default calibration) */
+#define SWEEP_ZONE              0u
+
+#define SWEEP_FIELD_HIGH        0u
+#define SWEEP_FIELD_MEDIUM      1u
+#define SWEEP_FIELD_LOW         2u
+#define SWEEP_FIELD_THRESHOLD   3u
+#define SWEEP_FIELD_PERIOD      4u
+#define SWEEP_FIELD_AMBIENT     5u
+#define SWEEP_FIELD_NOISE       6u
+#define SWEEP_FIELDS            7u
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef enum{
+
+    SWEEP_PROFILE_CONSTANT,
+    SWEEP_PROFILE_RAMP,
+    SWEEP_PROFILE_DROP,
+    SWEEP_PROFILES
+
+}SWEEP_profileType;
+
+typedef struct{
+
+    uint32 min;
+    uint32 max;
+    uint32 step;
+
+}SWEEP_rangeType;
+
+typedef struct{
+
+    controlConfig_Type control;
+    uint32 periodMs;
+
+}SWEEP_setType;
+
+typedef struct{
+
+    SWEEP_profileType profile;
+    float32 ambientTemperature;
+    uint8 noise;
+    heatingMode_Type desiredLevel;
+    uint32 seed;
+
+}SWEEP_scenarioType;
+
+typedef struct{
+
+    float32 settlingTime;
+    float32 overshoot;
+    float32 energy;
+    uint32 switches;
+    boolean isSettled;
+
+}SWEEP_resultType;
+
+typedef struct{
+
+    uint32 set;
+    uint32 runs;
+    float64 settledPercent;
+    float64 settlingMean;
+    float64 settlingMax;
+    float64 overshootMean;
+    float64 overshootMax;
+    float64 switchesMean;
+    float64 energyMean;
+    float64 cost;
+
+}SWEEP_rankType;
+
+/* One range of runs per worker, aligned on a cache line so the workers don't share lines */
+typedef struct{
+
+    /* Begin in the high 32 bits, end in the low 32 bits */
+    _Atomic uint64 range;
+
+    uint64 runs;
+    uint64 steals;
+    uint64 seed;
+    pthread_t thread;
+
+}__attribute__((aligned(64))) SWEEP_workerType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static const char* const g_fieldNames[SWEEP_FIELDS] = {"high", "medium", "low", "threshold", "period", "ambient", "noise"};
+
+static SWEEP_rangeType g_ranges[SWEEP_FIELDS] = {
+
+    {6, 14, 2},         /* High band */
+    {3, 8, 1},          /* Medium band */
+    {1, 4, 1},          /* Low band */
+    {1, 3, 1},          /* Change threshold */
+    {100, 1000, 300},   /* Sample period (ms) */
+    {5, 15, 10},        /* Cabin temperature */
+    {1, 10, 9}          /* Sensor noise */
+};
+
+static SWEEP_setType* g_sets;
+static uint32 g_setsNum;
+
+static SWEEP_scenarioType* g_scenarios;
+static uint32 g_scenariosNum;
+
+static SWEEP_resultType* g_results;
+
+static float32 g_duration = 1800.0f;
+
+static SWEEP_workerType g_workers[SWEEP_MAX_THREADS];
+static uint32 g_workersNum;
+
+/* Runs not finished yet, the workers stop once it's 0 */
+static _Atomic uint64 g_remaining;
+
+/****************************************************************************
+ *                        Hardware stubs (never called)
+ * ************************************************************************/
+
+ADC_configType configs;
+volatile uint16 g_channelReading;
+
+void ADC_init(const ADC_configType* config){}
+uint16 ADC_readChannel(uint8 channel){ return 0; }
+void ADC_comparatorInit(const uint8* channels, uint8 channelsNum, uint8 priority){}
+void ADC_comparatorSetWindow(uint8 window, uint16 low, uint16 high){}
+void GPTM_Timer0ADCTriggerInit(uint32 periodMs){}
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* splitmix64, every draw is derived from its indexes so it doesn't depend on the thread running it */
+static uint64 SWEEP_hash(uint64 x){
+
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+
+    return x ^ (x >> 31);
+}
+
+static uint32 SWEEP_count(const SWEEP_rangeType* range){
+
+    return ((range->max - range->min) / range->step) + 1u;
+}
+
+static uint32 SWEEP_value(const SWEEP_rangeType* range, uint32 index){
+
+    return range->min + (index * range->step);
+}
+
+static uint32 SWEEP_draw(const SWEEP_rangeType* range, uint64* seed){
+
+    *seed = SWEEP_hash(*seed);
+
+    return SWEEP_value(range, (uint32)(*seed % SWEEP_count(range)));
+}
+
+/* Parses min:max[:step] or a single value */
+static boolean SWEEP_parseRange(const char* text, SWEEP_rangeType* range){
+
+    unsigned long min;
+    unsigned long max;
+    unsigned long step = 1;
+    int fields = sscanf(text, "%lu:%lu:%lu", &min, &max, &step);
+
+    if(fields == 1){
+
+        max = min;
+    }
+
+    if((fields < 1) || (max < min) || (step == 0) || (((max - min) / step) >= SWEEP_MAX_VALUES)){
+
+        return FALSE;
+    }
+
+    range->min = (uint32)min;
+    range->max = (uint32)max;
+    range->step = (uint32)step;
+
+    return TRUE;
+}
+
+static boolean SWEEP_isValidRanges(void){
+
+    return (g_ranges[SWEEP_FIELD_HIGH].max <= 255u) && (g_ranges[SWEEP_FIELD_MEDIUM].max <= 255u) &&
+           (g_ranges[SWEEP_FIELD_LOW].max <= 255u) && (g_ranges[SWEEP_FIELD_THRESHOLD].max <= 255u) &&
+           (g_ranges[SWEEP_FIELD_PERIOD].min != 0) && (g_ranges[SWEEP_FIELD_AMBIENT].max <= TEMPERATURE_MAX) &&
+           (g_ranges[SWEEP_FIELD_NOISE].max <= 255u);
+}
+
+static void SWEEP_setFromValues(SWEEP_setType* set, const uint32* values){
+
+    set->control.highBand = (uint8)values[SWEEP_FIELD_HIGH];
+    set->control.mediumBand = (uint8)values[SWEEP_FIELD_MEDIUM];
+    set->control.lowBand = (uint8)values[SWEEP_FIELD_LOW];
+    set->control.changeThreshold = (uint8)values[SWEEP_FIELD_THRESHOLD];
+    set->periodMs = values[SWEEP_FIELD_PERIOD];
+}
+
+/* Every valid combination of the ranges */
+static void SWEEP_buildGrid(void){
+
+    uint32 counts[SWEEP_FIELD_PERIOD + 1u];
+    uint32 values[SWEEP_FIELD_PERIOD + 1u];
+    uint32 total = 1;
+    uint32 n;
+    uint32 rest;
+    uint32 field;
+
+    for(field = 0; field <= SWEEP_FIELD_PERIOD; field++){
+
+        counts[field] = SWEEP_count(&g_ranges[field]);
+        total *= counts[field];
+    }
+
+    g_sets = malloc(total * sizeof(SWEEP_setType));
+    g_setsNum = 0;
+
+    for(n = 0; n < total; n++){
+
+        rest = n;
+
+        for(field = SWEEP_FIELD_PERIOD + 1u; field-- > 0;){
+
+            values[field] = SWEEP_value(&g_ranges[field], rest % counts[field]);
+            rest /= counts[field];
+        }
+
+        SWEEP_setFromValues(&g_sets[g_setsNum], values);
+
+        if(CONTROL_isValid(&g_sets[g_setsNum].control) == TRUE){
+
+            g_setsNum++;
+        }
+    }
+}
+
+static boolean SWEEP_isDrawn(const SWEEP_setType* set){
+
+    uint32 i;
+
+    for(i = 0; i < g_setsNum; i++){
+
+        if((memcmp(&g_sets[i].control, &set->control, sizeof(controlConfig_Type)) == 0) && (g_sets[i].periodMs == set->periodMs)){
+
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* Distinct random valid sets out of the ranges, returns FALSE if the ranges have fewer valid sets than the samples */
+static boolean SWEEP_buildSamples(uint32 samples, uint64 seed){
+
+    uint32 values[SWEEP_FIELD_PERIOD + 1u];
+    uint32 tries = 0;
+    uint32 field;
+
+    g_sets = malloc(samples * sizeof(SWEEP_setType));
+    g_setsNum = 0;
+    seed = SWEEP_hash(seed ^ 0x5E75ull);
+
+    while(g_setsNum < samples){
+
+        for(field = 0; field <= SWEEP_FIELD_PERIOD; field++){
+
+            values[field] = SWEEP_draw(&g_ranges[field], &seed);
+        }
+
+        SWEEP_setFromValues(&g_sets[g_setsNum], values);
+
+        if((CONTROL_isValid(&g_sets[g_setsNum].control) == TRUE) && (SWEEP_isDrawn(&g_sets[g_setsNum]) == FALSE)){
+
+            g_setsNum++;
+            tries = 0;
+        }
+        else if(++tries > 100000u){
+
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/* Every profile, cabin temperature, noise and desired level of the ranges */
+static void SWEEP_buildScenarios(void){
+
+    uint32 ambients = SWEEP_count(&g_ranges[SWEEP_FIELD_AMBIENT]);
+    uint32 noises = SWEEP_count(&g_ranges[SWEEP_FIELD_NOISE]);
+    uint32 profile;
+    uint32 ambient;
+    uint32 noise;
+    uint32 level;
+    SWEEP_scenarioType* scenario;
+
+    g_scenarios = malloc(SWEEP_PROFILES * ambients * noises * HEATER_HIGH * sizeof(SWEEP_scenarioType));
+    g_scenariosNum = 0;
+
+    for(profile = 0; profile < SWEEP_PROFILES; profile++){
+        for(ambient = 0; ambient < ambients; ambient++){
+            for(noise = 0; noise < noises; noise++){
+                for(level = HEATER_LOW; level <= HEATER_HIGH; level++){
+
+                    scenario = &g_scenarios[g_scenariosNum];
+                    scenario->profile = (SWEEP_profileType)profile;
+                    scenario->ambientTemperature = (float32)SWEEP_value(&g_ranges[SWEEP_FIELD_AMBIENT], ambient);
+                    scenario->noise = (uint8)SWEEP_value(&g_ranges[SWEEP_FIELD_NOISE], noise);
+                    scenario->desiredLevel = (heatingMode_Type)level;
+                    scenario->seed = (uint32)SWEEP_hash(g_scenariosNum);
+                    g_scenariosNum++;
+                }
+            }
+        }
+    }
+}
+
+/* Random scenarios within the ranges */
+static void SWEEP_buildRandomScenarios(uint32 runs, uint64 seed){
+
+    SWEEP_scenarioType* scenario;
+    uint32 i;
+
+    g_scenarios = malloc(runs * sizeof(SWEEP_scenarioType));
+    g_scenariosNum = runs;
+    seed = SWEEP_hash(seed ^ 0x5CE7ull);
+
+    for(i = 0; i < runs; i++){
+
+        scenario = &g_scenarios[i];
+
+        seed = SWEEP_hash(seed);
+        scenario->profile = (SWEEP_profileType)(seed % SWEEP_PROFILES);
+        scenario->ambientTemperature = (float32)SWEEP_draw(&g_ranges[SWEEP_FIELD_AMBIENT], &seed);
+        scenario->noise = (uint8)SWEEP_draw(&g_ranges[SWEEP_FIELD_NOISE], &seed);
+        seed = SWEEP_hash(seed);
+        scenario->desiredLevel = (heatingMode_Type)(HEATER_LOW + (seed % HEATER_HIGH));
+        seed = SWEEP_hash(seed);
+        scenario->seed = (uint32)seed;
+    }
+}
+
+static float32 SWEEP_ambient(const SWEEP_scenarioType* scenario, float32 time){
+
+    switch(scenario->profile){
+
+    case SWEEP_PROFILE_RAMP:
+        return scenario->ambientTemperature + ((SWEEP_PROFILE_CHANGE * time) / g_duration);
+
+    case SWEEP_PROFILE_DROP:
+        return (time < (g_duration / 2.0f)) ? (scenario->ambientTemperature + SWEEP_PROFILE_CHANGE)
+                                            : scenario->ambientTemperature;
+
+    case SWEEP_PROFILE_CONSTANT:
+    default:
+        return scenario->ambientTemperature;
+    }
+}
+
+/* One seat from the cabin temperature with the heater off for the whole duration */
+static void SWEEP_run(uint32 run){
+
+    const SWEEP_setType* set = &g_sets[run / g_scenariosNum];
+    const SWEEP_scenarioType* scenario = &g_scenarios[run % g_scenariosNum];
+    const TEMPSENSOR_calibrationType* calibration = &TEMPSENSOR_calibration[SWEEP_ZONE];
+    desiredTemp_Type desiredTemperature = CONTROL_desiredTemperature(scenario->desiredLevel);
+    SWEEP_resultType* result = &g_results[run];
+    PLANT_modelType model;
+    float32 stepTime = set->periodMs / 1000.0f;
+    float32 power = 0.0f;
+    uint32 seed = scenario->seed;
+    uint32 steps = (uint32)((g_duration * 1000.0f) / set->periodMs);
+    uint32 step;
+    uint8 previousTemperature;
+    uint8 currentTemperature;
+
+    PLANT_modelStart(&model, SWEEP_ambient(scenario, 0.0f), power, desiredTemperature);
+
+    /* The monitoring task sends its first reading whatever it is */
+    previousTemperature = TEMPSENSOR_rawToTemperature(SWEEP_ZONE, PLANT_modelReading(&model, calibration, scenario->noise, &seed));
+    power = PLANT_modePower(CONTROL_decide(&set->control, desiredTemperature, previousTemperature, FALSE));
+
+    for(step = 0; step < steps; step++){
+
+        PLANT_modelStep(&model, power, SWEEP_ambient(scenario, model.report.time), stepTime);
+
+        currentTemperature = TEMPSENSOR_rawToTemperature(SWEEP_ZONE, PLANT_modelReading(&model, calibration, scenario->noise, &seed));
+
+        if(CONTROL_isChanged(&set->control, currentTemperature, previousTemperature) == TRUE){
+
+            previousTemperature = currentTemperature;
+            power = PLANT_modePower(CONTROL_decide(&set->control, desiredTemperature, currentTemperature, FALSE));
+        }
+    }
+
+    result->isSettled = model.report.isSettled;
+    result->settlingTime = (model.report.isSettled == TRUE) ? model.report.settlingTime : model.report.time;
+    result->overshoot = model.report.overshoot;
+    result->switches = model.report.switches;
+    result->energy = model.report.energy;
+}
+
+static uint64 SWEEP_pack(uint32 begin, uint32 end){
+
+    return ((uint64)begin << 32) | end;
+}
+
+/* Takes the front run of the own range, returns FALSE if it's empty */
+static boolean SWEEP_pop(SWEEP_workerType* worker, uint32* run){
+
+    uint64 range = atomic_load(&worker->range);
+    uint32 begin;
+    uint32 end;
+
+    do{
+
+        begin = (uint32)(range >> 32);
+        end = (uint32)(range & 0xFFFFFFFFull);
+
+        if(begin >= end){
+
+            return FALSE;
+        }
+
+    }while(atomic_compare_exchange_weak(&worker->range, &range, SWEEP_pack(begin + 1u, end)) == 0);
+
+    *run = begin;
+
+    return TRUE;
+}
+
+/* Moves the back half of the range of a victim into the own (empty) range, returns FALSE if every victim is empty */
+static boolean SWEEP_steal(SWEEP_workerType* thief){
+
+    SWEEP_workerType* victim;
+    uint64 range;
+    uint32 begin;
+    uint32 end;
+    uint32 middle;
+    uint32 first;
+    uint32 i;
+
+    thief->seed = SWEEP_hash(thief->seed);
+    first = (uint32)(thief->seed % g_workersNum);
+
+    for(i = 0; i < g_workersNum; i++){
+
+        victim = &g_workers[(first + i) % g_workersNum];
+
+        if(victim == thief){
+
+            continue;
+        }
+
+        range = atomic_load(&victim->range);
+
+        do{
+
+            begin = (uint32)(range >> 32);
+            end = (uint32)(range & 0xFFFFFFFFull);
+            middle = begin + ((end - begin) / 2u);
+
+            if(begin >= end){
+
+                break;
+            }
+
+        }while(atomic_compare_exchange_weak(&victim->range, &range, SWEEP_pack(begin, middle)) == 0);
+
+        if(begin < end){
+
+            /* Only the owner fills its range and only while it's empty, so a plain store is enough */
+            atomic_store(&thief->range, SWEEP_pack(middle, end));
+            thief->steals++;
+
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static void* SWEEP_worker(void* argument){
+
+    SWEEP_workerType* worker = argument;
+    uint32 run;
+
+    while(atomic_load(&g_remaining) != 0){
+
+        if(SWEEP_pop(worker, &run) == TRUE){
+
+            SWEEP_run(run);
+            worker->runs++;
+            atomic_fetch_sub(&g_remaining, 1u);
+        }
+        else if(SWEEP_steal(worker) == FALSE){
+
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Runs every set on every scenario on the threads, returns the wall time in seconds */
+static double SWEEP_runAll(uint32 threads, uint64* steals){
+
+    uint32 total = g_setsNum * g_scenariosNum;
+    struct timespec start;
+    struct timespec end;
+    uint32 i;
+
+    g_workersNum = threads;
+    atomic_store(&g_remaining, total);
+
+    for(i = 0; i < threads; i++){
+
+        atomic_store(&g_workers[i].range, SWEEP_pack((uint32)(((uint64)total * i) / threads),
+                                                     (uint32)(((uint64)total * (i + 1u)) / threads)));
+        g_workers[i].runs = 0;
+        g_workers[i].steals = 0;
+        g_workers[i].seed = i + 1u;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(i = 1; i < threads; i++){
+
+        pthread_create(&g_workers[i].thread, NULL, SWEEP_worker, &g_workers[i]);
+    }
+
+    SWEEP_worker(&g_workers[0]);
+
+    for(i = 1; i < threads; i++){
+
+        pthread_join(g_workers[i].thread, NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *steals = 0;
+
+    for(i = 0; i < threads; i++){
+
+        *steals += g_workers[i].steals;
+    }
+
+    return (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+}
+
+static int SWEEP_compareRanks(const void* a, const void* b){
+
+    const SWEEP_rankType* first = a;
+    const SWEEP_rankType* second = b;
+
+    if(first->cost != second->cost){
+
+        return (first->cost < second->cost) ? -1 : 1;
+    }
+
+    return (first->set < second->set) ? -1 : 1;
+}
+
+/* Ranks the sets by their results in run order, so the ranking doesn't depend on the threads */
+static void SWEEP_rank(SWEEP_rankType* ranks, float64 overshootWeight, float64 switchWeight){
+
+    const SWEEP_resultType* result;
+    SWEEP_rankType* rank;
+    uint32 set;
+    uint32 scenario;
+    uint32 settled;
+
+    for(set = 0; set < g_setsNum; set++){
+
+        rank = &ranks[set];
+        memset(rank, 0, sizeof(*rank));
+        rank->set = set;
+        rank->runs = g_scenariosNum;
+        settled = 0;
+
+        for(scenario = 0; scenario < g_scenariosNum; scenario++){
+
+            result = &g_results[(set * g_scenariosNum) + scenario];
+
+            settled += result->isSettled;
+            rank->settlingMean += result->settlingTime;
+            rank->overshootMean += result->overshoot;
+            rank->switchesMean += result->switches;
+            rank->energyMean += result->energy;
+
+            if(result->settlingTime > rank->settlingMax){
+
+                rank->settlingMax = result->settlingTime;
+            }
+
+            if(result->overshoot > rank->overshootMax){
+
+                rank->overshootMax = result->overshoot;
+            }
+        }
+
+        rank->settledPercent = (100.0 * settled) / g_scenariosNum;
+        rank->settlingMean /= g_scenariosNum;
+        rank->overshootMean /= g_scenariosNum;
+        rank->switchesMean /= g_scenariosNum;
+        rank->energyMean /= g_scenariosNum;
+        rank->cost = rank->settlingMean + (overshootWeight * rank->overshootMean) + (switchWeight * rank->switchesMean);
+    }
+
+    qsort(ranks, g_setsNum, sizeof(SWEEP_rankType), SWEEP_compareRanks);
+}
+
+static void SWEEP_printRanking(const SWEEP_rankType* ranks){
+
+    const SWEEP_setType* set;
+    uint32 i;
+
+    printf("rank,high_band,medium_band,low_band,change_threshold,period_ms,runs,settled_percent,"
+           "settling_mean_s,settling_max_s,overshoot_mean,overshoot_max,switches_mean,energy_mean_kj,cost\n");
+
+    for(i = 0; i < g_setsNum; i++){
+
+        set = &g_sets[ranks[i].set];
+
+        printf("%lu,%u,%u,%u,%u,%lu,%lu,%.1f,%.1f,%.1f,%.2f,%.2f,%.1f,%.1f,%.1f\n",
+               (unsigned long)(i + 1u), set->control.highBand, set->control.mediumBand, set->control.lowBand,
+               set->control.changeThreshold, (unsigned long)set->periodMs, (unsigned long)ranks[i].runs,
+               ranks[i].settledPercent, ranks[i].settlingMean, ranks[i].settlingMax, ranks[i].overshootMean,
+               ranks[i].overshootMax, ranks[i].switchesMean, ranks[i].energyMean / 1000.0, ranks[i].cost);
+    }
+}
+
+static void SWEEP_usage(const char* name){
+
+    fprintf(stderr, "usage: %s [--high|--medium|--low|--threshold|--period|--ambient|--noise min:max[:step]]\n"
+                    "       [--duration s] [--samples n] [--runs n] [--seed n] [--threads n]\n"
+                    "       [--w-overshoot s] [--w-switch s] [--scaling]\n", name);
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    SWEEP_rankType* ranks;
+    SWEEP_resultType* reference;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32 threads = (cores > 0) ? (uint32)cores : 1u;
+    uint32 samples = 0;
+    uint32 runs = 32;
+    uint64 seed = 1;
+    uint64 steals;
+    float64 overshootWeight = 60.0;
+    float64 switchWeight = 2.0;
+    boolean isScaling = FALSE;
+    boolean isValid = TRUE;
+    double seconds;
+    double baseSeconds;
+    uint32 field;
+    uint32 n;
+    int i;
+
+    for(i = 1; (i < argc) && (isValid == TRUE); i++){
+
+        for(field = 0; field < SWEEP_FIELDS; field++){
+
+            if((strncmp(argv[i], "--", 2) == 0) && (strcmp(argv[i] + 2, g_fieldNames[field]) == 0)){
+
+                break;
+            }
+        }
+
+        if(strcmp(argv[i], "--scaling") == 0){
+
+            isScaling = TRUE;
+        }
+        else if(i + 1 >= argc){
+
+            isValid = FALSE;
+        }
+        else if(field < SWEEP_FIELDS){
+
+            isValid = SWEEP_parseRange(argv[++i], &g_ranges[field]);
+        }
+        else if(strcmp(argv[i], "--duration") == 0){
+
+            g_duration = strtof(argv[++i], NULL);
+            isValid = (boolean)(g_duration >= 1.0f);
+        }
+        else if(strcmp(argv[i], "--samples") == 0){
+
+            samples = (uint32)strtoul(argv[++i], NULL, 10);
+            isValid = (boolean)(samples != 0);
+        }
+        else if(strcmp(argv[i], "--runs") == 0){
+
+            runs = (uint32)strtoul(argv[++i], NULL, 10);
+            isValid = (boolean)(runs != 0);
+        }
+        else if(strcmp(argv[i], "--seed") == 0){
+
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--threads") == 0){
+
+            threads = (uint32)strtoul(argv[++i], NULL, 10);
+            isValid = (boolean)((threads != 0) && (threads <= SWEEP_MAX_THREADS));
+        }
+        else if(strcmp(argv[i], "--w-overshoot") == 0){
+
+            overshootWeight = strtod(argv[++i], NULL);
+        }
+        else if(strcmp(argv[i], "--w-switch") == 0){
+
+            switchWeight = strtod(argv[++i], NULL);
+        }
+        else{
+
+            isValid = FALSE;
+        }
+    }
+
+    if((isValid == FALSE) || (SWEEP_isValidRanges() == FALSE)){
+
+        SWEEP_usage(argv[0]);
+        return 2;
+    }
+
+    if(threads > SWEEP_MAX_THREADS){
+
+        threads = SWEEP_MAX_THREADS;
+    }
+
+    if(samples == 0){
+
+        SWEEP_buildGrid();
+        SWEEP_buildScenarios();
+    }
+    else{
+
+        if(SWEEP_buildSamples(samples, seed) == FALSE){
+
+            fprintf(stderr, "fewer valid parameter sets (high > medium > low, threshold > 0) than samples within the ranges\n");
+            return 2;
+        }
+
+        SWEEP_buildRandomScenarios(runs, seed);
+    }
+
+    if((g_setsNum == 0) || ((uint64)g_setsNum * g_scenariosNum > 0xFFFFFFFFull)){
+
+        fprintf(stderr, "%s\n", (g_setsNum == 0) ? "no valid parameter set (high > medium > low, threshold > 0) within the ranges"
+                                                 : "too many runs");
+        return 2;
+    }
+
+    g_results = calloc((size_t)g_setsNum * g_scenariosNum, sizeof(SWEEP_resultType));
+    reference = calloc((size_t)g_setsNum * g_scenariosNum, sizeof(SWEEP_resultType));
+    ranks = malloc(g_setsNum * sizeof(SWEEP_rankType));
+
+    fprintf(stderr, "# %s sweep : %lu parameter sets x %lu scenarios = %lu runs of %.0f simulated s, %lu threads\n",
+            (samples == 0) ? "grid" : "Monte Carlo", (unsigned long)g_setsNum, (unsigned long)g_scenariosNum,
+            (unsigned long)(g_setsNum * g_scenariosNum), g_duration, (unsigned long)threads);
+
+    seconds = SWEEP_runAll(threads, &steals);
+
+    fprintf(stderr, "# %.2f s wall, %.0f runs/s, %llu steals\n", seconds, (g_setsNum * g_scenariosNum) / seconds,
+            (unsigned long long)steals);
+
+    if(isScaling == TRUE){
+
+        memcpy(reference, g_results, (size_t)g_setsNum * g_scenariosNum * sizeof(SWEEP_resultType));
+        baseSeconds = 0.0;
+
+        fprintf(stderr, "# scaling on %ld online cores\n", cores);
+        fprintf(stderr, "# threads    wall_s   speedup  efficiency    steals  identical\n");
+
+        n = 1;
+
+        while(n <= threads){
+
+            memset(g_results, 0, (size_t)g_setsNum * g_scenariosNum * sizeof(SWEEP_resultType));
+            seconds = SWEEP_runAll(n, &steals);
+
+            if(n == 1u){
+
+                baseSeconds = seconds;
+            }
+
+            fprintf(stderr, "# %7lu  %8.2f  %8.2f  %9.0f%%  %8llu  %9s\n", (unsigned long)n, seconds, baseSeconds / seconds,
+                    (100.0 * baseSeconds) / (seconds * n), (unsigned long long)steals,
+                    (memcmp(reference, g_results, (size_t)g_setsNum * g_scenariosNum * sizeof(SWEEP_resultType)) == 0)
+                    ? "yes" : "NO");
+
+            if(n == threads){
+
+                break;
+            }
+
+            /* 1, 2, 4 ... and the thread count itself */
+            n = ((n * 2u) > threads) ? threads : (n * 2u);
+        }
+    }
+
+    SWEEP_rank(ranks, overshootWeight, switchWeight);
+    SWEEP_printRanking(ranks);
+
+    free(ranks);
+    free(reference);
+    free(g_results);
+    free(g_scenarios);
+    free(g_sets);
+
+    return 0;
+}
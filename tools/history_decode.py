@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+##########################################################################################################
+#
+# Module: History decoder
+#
+# File Name: history_decode.py
+#
+# Description: Host decoder of the temperature history dump (Code/SeatHeater_sysCtl/APP/History.h), it decodes
+#              the delta compressed blocks of a "history dump" capture into one CSV row per sample, or into the
+#              same per minute summary as the "history summary" command
+#
+# Author: Mario kaldas
+#
+##########################################################################################################
+#
+# Usage:
+#
+#   python3 tools/history_decode.py dump.bin [-o samples.csv] [--summary]
+#
+# The capture is the raw bytes received on UART0 after the "history dump" command, ex: on Linux
+#
+#   stty -F /dev/ttyACM0 115200 raw -echo && cat /dev/ttyACM0 > dump.bin
+#
+# Everything before the "HISTORY" header line and the log lines between two blocks are skipped, the statistics go to the
+# standard error.
+
+import argparse
+import re
+import sys
+
+# Record kinds and layout, keep them in line with the NOTE of History.h and HISTORY_decode
+RECORD_RUN = 0x00
+RECORD_SMALL = 0x40
+RECORD_FULL = 0x80
+RECORD_KIND_MASK = 0xC0
+
+ZONES = 2
+DRIVER = 0
+PASSENGER = 1
+SEATS = ("driver", "passenger")
+MODES = ("OFF", "LOW", "MEDIUM", "HIGH", "SENSOR_FAILURE")
+
+# Bytes of one uncompressed sample (HISTORY_RAW_SAMPLE_SIZE)
+RAW_SAMPLE_SIZE = 10
+
+# First byte of every dumped block (HISTORY_DUMP_BLOCK_MARK), the log lines printed between two blocks are skipped
+BLOCK_MARK = 0xA5
+
+HEADER = re.compile(rb"HISTORY (\d+) (\d+) (\d+)\r\n")
+
+
+class CorruptBlock(Exception):
+    pass
+
+
+def unzigzag(value):
+    return -((value + 1) >> 1) if (value & 1) else (value >> 1)
+
+
+def get_varint(block, index):
+    value = 0
+    shift = 0
+    while index < len(block) and shift < 32:
+        byte = block[index]
+        index += 1
+        value |= (byte & 0x7F) << shift
+        if (byte & 0x80) == 0:
+            return value, index
+        shift += 7
+    raise CorruptBlock("varint past the end of the block")
+
+
+def decode_block(block, period_ticks):
+    """Yield (tick, temperatures, states) for every sample of the block, as HISTORY_decode."""
+    tick, index = get_varint(block, 0)
+    if index + 2 * ZONES > len(block):
+        raise CorruptBlock("keyframe past the end of the block")
+
+    temperatures = [0] * ZONES
+    states = [0] * ZONES
+    for zone in range(ZONES):
+        temperatures[zone] = block[index]
+        states[zone] = block[index + 1]
+        index += 2
+
+    tick &= 0xFFFFFFFF
+    yield tick, tuple(temperatures), tuple(states)
+
+    while index < len(block):
+        header = block[index]
+        index += 1
+        kind = header & RECORD_KIND_MASK
+
+        if kind == RECORD_RUN:
+            for _ in range((header & 0x3F) + 1):
+                tick = (tick + period_ticks) & 0xFFFFFFFF
+                yield tick, tuple(temperatures), tuple(states)
+            continue
+
+        if kind == RECORD_SMALL:
+            temperatures[DRIVER] = (temperatures[DRIVER] + unzigzag((header >> 3) & 0x07)) & 0xFF
+            temperatures[PASSENGER] = (temperatures[PASSENGER] + unzigzag(header & 0x07)) & 0xFF
+
+        elif kind == RECORD_FULL:
+            for zone in range(ZONES):
+                value, index = get_varint(block, index)
+                temperatures[zone] = (temperatures[zone] + unzigzag(value)) & 0xFF
+            for zone in range(ZONES):
+                if header & (1 << (ZONES - 1 - zone)):
+                    if index >= len(block):
+                        raise CorruptBlock("state past the end of the block")
+                    states[zone] = block[index]
+                    index += 1
+
+        else:
+            raise CorruptBlock("unknown record 0x%02X" % header)
+
+        tick = (tick + period_ticks) & 0xFFFFFFFF
+        yield tick, tuple(temperatures), tuple(states)
+
+
+def parse_dump(capture):
+    """Returns the period in ms, the tick rate, the list of blocks (empty for a block dropped during the dump)
+    and the number of text bytes skipped between the blocks."""
+    match = HEADER.search(capture)
+    if match is None:
+        raise SystemExit("no HISTORY header in the capture")
+
+    period_ms, tick_rate, blocks_num = (int(group) for group in match.groups())
+    index = match.end()
+    blocks = []
+    skipped = 0
+
+    for _ in range(blocks_num):
+        mark = capture.find(bytes([BLOCK_MARK]), index)
+        if mark < 0 or mark + 1 >= len(capture):
+            raise SystemExit("the capture ends after %d of %d blocks" % (len(blocks), blocks_num))
+        skipped += mark - index
+        length = capture[mark + 1]
+        blocks.append(capture[mark + 2:mark + 2 + length])
+        index = mark + 2 + length
+        if len(blocks[-1]) != length:
+            raise SystemExit("the capture ends inside block %d" % (len(blocks) - 1))
+
+    return period_ms, tick_rate, blocks, skipped
+
+
+def mean_tenths(total, samples):
+    """Mean in tenths of a degree rounded as HISTORY_printMinute."""
+    tenths = ((total * 20) // samples + 1) // 2
+    return "%d.%d" % (tenths // 10, tenths % 10)
+
+
+def write_summary(samples, tick_rate, out):
+    """Same CSV as the history summary command."""
+    minute_ticks = 60 * tick_rate
+    out.write("minute,driver_min,driver_max,driver_mean,passenger_min,passenger_max,passenger_mean,samples\r\n")
+
+    current = None
+    for tick, temperatures, _ in samples:
+        minute = tick // minute_ticks
+        if current is not None and minute != current[0]:
+            write_minute(current, out)
+            current = None
+        if current is None:
+            current = [minute, 0, list(temperatures), list(temperatures), [0] * ZONES]
+        current[1] += 1
+        for zone in range(ZONES):
+            current[2][zone] = min(current[2][zone], temperatures[zone])
+            current[3][zone] = max(current[3][zone], temperatures[zone])
+            current[4][zone] += temperatures[zone]
+
+    if current is not None:
+        write_minute(current, out)
+
+
+def write_minute(current, out):
+    minute, count, minimum, maximum, total = current
+    row = [str(minute)]
+    for zone in range(ZONES):
+        row += [str(minimum[zone]), str(maximum[zone]), mean_tenths(total[zone], count)]
+    row.append(str(count))
+    out.write(",".join(row) + "\r\n")
+
+
+def write_samples(samples, tick_rate, out):
+    columns = ["time_ms"]
+    for seat in SEATS:
+        columns += [seat + "_temperature", seat + "_desired_level", seat + "_mode"]
+    out.write(",".join(columns) + "\n")
+
+    for tick, temperatures, states in samples:
+        row = [str(tick * 1000 // tick_rate)]
+        for zone in range(ZONES):
+            mode = states[zone] & 0x0F
+            row += [str(temperatures[zone]), str(states[zone] >> 4), MODES[mode] if mode < len(MODES) else str(mode)]
+        out.write(",".join(row) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a temperature history dump of the seat heater into CSV")
+    parser.add_argument("capture", help="raw UART0 capture of history dump, - for the standard input")
+    parser.add_argument("-o", "--output", help="CSV file, the standard output by default")
+    parser.add_argument("--summary", action="store_true", help="print the per minute summary of history summary")
+    args = parser.parse_args()
+
+    capture = sys.stdin.buffer.read() if args.capture == "-" else open(args.capture, "rb").read()
+    period_ms, tick_rate, blocks, skipped = parse_dump(capture)
+    period_ticks = period_ms * tick_rate // 1000
+
+    samples = []
+    encoded_bytes = 0
+    dropped = 0
+    corrupt = 0
+
+    for block in blocks:
+        if not block:
+            dropped += 1
+            continue
+        encoded_bytes += len(block)
+        try:
+            for sample in decode_block(block, period_ticks):
+                samples.append(sample)
+        except CorruptBlock as error:
+            corrupt += 1
+            sys.stderr.write("corrupt block : %s, the rest of the block is skipped\n" % error)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+
+    if args.summary:
+        write_summary(samples, tick_rate, out)
+    else:
+        write_samples(samples, tick_rate, out)
+
+    if args.output:
+        out.close()
+
+    sys.stderr.write("blocks=%d dropped=%d corrupt=%d samples=%d time_s=%d bytes=%d raw_bytes=%d text_skipped=%d"
+                     % (len(blocks), dropped, corrupt, len(samples), len(samples) * period_ms // 1000,
+                        encoded_bytes, len(samples) * RAW_SAMPLE_SIZE, skipped))
+    if encoded_bytes:
+        # Truncated to tenths as the history command
+        ratio = len(samples) * RAW_SAMPLE_SIZE * 10 // encoded_bytes
+        sys.stderr.write(" ratio=%d.%d" % (ratio // 10, ratio % 10))
+    sys.stderr.write("\n")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,275 @@
+/**********************************************************************************************************
+ *
+ * Module: Status stress test
+ *
+ * File Name: status_stress.c
+ *
+ * Description: Host stress test of the status table (Code/SeatHeater_sysCtl/APP/Status.h), one writer thread per
+ *              seat publishes while reader threads check that every snapshot STATUS_read returns is whole
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+/*
+ * Usage (Linux, gcc or clang) :
+ *
+ *   cc -O2 -pthread -o status_stress tools/status_stress.c && ./status_stress [seconds] [readers]
+ *
+ * Status.c is built as it is against the few definitions of APP.h it uses. Every thread is pinned on the same CPU
+ * like the tasks of the single core target, so a reader is preempted in the middle of its copy by a publish and the
+ * other way around. A publish is written from a counter, so a snapshot mixing two publishes is detected.
+ *
+ * The test fails (exit code 1) if a snapshot is torn or a seat goes back in time for a reader.
+ */
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#define _GNU_SOURCE
+#include<pthread.h>
+#include<sched.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<time.h>
+#include<unistd.h>
+
+#include"../Code/SeatHeater_sysCtl/MCAL/std_types.h"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+/* Keep them in line with APP.h, HAL/Temperature_sensor.h and the FreeRTOS port, APP.h itself is skipped */
+#define APP_APP_H_
+
+#define TEMPERATURE_ZONES   2u
+
+typedef uint32 TickType_t;
+
+typedef enum{
+
+    HEATER_OFF,
+    HEATER_LOW,
+    HEATER_MEDIUM,
+    HEATER_HIGH,
+    TEMPERATURE_SENSOR_FAILURE
+
+}heatingMode_Type;
+
+typedef enum{
+
+    LEVEL0=HEATER_OFF,
+    LEVEL1=25,
+    LEVEL2=30,
+    LEVEL3=35
+
+}desiredTemp_Type;
+
+/* The publish is the only critical section, on the host it only has to exclude the other publishes */
+static pthread_mutex_t g_criticalMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define taskENTER_CRITICAL()    pthread_mutex_lock(&g_criticalMutex)
+#define taskEXIT_CRITICAL()     pthread_mutex_unlock(&g_criticalMutex)
+
+#include"../Code/SeatHeater_sysCtl/APP/Status.c"
+
+#define STRESS_DEFAULT_SECONDS  5u
+#define STRESS_DEFAULT_READERS  4u
+#define STRESS_MAX_READERS      32u
+
+/***************************************************************************
+ *                             Types declaration
+ *************************************************************************** */
+
+typedef struct{
+
+    pthread_t thread;
+    uint64 reads;
+    uint64 snapshots;
+    uint64 busy;                        /* Every retry interrupted by a publish */
+    uint64 torn;
+    uint64 backwards;
+
+}STRESS_readerType;
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static volatile boolean g_isRunning = TRUE;
+
+static uint64 g_publishes[TEMPERATURE_ZONES];
+
+static const desiredTemp_Type g_levels[] = {LEVEL0, LEVEL1, LEVEL2, LEVEL3};
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+/* Every field of the publish number n is derived from n, the tick is n itself */
+static void STRESS_fill(uint32 n, uint8 instance, STATUS_seatType* status){
+
+    status->currentTemperature = (uint8)(n + instance);
+    status->desiredLevel = (heatingMode_Type)(n % 4u);
+    status->desiredTemperature = g_levels[n % 4u];
+    status->mode = (heatingMode_Type)((n / 4u) % 5u);
+    status->tick = n;
+}
+
+static boolean STRESS_isWhole(uint8 instance, const STATUS_seatType* snapshot){
+
+    STATUS_seatType expected;
+
+    STRESS_fill(snapshot->tick, instance, &expected);
+
+    return (snapshot->currentTemperature == expected.currentTemperature) &&
+           (snapshot->desiredLevel == expected.desiredLevel) &&
+           (snapshot->desiredTemperature == expected.desiredTemperature) &&
+           (snapshot->mode == expected.mode);
+}
+
+static void STRESS_pin(void){
+
+    cpu_set_t cpus;
+
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+
+    if(sched_setaffinity(0, sizeof(cpus), &cpus) != 0){
+
+        perror("sched_setaffinity");
+    }
+}
+
+static void* STRESS_writer(void* argument){
+
+    uint8 instance = (uint8)(size_t)argument;
+    STATUS_seatType status;
+    uint32 n = 1;
+
+    STRESS_pin();
+
+    while(g_isRunning == TRUE){
+
+        STRESS_fill(n++, instance, &status);
+        STATUS_publish(instance, &status);
+    }
+
+    g_publishes[instance] = n - 1u;
+
+    return NULL;
+}
+
+static void* STRESS_reader(void* argument){
+
+    STRESS_readerType* reader = argument;
+    STATUS_seatType snapshot;
+    TickType_t lastTick[TEMPERATURE_ZONES] = {0};
+    uint8 instance = 0;
+
+    STRESS_pin();
+
+    while(g_isRunning == TRUE){
+
+        reader->reads++;
+
+        if(STATUS_read(instance, &snapshot) == TRUE){
+
+            reader->snapshots++;
+
+            if(STRESS_isWhole(instance, &snapshot) == FALSE){
+
+                reader->torn++;
+            }
+
+            if(snapshot.tick < lastTick[instance]){
+
+                reader->backwards++;
+            }
+
+            lastTick[instance] = snapshot.tick;
+        }
+        else if(STATUS_getPublishes(instance) != 0){
+
+            reader->busy++;
+        }
+
+        instance = (uint8)((instance + 1u) % TEMPERATURE_ZONES);
+    }
+
+    return NULL;
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    static STRESS_readerType readers[STRESS_MAX_READERS];
+    pthread_t writers[TEMPERATURE_ZONES];
+    STRESS_readerType total = {0};
+    struct timespec start;
+    struct timespec end;
+    double seconds;
+    uint32 duration = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 10) : STRESS_DEFAULT_SECONDS;
+    uint32 readersNum = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 10) : STRESS_DEFAULT_READERS;
+    uint32 i;
+
+    if((duration == 0) || (readersNum == 0) || (readersNum > STRESS_MAX_READERS)){
+
+        fprintf(stderr, "usage: %s [seconds] [readers 1-%lu]\n", argv[0], (unsigned long)STRESS_MAX_READERS);
+        return 2;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(i = 0; i < TEMPERATURE_ZONES; i++){
+
+        pthread_create(&writers[i], NULL, STRESS_writer, (void*)(size_t)i);
+    }
+
+    for(i = 0; i < readersNum; i++){
+
+        pthread_create(&readers[i].thread, NULL, STRESS_reader, &readers[i]);
+    }
+
+    sleep(duration);
+    g_isRunning = FALSE;
+
+    for(i = 0; i < TEMPERATURE_ZONES; i++){
+
+        pthread_join(writers[i], NULL);
+    }
+
+    for(i = 0; i < readersNum; i++){
+
+        pthread_join(readers[i].thread, NULL);
+
+        total.reads += readers[i].reads;
+        total.snapshots += readers[i].snapshots;
+        total.busy += readers[i].busy;
+        total.torn += readers[i].torn;
+        total.backwards += readers[i].backwards;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+
+    printf("seconds=%.1f readers=%lu publishes=%llu,%llu\n", seconds, (unsigned long)readersNum,
+           (unsigned long long)g_publishes[0], (unsigned long long)g_publishes[1]);
+    printf("reads=%llu snapshots=%llu busy=%llu torn=%llu backwards=%llu\n",
+           (unsigned long long)total.reads, (unsigned long long)total.snapshots, (unsigned long long)total.busy,
+           (unsigned long long)total.torn, (unsigned long long)total.backwards);
+
+    if((total.torn != 0) || (total.backwards != 0)){
+
+        printf("FAIL\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
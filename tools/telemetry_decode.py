@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+##########################################################################################################
+#
+# Module: Telemetry decoder
+#
+# File Name: telemetry_decode.py
+#
+# Description: Host decoder of the binary telemetry (Code/SeatHeater_sysCtl/APP/Telemetry.h), it unframes a raw
+#              UART0 capture (COBS between 0x00 delimiters), checks the CRC-16 of every snapshot, counts the
+#              sequence gaps, writes one CSV row per snapshot and prints the statistics of the capture
+#
+# Author: Mario kaldas
+#
+##########################################################################################################
+#
+# Usage:
+#
+#   python3 tools/telemetry_decode.py capture.bin [-o snapshots.csv] [--tick-rate 1000]
+#
+# The capture is the raw bytes received on UART0 after "telemetry on", ex: on Linux
+#
+#   stty -F /dev/ttyACM0 115200 raw -echo && cat /dev/ttyACM0 > capture.bin
+#
+# The console replies between the frames are chunks that fail the CRC, they are counted and skipped.
+# The CSV goes to the standard output without -o, the statistics always go to the standard error.
+
+import argparse
+import struct
+import sys
+
+# Layout of the snapshot payload, keep it in line with the NOTE of Telemetry.h
+RECORD_SNAPSHOT = 1
+PAYLOAD_SIZE = 23
+FRAME_SIZE = PAYLOAD_SIZE + 3
+PAYLOAD_FORMAT = "<BHIH4B4B4BH"
+
+SEATS = ("driver", "passenger")
+QUEUES = ("input_driver", "input_passenger", "mode_driver", "mode_passenger")
+MODES = ("OFF", "LOW", "MEDIUM", "HIGH", "SENSOR_FAILURE")
+
+FLAG_FAULTY = 1 << 0
+FLAG_FAULT_PENDING = 1 << 1
+FLAG_LAST_FAULT_SHIFT = 2
+FLAG_NO_STATUS = 1 << 7
+
+# Same texts as the text mode of the firmware, for the bandwidth comparison
+SEAT_NAMES = ("Driver", "Passenger")
+MODE_TEXTS = ("OFF", "on LOW intensity", "on MEDIUM intensity", "on HIGH intensity", "OFF (sensor failure)")
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE (polynomial 0x1021, initial 0xFFFF) as TELEMETRY_crc16."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(chunk):
+    """Decode one COBS chunk (without its 0x00 delimiter), returns None if it's not valid COBS."""
+    out = bytearray()
+    index = 0
+    while index < len(chunk):
+        code = chunk[index]
+        if code == 0 or index + code > len(chunk):
+            return None
+        out += chunk[index + 1:index + code]
+        index += code
+        if code != 0xFF and index < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+def text_length(snapshot):
+    """Length of the text lines carrying the same snapshot in the text mode (TELEMETRY_textLength)."""
+    length = 0
+    for zone, seat in enumerate(snapshot["seats"]):
+        name = SEAT_NAMES[zone]
+        length += len("Current temperature of %s seat is : %u degree celsius\r\n" % (name, seat["temperature"]))
+        if seat["desired"] == 0:
+            length += len("Desired temperature of %s seat heater is : OFF\r\n" % name)
+        else:
+            length += len("Desired temperature of %s seat heater is : %u degree celsius\r\n" % (name, seat["desired"]))
+        mode = seat["mode"] if seat["mode"] < len(MODE_TEXTS) else 0
+        length += len("Heater of the %s seat is %s\r\n" % (name, MODE_TEXTS[mode]))
+    length += len("CPU Load is %u%% \r\n" % (snapshot["cpu_permille"] // 10))
+    return length
+
+
+def parse_snapshot(payload):
+    """Returns the snapshot of a valid payload, or None."""
+    if len(payload) != PAYLOAD_SIZE or payload[0] != RECORD_SNAPSHOT:
+        return None
+    fields = struct.unpack(PAYLOAD_FORMAT, payload)
+    if crc16(payload[:-2]) != fields[-1]:
+        return None
+    _, sequence, tick, cpu = fields[:4]
+    seats = []
+    for zone in range(len(SEATS)):
+        temperature, desired, mode, flags = fields[4 + 4 * zone:8 + 4 * zone]
+        seats.append({"temperature": temperature, "desired": desired, "mode": mode, "flags": flags})
+    return {"sequence": sequence, "tick": tick, "cpu_permille": cpu, "seats": seats, "queues": fields[12:16]}
+
+
+def split_frames(capture):
+    """Yield every chunk between two 0x00 delimiters."""
+    for chunk in capture.split(b"\x00"):
+        if chunk:
+            yield chunk
+
+
+def decode(capture, out, tick_rate):
+    stats = {"chunks": 0, "frames": 0, "rejected": 0, "lost": 0, "text_bytes": 0}
+    seats = [{"min": None, "max": None, "sum": 0, "faulty": 0, "no_status": 0} for _ in SEATS]
+    cpu_sum = 0
+    cpu_max = 0
+    queue_max = [0] * len(QUEUES)
+    first_tick = None
+    last_tick = None
+    previous = None
+
+    columns = ["sequence", "time_ms", "cpu_load_%"]
+    for seat in SEATS:
+        columns += [seat + "_temperature", seat + "_desired", seat + "_mode", seat + "_faulty",
+                    seat + "_fault_pending", seat + "_last_fault", seat + "_no_status"]
+    columns += QUEUES
+    out.write(",".join(columns) + "\n")
+
+    for chunk in split_frames(capture):
+        stats["chunks"] += 1
+        payload = cobs_decode(chunk)
+        snapshot = parse_snapshot(payload) if payload is not None else None
+
+        if snapshot is None:
+            stats["rejected"] += 1
+            continue
+
+        stats["frames"] += 1
+        stats["text_bytes"] += text_length(snapshot)
+
+        if previous is not None:
+            stats["lost"] += (snapshot["sequence"] - previous - 1) & 0xFFFF
+        previous = snapshot["sequence"]
+
+        if first_tick is None:
+            first_tick = snapshot["tick"]
+        last_tick = snapshot["tick"]
+
+        cpu_sum += snapshot["cpu_permille"]
+        cpu_max = max(cpu_max, snapshot["cpu_permille"])
+
+        row = [str(snapshot["sequence"]), str(snapshot["tick"] * 1000 // tick_rate),
+               "%.1f" % (snapshot["cpu_permille"] / 10.0)]
+
+        for zone, seat in enumerate(snapshot["seats"]):
+            flags = seat["flags"]
+            mode = MODES[seat["mode"]] if seat["mode"] < len(MODES) else str(seat["mode"])
+            row += [str(seat["temperature"]), str(seat["desired"]), mode,
+                    str(int(bool(flags & FLAG_FAULTY))), str(int(bool(flags & FLAG_FAULT_PENDING))),
+                    str((flags >> FLAG_LAST_FAULT_SHIFT) & 0x07), str(int(bool(flags & FLAG_NO_STATUS)))]
+
+            if flags & FLAG_NO_STATUS:
+                seats[zone]["no_status"] += 1
+                continue
+            if flags & FLAG_FAULTY:
+                seats[zone]["faulty"] += 1
+            temperature = seat["temperature"]
+            seats[zone]["min"] = temperature if seats[zone]["min"] is None else min(seats[zone]["min"], temperature)
+            seats[zone]["max"] = temperature if seats[zone]["max"] is None else max(seats[zone]["max"], temperature)
+            seats[zone]["sum"] += temperature
+
+        for index, depth in enumerate(snapshot["queues"]):
+            queue_max[index] = max(queue_max[index], depth)
+        row += [str(depth) for depth in snapshot["queues"]]
+
+        out.write(",".join(row) + "\n")
+
+    return stats, seats, cpu_sum, cpu_max, queue_max, first_tick, last_tick
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a binary telemetry capture of the seat heater into CSV")
+    parser.add_argument("capture", help="raw UART0 capture file, - for the standard input")
+    parser.add_argument("-o", "--output", help="CSV file, the standard output by default")
+    parser.add_argument("--tick-rate", type=int, default=1000, help="configTICK_RATE_HZ of the firmware (1000)")
+    args = parser.parse_args()
+
+    capture = sys.stdin.buffer.read() if args.capture == "-" else open(args.capture, "rb").read()
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+
+    stats, seats, cpu_sum, cpu_max, queue_max, first_tick, last_tick = decode(capture, out, args.tick_rate)
+
+    if args.output:
+        out.close()
+
+    err = sys.stderr
+    frames = stats["frames"]
+    err.write("capture bytes=%d chunks=%d frames=%d rejected=%d lost=%d\n"
+              % (len(capture), stats["chunks"], frames, stats["rejected"], stats["lost"]))
+
+    if frames == 0:
+        return 1
+
+    duration_ms = (last_tick - first_tick) * 1000 // args.tick_rate
+    err.write("time_ms=%d cpu_load_mean=%.1f%% cpu_load_max=%.1f%%\n"
+              % (duration_ms, cpu_sum / frames / 10.0, cpu_max / 10.0))
+
+    for zone, seat in enumerate(seats):
+        decided = frames - seat["no_status"]
+        if decided == 0:
+            err.write("%s no decision\n" % SEATS[zone])
+            continue
+        err.write("%s temperature min=%d max=%d mean=%.1f faulty_frames=%d\n"
+                  % (SEATS[zone], seat["min"], seat["max"], seat["sum"] / decided, seat["faulty"]))
+
+    err.write("queues peak " + " ".join("%s=%d" % (name, depth) for name, depth in zip(QUEUES, queue_max)) + "\n")
+
+    binary_bytes = frames * FRAME_SIZE
+    err.write("bandwidth frame_bytes=%d text_bytes=%d reduction=%.1f\n"
+              % (binary_bytes, stats["text_bytes"], stats["text_bytes"] / binary_bytes))
+
+    if duration_ms > 0:
+        err.write("bandwidth bytes_per_s=%.0f text_bytes_per_s=%.0f\n"
+                  % (binary_bytes * 1000.0 / duration_ms, stats["text_bytes"] * 1000.0 / duration_ms))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
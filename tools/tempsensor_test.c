@@ -0,0 +1,411 @@
+/**********************************************************************************************************
+ *
+ * Module: Temperature sensor fault detection test
+ *
+ * File Name: tempsensor_test.c
+ *
+ * Description: Host test of the sensor fault detection (Code/SeatHeater_sysCtl/HAL/Temperature_sensor.h), it replays
+ *              rail, range, rate, stuck and noise traces through TEMPSENSOR_checkSample and checks the debouncing,
+ *              the fault priority, the fault counters and the stuck time
+ *
+ * Author: Mario kaldas
+ *
+ **********************************************************************************************************/
+
+/*
+ * Usage (Linux, gcc or clang) :
+ *
+ *   cc -O2 -ICode/SeatHeater_sysCtl -o tempsensor_test tools/tempsensor_test.c && ./tempsensor_test
+ *
+ * Temperature_sensor.c is built as it is with the default fault configuration (3 samples to confirm a fault, 5 to
+ * recover, 15 minutes of the same reading for a stuck sensor) and the default calibration (0 to 45 degrees on the
+ * whole ADC range), the hardware functions it calls are stubs that are never called. Every trace starts from a reset
+ * zone state. Every failed check is printed with its line, the test fails (exit code 1) if any check failed.
+ */
+
+/****************************************************************************
+ *                                  Includes
+ * ************************************************************************/
+
+#include<stdio.h>
+#include<string.h>
+
+#include"HAL/Temperature_sensor.c"
+
+/***************************************************************************
+ *                                Definitions
+ *************************************************************************** */
+
+#define TEST_SAMPLE_PERIOD_MS   TEMPERATURE_SAMPLE_PERIOD_MS
+
+/* Readings of the default calibration (about 91 ADC counts per degree) */
+#define TEST_GOOD_READING       1820u   /* 20 degrees */
+#define TEST_HIGH_READING       3822u   /* 42 degrees, above the valid range */
+#define TEST_LOW_READING        273u    /* 3 degrees, below the valid range */
+#define TEST_JUMP_READING       2400u   /* 26 degrees, 580 counts away from the good reading */
+#define TEST_RAIL_READING       20u     /* Highest low rail reading */
+#define TEST_EDGE_READING       470u    /* 5 degrees, in range and within the rate limit of the rail reading */
+
+#define TEST_CHECK(condition)   TEST_check((boolean)(condition), #condition, __LINE__)
+
+/****************************************************************************
+ *                              Global variables
+ * ************************************************************************/
+
+static uint32 g_checks;
+static uint32 g_failures;
+
+/****************************************************************************
+ *                        Hardware stubs (never called)
+ * ************************************************************************/
+
+ADC_configType configs;
+volatile uint16 g_channelReading;
+
+void ADC_init(const ADC_configType* config){}
+uint16 ADC_readChannel(uint8 channel){ return 0; }
+void ADC_comparatorInit(const uint8* channels, uint8 channelsNum, uint8 priority){}
+void ADC_comparatorSetWindow(uint8 window, uint16 low, uint16 high){}
+void GPTM_Timer0ADCTriggerInit(uint32 periodMs){}
+
+/****************************************************************************
+ *                         Private functions definition
+ * ************************************************************************/
+
+static void TEST_check(boolean condition, const char* text, uint32 line){
+
+    g_checks++;
+
+    if(condition == FALSE){
+
+        g_failures++;
+        printf("tools/tempsensor_test.c:%lu: check failed: %s\n", (unsigned long)line, text);
+    }
+}
+
+static void TEST_reset(void){
+
+    memset((void*)g_zones, 0, sizeof(g_zones));
+}
+
+/* Replays the same reading count times, returns the number of state changes */
+static uint32 TEST_replay(uint8 zone, uint16 reading, uint32 count, uint32 elapsedMs){
+
+    uint32 changes = 0;
+
+    while(count-- > 0){
+
+        changes += TEMPSENSOR_checkSample(zone, reading, elapsedMs);
+    }
+
+    return changes;
+}
+
+/* Fault of one sample after the previous reading, on a scratch state so the zones aren't touched */
+static TEMPSENSOR_faultType TEST_classify(uint16 previous, uint16 reading, uint32 sameReadingMs, uint32 elapsedMs){
+
+    volatile TEMPSENSOR_zoneStateType zone;
+
+    memset((void*)&zone, 0, sizeof(zone));
+    zone.hasPrevious = TRUE;
+    zone.previousReading = previous;
+    zone.sameReadingMs = sameReadingMs;
+
+    return TEMPSENSOR_classifySample(0, &zone, reading, elapsedMs);
+}
+
+/* A fault is only confirmed by faultConfirmSamples consecutive faulty samples and only recovered by
+ * recoveryConfirmSamples consecutive good samples, anything else restarts the count
+ */
+static void TEST_rail(void){
+
+    TEST_reset();
+
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 10, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+
+    /* Two rail readings then a good one : not confirmed and the count restarts */
+    TEST_CHECK(TEST_replay(0, TEST_RAIL_READING, 2, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == TRUE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_EDGE_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+
+    /* Two more rail readings aren't enough after the restart, the third confirms */
+    TEST_CHECK(TEST_replay(0, ADC_MAX_VALUE, 2, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, ADC_MAX_VALUE - TEMPSENSOR_faultConfigs.railMargin, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == TRUE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RAIL);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RAIL) == 1);
+
+    /* Faulty samples while faulty change nothing */
+    TEST_CHECK(TEST_replay(0, ADC_MIN_VALUE, 10, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RAIL) == 1);
+
+    /* The first good reading after the rail is a rate fault, then four good readings and a faulty one restart the recovery */
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 4, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == TRUE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_LOW_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == TRUE);
+
+    /* Back to good (rate fault first), four good readings don't recover, the fifth does */
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 4, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == TRUE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+
+    /* The last fault is kept after the recovery and the counters only count confirmed faults */
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RAIL);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RAIL) == 1);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RATE) == 0);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RANGE) == 0);
+
+    /* The other zone never saw a sample */
+    TEST_CHECK(TEMPSENSOR_isFaulty(1) == FALSE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(1, TEMPSENSOR_FAULT_RAIL) == 0);
+}
+
+static void TEST_range(void){
+
+    uint16 reading;
+
+    TEST_reset();
+
+    /* Warm up slowly (no rate fault) above the valid range, on zone 1 */
+    for(reading = TEST_GOOD_READING; reading < TEST_HIGH_READING; reading += 200u){
+
+        TEMPSENSOR_checkSample(1, reading, TEST_SAMPLE_PERIOD_MS);
+    }
+
+    TEST_CHECK(TEMPSENSOR_isFaulty(1) == FALSE);
+    TEST_CHECK(TEST_replay(1, TEST_HIGH_READING, 3, TEST_SAMPLE_PERIOD_MS) == 1);
+    TEST_CHECK(TEMPSENSOR_isFaulty(1) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(1) == TEMPSENSOR_FAULT_RANGE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(1, TEMPSENSOR_FAULT_RANGE) == 1);
+
+    /* Cool down slowly below the valid range, the recovery needs five good samples in a row */
+    for(reading = TEST_HIGH_READING; reading > TEST_GOOD_READING; reading -= 200u){
+
+        TEMPSENSOR_checkSample(1, reading, TEST_SAMPLE_PERIOD_MS);
+    }
+
+    TEST_CHECK(TEMPSENSOR_isFaulty(1) == FALSE);
+
+    for(reading = TEST_GOOD_READING; reading > TEST_LOW_READING; reading -= 200u){
+
+        TEMPSENSOR_checkSample(1, reading, TEST_SAMPLE_PERIOD_MS);
+    }
+
+    TEST_CHECK(TEST_replay(1, TEST_LOW_READING, 3, TEST_SAMPLE_PERIOD_MS) == 1);
+    TEST_CHECK(TEMPSENSOR_getLastFault(1) == TEMPSENSOR_FAULT_RANGE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(1, TEMPSENSOR_FAULT_RANGE) == 2);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RANGE) == 0);
+}
+
+static void TEST_rate(void){
+
+    uint32 i;
+
+    TEST_reset();
+
+    /* A jump right at the limit is fine, one count more is a rate fault */
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING + TEMPSENSOR_faultConfigs.maxChangePerSample, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING - 1u, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == TRUE);
+
+    /* Every sample jumps by 580 counts, the third consecutive jump confirms */
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_JUMP_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RATE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RATE) == 1);
+
+    /* Jumping goes on : still faulty, nothing counted */
+    for(i = 0; i < 20u; i++){
+
+        TEST_CHECK(TEMPSENSOR_checkSample(0, ((i % 2u) == 0) ? TEST_JUMP_READING : TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    }
+
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RATE) == 1);
+
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 5, TEST_SAMPLE_PERIOD_MS) == 1);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == FALSE);
+}
+
+/* The stuck check is a time : it's detected after the same time whatever the sample period is */
+static void TEST_stuck(void){
+
+    const uint32 stuckTimeMs = TEMPSENSOR_faultConfigs.stuckTimeMs;
+    const uint32 periods[] = {TEST_SAMPLE_PERIOD_MS, 1000u, 60000u};
+    uint32 samples;
+    uint32 i;
+
+    for(i = 0; i < (sizeof(periods) / sizeof(periods[0])); i++){
+
+        TEST_reset();
+
+        /* The first sample has no previous reading, then every sample adds its period till the stuck time */
+        samples = 1u + (stuckTimeMs / periods[i]);
+
+        TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, samples - 1u, periods[i]) == 0);
+        TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+        TEST_CHECK(g_zones[0].sameReadingMs == (stuckTimeMs - periods[i]));
+
+        TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 2, periods[i]) == 0);
+        TEST_CHECK(TEMPSENSOR_isFaultPending(0) == TRUE);
+        TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, periods[i]) == TRUE);
+        TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_STUCK);
+        TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_STUCK) == 1);
+
+        /* One count of change restarts the time */
+        TEST_CHECK(TEST_replay(0, TEST_GOOD_READING + 1u, 4, periods[i]) == 0);
+        TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING + 1u, periods[i]) == TRUE);
+        TEST_CHECK(TEMPSENSOR_isFaulty(0) == FALSE);
+        TEST_CHECK(g_zones[0].sameReadingMs == (5u * periods[i]) - periods[i]);
+    }
+
+    /* A stuck time of 0 disables the check */
+    TEST_reset();
+    TEMPSENSOR_faultConfigs.stuckTimeMs = 0;
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 100, 60000u) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+    TEMPSENSOR_faultConfigs.stuckTimeMs = stuckTimeMs;
+}
+
+/* The time of the same reading saturates instead of wrapping around to a good sensor */
+static void TEST_saturation(void){
+
+    TEST_reset();
+
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, 0);
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, 0xFFFFFFF0u);
+    TEST_CHECK(g_zones[0].sameReadingMs == 0xFFFFFFF0u);
+
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, 0x10u);
+    TEST_CHECK(g_zones[0].sameReadingMs == 0xFFFFFFFFu);
+
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, 0xFFFFFFFFu);
+    TEST_CHECK(g_zones[0].sameReadingMs == 0xFFFFFFFFu);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_STUCK);
+
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, 1u);
+    TEST_CHECK(g_zones[0].sameReadingMs == 0xFFFFFFFFu);
+    TEST_CHECK(TEMPSENSOR_isFaulty(0) == TRUE);
+}
+
+/* Noise within the rate limit is never a fault, a single spike (two jumps) isn't confirmed, a burst is */
+static void TEST_noise(void){
+
+    uint32 seed = 1;
+    uint32 i;
+    sint32 noise;
+
+    TEST_reset();
+
+    for(i = 0; i < 10000u; i++){
+
+        seed = ((seed * 1664525ul) + 1013904223ul) & 0xFFFFFFFFul;
+        noise = (sint32)((seed >> 16) % 401u) - 200;
+        TEMPSENSOR_checkSample(0, (uint16)((sint32)TEST_GOOD_READING + noise), TEST_SAMPLE_PERIOD_MS);
+        TEST_CHECK(TEMPSENSOR_isFaulty(0) == FALSE);
+    }
+
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 1, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_JUMP_READING + 100u, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEST_replay(0, TEST_GOOD_READING, 1, TEST_SAMPLE_PERIOD_MS) == 0);
+    TEST_CHECK(TEMPSENSOR_isFaultPending(0) == FALSE);
+
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_JUMP_READING + 100u, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS) == FALSE);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_JUMP_READING + 100u, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RATE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RATE) == 1);
+}
+
+/* One sample with several faults is the first of rail, range, rate, stuck, the confirmed fault is the one of the
+ * confirming sample
+ */
+static void TEST_priority(void){
+
+    const uint32 stuckTimeMs = TEMPSENSOR_faultConfigs.stuckTimeMs;
+
+    /* Rail, out of range and jump */
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, ADC_MIN_VALUE, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RAIL);
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, ADC_MAX_VALUE, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RAIL);
+
+    /* Rail and stuck */
+    TEST_CHECK(TEST_classify(ADC_MAX_VALUE, ADC_MAX_VALUE, stuckTimeMs, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RAIL);
+
+    /* Out of range and jump */
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, TEST_HIGH_READING, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RANGE);
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, TEST_LOW_READING, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RANGE);
+
+    /* Out of range and stuck */
+    TEST_CHECK(TEST_classify(TEST_HIGH_READING, TEST_HIGH_READING, stuckTimeMs, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RANGE);
+
+    /* Jump alone and stuck alone */
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, TEST_JUMP_READING, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_RATE);
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, TEST_GOOD_READING, stuckTimeMs - TEST_SAMPLE_PERIOD_MS, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_STUCK);
+    TEST_CHECK(TEST_classify(TEST_GOOD_READING, TEST_GOOD_READING, 0, TEST_SAMPLE_PERIOD_MS) == TEMPSENSOR_FAULT_NONE);
+
+    /* Range, rate then range : the confirming sample is out of range */
+    TEST_reset();
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS);
+    TEMPSENSOR_checkSample(0, TEST_HIGH_READING, TEST_SAMPLE_PERIOD_MS);
+    TEMPSENSOR_checkSample(0, TEST_GOOD_READING, TEST_SAMPLE_PERIOD_MS);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, TEST_HIGH_READING, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RANGE);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RANGE) == 1);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RATE) == 0);
+
+    /* Range, range then rail : the confirming sample is a rail reading */
+    TEST_reset();
+    TEMPSENSOR_checkSample(0, TEST_HIGH_READING, TEST_SAMPLE_PERIOD_MS);
+    TEMPSENSOR_checkSample(0, TEST_HIGH_READING, TEST_SAMPLE_PERIOD_MS);
+    TEST_CHECK(TEMPSENSOR_checkSample(0, ADC_MAX_VALUE, TEST_SAMPLE_PERIOD_MS) == TRUE);
+    TEST_CHECK(TEMPSENSOR_getLastFault(0) == TEMPSENSOR_FAULT_RAIL);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RAIL) == 1);
+    TEST_CHECK(TEMPSENSOR_getFaultCounter(0, TEMPSENSOR_FAULT_RANGE) == 0);
+}
+
+/****************************************************************************
+ *                             Functions definition
+ * ************************************************************************/
+
+int main(void){
+
+    /* The traces are written for the default configuration */
+    if((TEMPSENSOR_faultConfigs.faultConfirmSamples != 3u) || (TEMPSENSOR_faultConfigs.recoveryConfirmSamples != 5u) ||
+       (TEMPSENSOR_faultConfigs.maxChangePerSample != 455u) || (TEMPSENSOR_faultConfigs.stuckTimeMs != 900000u)){
+
+        printf("the default fault configuration changed, update the traces\nFAIL\n");
+        return 1;
+    }
+
+    TEST_rail();
+    TEST_range();
+    TEST_rate();
+    TEST_stuck();
+    TEST_saturation();
+    TEST_noise();
+    TEST_priority();
+
+    printf("checks=%lu failures=%lu\n", (unsigned long)g_checks, (unsigned long)g_failures);
+
+    if(g_failures != 0){
+
+        printf("FAIL\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}